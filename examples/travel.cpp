@@ -14,10 +14,15 @@ using namespace plnnr;
 #pragma warning(disable: 4189) // local variable is initialized but not referenced
 #endif
 
-static bool root_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
-static bool travel_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
-static bool travel_case_1(Planning_State*, Expansion_Frame*, Fact_Database*);
-static bool travel_by_plane_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
+static bool root_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool travel_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool travel_case_1(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool travel_by_plane_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p1_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p2_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p3_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
 
 static Compound_Task_Expand* s_task_expands[] = {
   root_case_0,
@@ -91,6 +96,36 @@ static uint32_t s_size_hints[] = {
   0,
 };
 
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+  0, 
+  1, 
+  1, 
+  1, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  0, 
+  0, 
+  1, 
+  2, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 2, {0, 1, }, Fact_Index_Hash }, // short_distance
+  { 2, {0, 1, }, Fact_Index_Hash }, // long_distance
+  { 1, {0, }, Fact_Index_Hash }, // airport
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+  false, 
+  false, 
+  false, 
+};
+
 static uint32_t s_num_case_handles[] = {
   2, 
   1, 
@@ -98,6 +133,40 @@ static uint32_t s_num_case_handles[] = {
   2, 
 };
 
+static uint32_t s_frame_costs[5];
+
+static bool s_collects_bindings[] = {
+  false, 
+  false, 
+  false, 
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0, 
+  0, 
+  0, 
+  0
+};
+
+static uint32_t s_collect_facts[] = {
+  0
+};
+
+static bool s_parallel[] = {
+  false, 
+  false, 
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+  p1_next,
+  p2_next,
+  p3_next,
+};
+
 static uint32_t s_fact_name_hashes[] = {
   1878359220, 
   1582309657, 
@@ -123,8 +192,8 @@ static uint32_t s_symbol_hashes[] = {
 };
 
 static Domain_Info s_domain_info = {
-  { 5, 2, 3, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands },
-  { 5, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names },
+  { 5, 2, 3, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 5, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
   { 0, 0, s_symbol_hashes, s_symbol_values }
 };
 
@@ -137,41 +206,102 @@ void travel_init_domain_info()
   for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
     compute_offsets_and_size(&s_bindings[i]);
   }
+
+  compute_frame_costs(&s_domain_info);
 }
 
 const Domain_Info* travel_get_domain_info() { return &s_domain_info; }
 
+namespace {
+
 struct S_1 {
   Id32 _0;
   Id32 _1;
 };
 
-static bool p0_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
   S_1* binds = (S_1*)(frame->bindings);
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
-  for (handles[0] = first(db, tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next(db, handles[0])) { // start
-    binds->_0 = Id32(as_Id32(db, handles[0], 0));
-    for (handles[1] = first(db, tbl(state, 1)); is_valid(db, handles[1]); handles[1] = next(db, handles[1])) { // finish
-      binds->_1 = Id32(as_Id32(db, handles[1], 0));
-      plnnr_coroutine_yield(frame, precond_label, 1);
+  for (handles[0] = first(db, Binding::tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next_table(db, handles[0])) { // start
+    const Fact_Table* table_0;
+    const uint8_t* removed_0;
+    uint32_t rows_0;
+    uint32_t row_0;
+    const Id32* c0_0;
+    table_0 = get_table(db, handles[0]);
+    removed_0 = get_removed(table_0);
+    rows_0 = table_0->num_entries;
+    row_0 = handles[0].entry;
+    c0_0 = get_column<Id32>(table_0, 0);
+
+    for (; row_0 < rows_0; ++row_0) {
+      if (removed_0 && removed_0[row_0]) {
+        continue;
+      }
+
+      binds->_0 = Id32(load_row(c0_0, row_0));
+      for (handles[1] = first(db, Binding::tbl(state, 1)); is_valid(db, handles[1]); handles[1] = next_table(db, handles[1])) { // finish
+        const Fact_Table* table_1;
+        const uint8_t* removed_1;
+        uint32_t rows_1;
+        uint32_t row_1;
+        const Id32* c1_0;
+        table_1 = get_table(db, handles[1]);
+        removed_1 = get_removed(table_1);
+        rows_1 = table_1->num_entries;
+        row_1 = handles[1].entry;
+        c1_0 = get_column<Id32>(table_1, 0);
+
+        for (; row_1 < rows_1; ++row_1) {
+          if (removed_1 && removed_1[row_1]) {
+            continue;
+          }
+
+          binds->_1 = Id32(load_row(c1_0, row_1));
+          handles[0].entry = row_0;
+          handles[1].entry = row_1;
+          plnnr_coroutine_yield(frame, precond_label, 1);
+          table_0 = get_table(db, handles[0]);
+          removed_0 = get_removed(table_0);
+          rows_0 = table_0->num_entries;
+          row_0 = handles[0].entry;
+          c0_0 = get_column<Id32>(table_0, 0);
+          table_1 = get_table(db, handles[1]);
+          removed_1 = get_removed(table_1);
+          rows_1 = table_1->num_entries;
+          row_1 = handles[1].entry;
+          c1_0 = get_column<Id32>(table_1, 0);
+        }
+      }
     }
   }
 
   plnnr_coroutine_end();
 }
 
-static bool p1_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p1_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
   const S_1* args = (const S_1*)(frame->arguments);
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
-  for (handles[0] = first(db, tbl(state, 2)); is_valid(db, handles[0]); handles[0] = next(db, handles[0])) { // short_distance
+  for (handles[0] = first(db, Binding::tbl(state, 2), 0, hash_Id32(hash_Id32(0, Id32(args->_0)), Id32(args->_1))); is_valid(db, handles[0]); handles[0] = next(db, handles[0], 0)) { // short_distance
     if (args->_0 != Id32(as_Id32(db, handles[0], 0))) {
       continue;
     }
@@ -181,19 +311,27 @@ static bool p1_next(Planning_State* state, Expansion_Frame* frame, Fact_Database
     }
 
     plnnr_coroutine_yield(frame, precond_label, 1);
+    break;
   }
 
   plnnr_coroutine_end();
 }
 
-static bool p2_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p1_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p1_body<Identity_Binding>(state, frame, db) : p1_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p2_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
   const S_1* args = (const S_1*)(frame->arguments);
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
-  for (handles[0] = first(db, tbl(state, 3)); is_valid(db, handles[0]); handles[0] = next(db, handles[0])) { // long_distance
+  for (handles[0] = first(db, Binding::tbl(state, 3), 0, hash_Id32(hash_Id32(0, Id32(args->_0)), Id32(args->_1))); is_valid(db, handles[0]); handles[0] = next(db, handles[0], 0)) { // long_distance
     if (args->_0 != Id32(as_Id32(db, handles[0], 0))) {
       continue;
     }
@@ -203,26 +341,34 @@ static bool p2_next(Planning_State* state, Expansion_Frame* frame, Fact_Database
     }
 
     plnnr_coroutine_yield(frame, precond_label, 1);
+    break;
   }
 
   plnnr_coroutine_end();
 }
 
-static bool p3_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p2_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p2_body<Identity_Binding>(state, frame, db) : p2_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p3_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
   const S_1* args = (const S_1*)(frame->arguments);
   S_1* binds = (S_1*)(frame->bindings);
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
-  for (handles[0] = first(db, tbl(state, 4)); is_valid(db, handles[0]); handles[0] = next(db, handles[0])) { // airport
+  for (handles[0] = first(db, Binding::tbl(state, 4), 0, hash_Id32(0, Id32(args->_0))); is_valid(db, handles[0]); handles[0] = next(db, handles[0], 0)) { // airport
     if (args->_0 != Id32(as_Id32(db, handles[0], 0))) {
       continue;
     }
 
     binds->_0 = Id32(as_Id32(db, handles[0], 1));
-    for (handles[1] = first(db, tbl(state, 4)); is_valid(db, handles[1]); handles[1] = next(db, handles[1])) { // airport
+    for (handles[1] = first(db, Binding::tbl(state, 4), 0, hash_Id32(0, Id32(args->_1))); is_valid(db, handles[1]); handles[1] = next(db, handles[1], 0)) { // airport
       if (args->_1 != Id32(as_Id32(db, handles[1], 0))) {
         continue;
       }
@@ -235,14 +381,19 @@ static bool p3_next(Planning_State* state, Expansion_Frame* frame, Fact_Database
   plnnr_coroutine_end();
 }
 
-static bool root_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p3_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p3_body<Identity_Binding>(state, frame, db) : p3_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool root_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
-  const S_1* binds = (const S_1*)(frame->bindings);
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
 
   plnnr_coroutine_begin(frame, expand_label);
 
   while (p0_next(state, frame, db)) {
-    binds = binds + frame->binding_index;
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
     begin_compound(state, &s_domain_info, 3); // travel
     set_compound_arg(state, &s_task_parameters[3], 0, Id32(binds->_0));
     set_compound_arg(state, &s_task_parameters[3], 1, Id32(binds->_1));
@@ -254,13 +405,14 @@ static bool root_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Data
   plnnr_coroutine_end();
 }
 
-static bool travel_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool travel_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   const S_1* args = (const S_1*)(frame->arguments);
 
   plnnr_coroutine_begin(frame, expand_label);
 
   while (p1_next(state, frame, db)) {
+    args = (const S_1*)(frame->arguments);
     begin_task(state, &s_domain_info, 0); // taxi!
     set_task_arg(state, &s_task_parameters[0], 0, Id32(args->_0));
     set_task_arg(state, &s_task_parameters[0], 1, Id32(args->_1));
@@ -274,13 +426,14 @@ static bool travel_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Da
   plnnr_coroutine_end();
 }
 
-static bool travel_case_1(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool travel_case_1(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   const S_1* args = (const S_1*)(frame->arguments);
 
   plnnr_coroutine_begin(frame, expand_label);
 
   while (p2_next(state, frame, db)) {
+    args = (const S_1*)(frame->arguments);
     begin_compound(state, &s_domain_info, 4); // travel_by_plane
     set_compound_arg(state, &s_task_parameters[4], 0, Id32(args->_0));
     set_compound_arg(state, &s_task_parameters[4], 1, Id32(args->_1));
@@ -292,15 +445,16 @@ static bool travel_case_1(Planning_State* state, Expansion_Frame* frame, Fact_Da
   plnnr_coroutine_end();
 }
 
-static bool travel_by_plane_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool travel_by_plane_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   const S_1* args = (const S_1*)(frame->arguments);
-  const S_1* binds = (const S_1*)(frame->bindings);
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
 
   plnnr_coroutine_begin(frame, expand_label);
 
   while (p3_next(state, frame, db)) {
-    binds = binds + frame->binding_index;
+    args = (const S_1*)(frame->arguments);
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
     begin_compound(state, &s_domain_info, 3); // travel
     set_compound_arg(state, &s_task_parameters[3], 0, Id32(args->_0));
     set_compound_arg(state, &s_task_parameters[3], 1, Id32(binds->_0));
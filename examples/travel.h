@@ -9,6 +9,17 @@
 #define PLNNR_DOMAIN_API
 #endif
 
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum travel_Fact_Id
+{
+  travel_fact_start = 0,
+  travel_fact_finish = 1,
+  travel_fact_short_distance = 2,
+  travel_fact_long_distance = 3,
+  travel_fact_airport = 4,
+  travel_num_facts = 5
+};
+
 extern "C" PLNNR_DOMAIN_API void travel_init_domain_info();
 extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* travel_get_domain_info();
 
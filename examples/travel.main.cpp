@@ -59,11 +59,12 @@ int main()
     plnnr::Fact_Database db;
     plnnr::init(&db, &default_mem, &domain->database_req);
 
-    plnnr::Fact_Table* start            = plnnr::find_table(&db, "start");
-    plnnr::Fact_Table* finish           = plnnr::find_table(&db, "finish");
-    plnnr::Fact_Table* short_distance   = plnnr::find_table(&db, "short_distance");
-    plnnr::Fact_Table* long_distance    = plnnr::find_table(&db, "long_distance");
-    plnnr::Fact_Table* airport          = plnnr::find_table(&db, "airport");
+    // generated ids are valid for the database created from `database_req`, other databases look tables up by name with `find_table`.
+    plnnr::Fact_Table* start            = db.tables + travel_fact_start;
+    plnnr::Fact_Table* finish           = db.tables + travel_fact_finish;
+    plnnr::Fact_Table* short_distance   = db.tables + travel_fact_short_distance;
+    plnnr::Fact_Table* long_distance    = db.tables + travel_fact_long_distance;
+    plnnr::Fact_Table* airport          = db.tables + travel_fact_airport;
 
     plnnr::add_entry(start, SPB);
     plnnr::add_entry(finish, MSC);
@@ -85,13 +86,13 @@ int main()
     plnnr::add_entry(airport, SPB, LED);
     plnnr::add_entry(airport, MSC, SVO);
 
-    // create planning state.
+    // create planning state, sized for the expansion depth & plan length budgets.
     plnnr::Planning_State_Config config;
-    config.max_depth = 5;
-    config.max_plan_length = 3;
-    config.expansion_data_size = 1024;
-    config.plan_data_size = 1024;
-    config.max_bound_tables = domain->database_req.num_tables;
+    if (!plnnr::compute_config(&config, domain, &db, 5, 3))
+    {
+        printf("planning state doesn't fit the budgets!\n");
+        return 1;
+    }
 
     plnnr::Planning_State pstate;
     plnnr::init(&pstate, &default_mem, &config);
@@ -61,6 +61,8 @@ ast::Fact*      get_primitive(const ast::Root* self, const Token_Value& name);
 void        append_child(ast::Expr* parent, ast::Expr* child);
 // make `child` the next sibling of `after`.
 void        insert_child(ast::Expr* after, ast::Expr* child);
+// make node `child` the first child of node `parent`.
+void        prepend_child(ast::Expr* parent, ast::Expr* child);
 // unparent `node` from it's current parent.
 void        unparent(ast::Expr* node);
 // returns the next node in pre-order (visit node then visit it's children) traversal.
@@ -78,20 +80,27 @@ ast::Attribute* find_attribute(const ast::Node* node, Attribute_Type type);
 
 /// Attributes.
 
-// returns the number of arguments allowed for an attribute of a given `type`.
+// returns the number of arguments allowed for an attribute of a given `type` (minimum number for attributes with argument lists).
 uint32_t                        get_num_args(Attribute_Type type);
 // returns an array of argument classes allowed for an attribute of a given `type`.
 const Attribute_Arg_Class*      get_arg_classes(Attribute_Type type);
+// returns true if the last argument of an attribute of a given `type` could be repeated.
+bool                            has_arg_list(Attribute_Type type);
+// returns true if an attribute of a given `type` could be specified multiple times.
+bool                            is_repeatable(Attribute_Type type);
 
 /// Expression transformations.
 
 // converts expression `root` to Disjunctive-Normal-Form.
 ast::Expr*  convert_to_dnf(const ast::Root* tree, ast::Expr* root);
 
+// converts expression `root` to Negative-Normal-Form under the top level `Or` node, disjunctions nested in conjunctions are kept.
+ast::Expr*  convert_to_factorized(const ast::Root* tree, ast::Expr* root);
+
 // inline macros into the case preconditions.
 void        inline_macros(ast::Root* tree);
 
-// converts all preconditions to DNF.
+// converts all preconditions to DNF, preconditions of `:factorized` cases are converted with `convert_to_factorized`.
 void        convert_to_dnf(const ast::Root* tree);
 
 // build various look-ups and traversal info.
@@ -100,6 +109,10 @@ void        annotate(ast::Root* tree);
 // figure out types of parameters and variables.
 bool        infer_types(const ast::Root* tree);
 
+// optimizes the preconditions: folds constant intrinsic calls, moves expressions to the outermost loop where their variables are bound,
+// assigns loop invariant subexpressions to hidden variables, sorts facts of `:unordered` cases to iterate bound and small tables first.
+void        optimize_preconditions(ast::Root* tree);
+
 // convert literal token value to integer.
 int64_t as_int(const ast::Literal* node);
 // convert literal token value to float.
@@ -26,6 +26,14 @@
     #define PLNNRC_ATTRIBUTE_ARG(ARG_TYPE)
 #endif
 
+#ifndef PLNNRC_ATTRIBUTE_ARG_LIST
+    #define PLNNRC_ATTRIBUTE_ARG_LIST(ARG_TYPE) PLNNRC_ATTRIBUTE_ARG(ARG_TYPE)
+#endif
+
+#ifndef PLNNRC_ATTRIBUTE_REPEATABLE
+    #define PLNNRC_ATTRIBUTE_REPEATABLE
+#endif
+
 #ifndef PLNNRC_ATTRIBUTE_END
     #define PLNNRC_ATTRIBUTE_END
 #endif
@@ -38,6 +46,30 @@ PLNNRC_ATTRIBUTE(Size,      ":size")
     PLNNRC_ATTRIBUTE_ARG(Constant_Expression)
 PLNNRC_ATTRIBUTE_END
 
+PLNNRC_ATTRIBUTE(Index,     ":index")
+    PLNNRC_ATTRIBUTE_ARG_LIST(Constant_Expression)
+    PLNNRC_ATTRIBUTE_REPEATABLE
+PLNNRC_ATTRIBUTE_END
+
+PLNNRC_ATTRIBUTE(Ordered,   ":ordered")
+    PLNNRC_ATTRIBUTE_ARG(Constant_Expression)
+    PLNNRC_ATTRIBUTE_REPEATABLE
+PLNNRC_ATTRIBUTE_END
+
+PLNNRC_ATTRIBUTE(Unordered, ":unordered")
+PLNNRC_ATTRIBUTE_END
+
+PLNNRC_ATTRIBUTE(Factorized, ":factorized")
+PLNNRC_ATTRIBUTE_END
+
+PLNNRC_ATTRIBUTE(Distinct,  ":distinct")
+PLNNRC_ATTRIBUTE_END
+
+PLNNRC_ATTRIBUTE(Parallel,  ":parallel")
+PLNNRC_ATTRIBUTE_END
+
 #undef PLNNRC_ATTRIBUTE_END
+#undef PLNNRC_ATTRIBUTE_REPEATABLE
+#undef PLNNRC_ATTRIBUTE_ARG_LIST
 #undef PLNNRC_ATTRIBUTE_ARG
 #undef PLNNRC_ATTRIBUTE
@@ -47,6 +47,9 @@ PLNNRC_AST_ERROR(Expected_Argument_Type,        "expected argument type $0 for $
 PLNNRC_AST_ERROR(Failed_To_Resolve_Call,        "failed to resolve function call $0.")
 PLNNRC_AST_ERROR(Only_Single_Attr_Allowed,      "only single attribute $0 is allowed.")
 PLNNRC_AST_ERROR(Only_Const_Expr_Allowed,       "only constant expression is allowed in $0.")
+PLNNRC_AST_ERROR(Invalid_Index_Column,          "invalid column in $0, expected unique parameter index of $1.")
+PLNNRC_AST_ERROR(Too_Many_Indexes,              "too many indexes declared for $0.")
+PLNNRC_AST_ERROR(Ordered_Index_Not_Numeric,     "column in $0 must be int8, int32, int64 or float.")
 
 #undef PLNNRC_AST_ERROR
 #undef PLNNRC_PARSER_ERROR
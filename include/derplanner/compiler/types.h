@@ -425,6 +425,8 @@ namespace ast
         Location                loc;
         // task parameters.
         Array<Param*>           params;
+        // attributes defined on this task.
+        Array<Attribute*>       attrs;
         // expansion cases.
         Array<Case*>            cases;
         // param name -> node.
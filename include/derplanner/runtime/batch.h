@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2015 Alexander Shafranov shafranov@gmail.com
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software. If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+
+#ifndef DERPLANNER_RUNTIME_BATCH_H_
+#define DERPLANNER_RUNTIME_BATCH_H_
+
+#include "derplanner/runtime/memory.h"
+#include "derplanner/runtime/types.h"
+#include "derplanner/runtime/planning.h"
+
+namespace plnnr {
+
+// Batch planning on a fixed pool of worker threads.
+//
+// Jobs are spread over the per-worker deques, a worker pops jobs from the back of its own deque
+// and steals from the front of the other deques when its own is empty.
+// Planning only reads the database, so a database can be shared by any number of jobs, while each job needs its own `Planning_State`.
+
+// A single planning job.
+struct Find_Plan_Job
+{
+    // initialized state, bound to the job's domain & database.
+    Planning_State*         state;
+    // database to find the plan for, may be shared with the other jobs.
+    const Fact_Database*    db;
+    // domain the state is bound to.
+    const Domain_Info*      domain;
+    // compound task (without parameters) to find the plan for.
+    uint32_t                root_task;
+    // resulting status, set when the job is done.
+    Find_Plan_Status        status;
+};
+
+// Worker thread & its deque of jobs, defined in batch.cpp.
+struct Batch_Worker;
+// Synchronization between the workers, defined in batch.cpp.
+struct Batch_Sync;
+
+struct Batch_Planner
+{
+    // number of workers, the thread calling `find_plans` is the worker 0.
+    uint32_t        num_workers;
+    // worker threads & deques.
+    Batch_Worker*   workers;
+    // starts the workers and waits for them to finish.
+    Batch_Sync*     sync;
+    // job indices storage, split between the deques.
+    uint32_t*       job_indices;
+    // number of `job_indices`, grows with the batch size.
+    uint32_t        max_jobs;
+    // allocator.
+    Memory*         memory;
+};
+
+// starts `num_workers - 1` threads, which wait for the jobs.
+void init(Batch_Planner* self, Memory* mem, uint32_t num_workers);
+// stops & joins the worker threads.
+void destroy(Batch_Planner* self);
+
+// finds plans for all `jobs`, returns when every job has its `status` set.
+void find_plans(Batch_Planner* self, Find_Plan_Job* jobs, uint32_t num_jobs);
+
+// Speculative case evaluation.
+//
+// When a case of a `:parallel` task fails, the preconditions of the next `max_cases` cases are evaluated at once on the `pool` workers,
+// each into a private copy of the frame. The cases are still expanded in the source order, a case copies the first satisfier found for it
+// and continues its precondition from there. The first case of the task & `:sorted`/`:distinct` cases are evaluated when expanded,
+// the evaluated results are discarded after each `find_plan_step`.
+//
+// The pool is used from the planning thread, so it can't be shared with the other planning states running at the same time
+// and can't be the one running this state in `find_plans`.
+
+// enables speculation for the `domain` bound state, disables it if `pool` is null or `max_cases` is less than 2.
+void set_speculation(Planning_State* self, const Domain_Info* domain, Batch_Planner* pool, uint32_t max_cases);
+
+}
+
+#endif
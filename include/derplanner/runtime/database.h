@@ -23,6 +23,7 @@
 
 #include "derplanner/runtime/memory.h"
 #include "derplanner/runtime/types.h"
+#include "derplanner/runtime/scan.h"
 
 namespace plnnr {
 
@@ -37,9 +38,74 @@ void clear(Fact_Table* self);
 // grows or compacts table stogare.
 void set_max_entries(Fact_Table* self, uint32_t max_entries);
 
+// sets the growth policy used by `add_entry` when the table is full (e.g. `growth_double`), null disables growth.
+void set_growth(Fact_Table* self, Fact_Table_Growth* growth);
+
+// doubles the table capacity.
+uint32_t growth_double(const Fact_Table* self, uint32_t required_entries);
+
+// makes sure there's storage for `num_entries` entries, grows the table using its growth policy.
+void reserve(Fact_Table* self, uint32_t num_entries);
+
+// converts the vec3 columns to `layout`, planes allow vectorized filtering over the vec3 columns.
+void set_vec3_layout(Fact_Table* self, Vec3_Layout layout);
+
+// copies the read-only columns of a snapshot table (see `load_snapshot`) to the allocated storage, called before the entries are modified.
+void copy_snapshot_columns(Fact_Table* self);
+// same as `copy_snapshot_columns` with room for at least `num_entries` entries, called before the entries are appended.
+void reserve_snapshot(Fact_Table* self, uint32_t num_entries);
+
+// enables the distinct values sketches used by `estimate_rows`, the entries already in the table are added.
+// disabled by default so insertions don't hash every column, without the sketches estimates ignore the bound columns.
+void set_stats(Fact_Table* self, bool enabled);
+// adds values of `count` entries starting from `entry_index` to the distinct values sketches, if enabled.
+void update_stats(Fact_Table* self, uint32_t entry_index, uint32_t count);
+// approximate number of distinct values in the `column`.
+uint32_t estimate_distinct(const Fact_Table* self, uint32_t column);
+
+// typed column data for the row filters and full table scans, `load_row` reads the value of an entry.
+template <typename T>
+const T* get_column(const Fact_Table* self, uint32_t column);
+Vec3_Column get_vec3_column(const Fact_Table* self, uint32_t column);
+
+// returns the flags of the entries removed by `remove_entry_stable`, null if there're none.
+const uint8_t* get_removed(const Fact_Table* self);
+
 // retuns true if there're no tuples in the table.
 bool empty(const Fact_Table* self);
 
+// removes entry by moving the last entry in its place, invalidates handles to the last entry.
+void remove_entry(Fact_Table* self, uint32_t entry_index);
+
+// marks entry as removed, handles to the other entries stay valid. removed entries are skipped by iteration until `compact` is called.
+void remove_entry_stable(Fact_Table* self, uint32_t entry_index);
+
+// returns true if the entry was removed by `remove_entry_stable`.
+bool is_removed(const Fact_Table* self, uint32_t entry_index);
+
+// erases entries removed by `remove_entry_stable`, keeping the order of the remaining entries.
+void compact(Fact_Table* self);
+
+// set `value` for a fact parameter of an existing entry, keeping table indexes consistent.
+template <typename T>
+void update_arg(Fact_Table* self, uint32_t entry_index, uint32_t param_index, const T& value);
+
+// returns the first entry with the hash index `index` columns equal to the key (k0,), or `Fact_Index_End` if there's no such entry.
+template <typename T0>
+uint32_t find_entry(const Fact_Table* self, uint32_t index, const T0& k0);
+
+// returns the first entry with the hash index `index` columns equal to the key (k0, k1), or `Fact_Index_End` if there's no such entry.
+template <typename T0, typename T1>
+uint32_t find_entry(const Fact_Table* self, uint32_t index, const T0& k0, const T1& k1);
+
+// returns the first entry with the hash index `index` columns equal to the key (k0, k1, k2), or `Fact_Index_End` if there's no such entry.
+template <typename T0, typename T1, typename T2>
+uint32_t find_entry(const Fact_Table* self, uint32_t index, const T0& k0, const T1& k1, const T2& k2);
+
+// returns the first entry with the hash index `index` columns equal to the key (k0, k1, k2, k3), or `Fact_Index_End` if there's no such entry.
+template <typename T0, typename T1, typename T2, typename T3>
+uint32_t find_entry(const Fact_Table* self, uint32_t index, const T0& k0, const T1& k1, const T2& k2, const T3& k3);
+
 // set `value` for a fact parameter.
 template <typename T>
 void set_arg(Fact_Table* self, uint32_t entry_index, uint32_t param_index, const T& value);
@@ -76,6 +142,12 @@ void add_entry(Fact_Table* self, const T0& a0, const T1& a1, const T2& a2, const
 template <typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
 void add_entry(Fact_Table* self, const T0& a0, const T1& a1, const T2& a2, const T3& a3, const T4& a4, const T5& a5, const T6& a6, const T7& a7);
 
+// appends `count` facts, `columns[i]` points to `count` tightly packed values of the i-th fact parameter.
+void add_entries(Fact_Table* self, uint32_t count, const void* const* columns);
+
+// appends `count` facts stored in row-major order, tuples are described by `layout` and placed `stride` bytes apart.
+void add_entries(Fact_Table* self, uint32_t count, const void* rows, const Param_Layout* layout, size_t stride);
+
 // fact argument accessors.
 #define PLNNR_TYPE(TYPE_TAG, TYPE_NAME)                                                         \
     TYPE_NAME as_##TYPE_TAG(const Fact_Table* self, uint32_t entry_index, uint32_t arg_index);  \
@@ -83,6 +155,30 @@ void add_entry(Fact_Table* self, const T0& a0, const T1& a1, const T2& a2, const
     #include "derplanner/runtime/type_tags.inl"
 #undef PLNNR_TYPE
 
+/// Fact_Index
+
+// builds a hash index on `format` columns of the table, returns index of the created index in `Fact_Table::indexes`.
+uint32_t add_index(Fact_Table* self, const Fact_Index_Format* format);
+
+// builds an ordered index on a numeric `column` of the table, returns index of the created index in `Fact_Table::ordered_indexes`.
+uint32_t add_ordered_index(Fact_Table* self, uint8_t column);
+
+// inserts table entry into all table indexes, called by `add_entry`.
+void update_indexes(Fact_Table* self, uint32_t entry_index);
+
+// removes entry from the table indexes before `param_index` value is changed, called by `update_arg`.
+void unlink_indexes(Fact_Table* self, uint32_t entry_index, uint32_t param_index);
+
+// inserts entry into the table indexes after `param_index` value is changed, called by `update_arg`.
+void link_indexes(Fact_Table* self, uint32_t entry_index, uint32_t param_index);
+
+// combines `hash` with the hash of an indexed column value, index probes are hashed in the index column order starting with 0.
+#define PLNNR_TYPE(TYPE_TAG, TYPE_NAME)                         \
+    uint32_t hash_##TYPE_TAG(uint32_t hash, TYPE_NAME value);   \
+
+    #include "derplanner/runtime/type_tags.inl"
+#undef PLNNR_TYPE
+
 /// Param_Layout
 
 // set `value` for a tuple `data`, which has the memory layout specified by `Param_Layout`.
@@ -94,19 +190,88 @@ void set_arg(void* data, const Param_Layout* layout, uint32_t param_index, const
 void init(Fact_Database* self, Memory* mem, const Database_Format* format);
 void destroy(Fact_Database* self);
 
+// creates an overlay database with the tables of the read-only `base`, each table has storage for `max_entries` own entries.
+// iteration visits the base entries first and then the entries added to the overlay. `base` must outlive the overlay.
+void init_overlay(Fact_Database* self, Memory* mem, const Fact_Database* base, uint32_t max_entries);
+
+/// Snapshot
+
+// returns number of bytes needed to save the database snapshot, removed entries are not saved.
+size_t get_snapshot_size(const Fact_Database* self);
+
+// saves the database snapshot (including the base entries of an overlay) to the `Snapshot_Alignment` aligned `buffer`.
+// returns the number of bytes written, or 0 if the buffer is too small.
+size_t save_snapshot(const Fact_Database* self, void* buffer, size_t buffer_size);
+
+// creates database with tables described by `format`, columns point directly to the snapshot `data` (e.g. memory-mapped file).
+// snapshot must be `Snapshot_Alignment` aligned and outlive the database, it is never written: a table copies its columns on the first modification.
+// returns false if the snapshot version, hash seed, table hashes or fact types don't match.
+bool load_snapshot(Fact_Database* self, Memory* mem, const Database_Format* format, const void* data, size_t size);
+
+// sets the growth policy for all tables in the database.
+void set_growth(Fact_Database* self, Fact_Table_Growth* growth);
+
+// converts the vec3 columns of all tables in the database to `layout`.
+void set_vec3_layout(Fact_Database* self, Vec3_Layout layout);
+
 // returns a handle to the first entry in database table.
 Fact_Handle first(const Fact_Database* self, const uint32_t table_index);
 // advances handle to the next entry.
 Fact_Handle next(const Fact_Database* self, const Fact_Handle handle);
+// advances handle to the first entry of the next table visited by `first`/`next`, i.e. from the base table of an overlay to its own table.
+// the generated full table scans iterate the entries of each table by index, using this to move between the tables.
+Fact_Handle next_table(const Fact_Database* self, const Fact_Handle handle);
+
+// returns a handle to the first entry with the index columns hash equal to `hash`.
+// falls back to a full table scan if the table has no such index.
+Fact_Handle first(const Fact_Database* self, const uint32_t table_index, const uint32_t index, const uint32_t hash);
+// advances handle to the next entry with the same index columns hash.
+Fact_Handle next(const Fact_Database* self, const Fact_Handle handle, const uint32_t index);
+
+// returns a cursor over the positions of the ordered index entries satisfying `column <op> value`.
+// cursor `entry` is the current position, cursor `table` is the end position.
+// falls back to a cursor over all table entries if the table has no such index.
+template <typename T>
+Fact_Handle first_in_range(const Fact_Database* self, const uint32_t table_index, const uint32_t index, Range_Op op, const T& value);
+// returns a handle to the entry at the cursor position, the handle is invalid when the cursor reaches the end.
+Fact_Handle range_entry(const Fact_Database* self, const uint32_t table_index, const uint32_t index, const Fact_Handle cursor);
+// advances the cursor to the next position.
+Fact_Handle next_in_range(const Fact_Database* self, const uint32_t table_index, const uint32_t index, const Fact_Handle cursor);
+
+// returns a handle to the first entry with the `column` equal to `value`, found with a vectorized column scan.
+// `T` must be the column type, one of Id32, Id64, Int8, Int32 or Int64.
+template <typename T>
+Fact_Handle first_equal(const Fact_Database* self, const uint32_t table_index, const uint32_t column, const T value);
+// advances handle to the next entry with the `column` equal to `value`.
+template <typename T>
+Fact_Handle next_equal(const Fact_Database* self, const Fact_Handle handle, const uint32_t column, const T value);
+
+// returns a handle to the first entry accepted by the row filter, which evaluates blocks of up to 64 entries:
+// `uint64_t filter(const Fact_Table* table, uint32_t begin, uint32_t end)` returns a mask of the accepted entries in [begin, end).
+// `mask` keeps the mask of the current block between the calls.
+template <typename Filter>
+Fact_Handle first_filtered(const Fact_Database* self, const uint32_t table_index, uint64_t& mask, const Filter& filter);
+// advances handle to the next entry accepted by the row filter.
+template <typename Filter>
+Fact_Handle next_filtered(const Fact_Database* self, const Fact_Handle handle, uint64_t& mask, const Filter& filter);
+
+// approximate number of entries matching a key on the `bound_columns` (bit mask of column indices),
+// used by the generated preconditions to choose the join order.
+uint32_t estimate_rows(const Fact_Database* self, const uint32_t table_index, const uint32_t bound_columns);
 
 // search for table by fact name hash.
 const Fact_Table*   find_table(const Fact_Database* self, const char* fact_name);
 Fact_Table*         find_table(Fact_Database* self, const char* fact_name);
+// finds table by the name which is not null terminated.
+Fact_Table*         find_table(Fact_Database* self, const char* fact_name, uint32_t length);
 
 /// Fact_Handle
 
 bool is_valid(const Fact_Database* self, const Fact_Handle handle);
 
+// returns the table `handle` refers to, which is a base table for the base entries of an overlay database.
+const Fact_Table* get_table(const Fact_Database* self, const Fact_Handle handle);
+
 /// Type
 
 // returns size of the type `t`.
@@ -72,7 +72,8 @@ inline uint32_t murmur2_32(const void* key, uint32_t len, uint32_t seed)
 } 
 
 inline Fact_Database::Fact_Database()
-    : memory(0)
+    : base(0)
+    , memory(0)
 {
 }
 
@@ -86,29 +87,521 @@ inline Fact_Database::~Fact_Database()
 
 /// Fact_Handle
 
+// returns the table the handle refers to, either overlay's own table or the base one.
+inline const Fact_Table* get_table(const Fact_Database* self, const Fact_Handle handle)
+{
+    if (handle.table < self->num_tables)
+    {
+        return self->tables + handle.table;
+    }
+
+    plnnr_assert(self->base != 0 && handle.table < 2 * self->num_tables);
+    return self->base->tables + (handle.table - self->num_tables);
+}
+
 inline bool is_valid(const Fact_Database* self, const Fact_Handle handle)
 {
-    plnnr_assert(handle.table < self->num_tables);
-    const Fact_Table* table = self->tables + handle.table;
+    const Fact_Table* table = get_table(self, handle);
     const uint32_t num_entries = table->num_entries;
     return handle.entry < num_entries;
 }
 
+/// Fact_Table
+
+// returns `entry`, or the closest entry after it, which wasn't removed by `remove_entry_stable`.
+inline uint32_t skip_removed(const Fact_Table* self, uint32_t entry)
+{
+    if (self->num_removed > 0)
+    {
+        while (entry < self->num_entries && self->removed[entry])
+        {
+            ++entry;
+        }
+    }
+
+    return entry;
+}
+
+/// Fact_Index
+
+// returns the first entry in the bucket chain with the hash equal to `hash`.
+inline uint32_t first_in_chain(const Fact_Index* self, uint32_t hash)
+{
+    uint32_t entry = self->heads[hash & (self->num_buckets - 1)];
+
+    while (entry != Fact_Index_End && self->hashes[entry] != hash)
+    {
+        entry = self->next[entry];
+    }
+
+    return entry;
+}
+
+// returns the next entry in the bucket chain with the same hash as `entry`.
+// `entry` itself might have been removed by `remove_entry_stable`, its successors are checked against `table`.
+inline uint32_t next_in_chain(const Fact_Table* table, const Fact_Index* self, uint32_t entry)
+{
+    const uint32_t hash = self->hashes[entry];
+    entry = self->next[entry];
+
+    while (entry != Fact_Index_End && (self->hashes[entry] != hash || (table->num_removed > 0 && table->removed[entry])))
+    {
+        entry = self->next[entry];
+    }
+
+    return entry;
+}
+
+// returns the first entry with the hash equal to `hash`, all entries are iterated if table has no `index`.
+inline uint32_t first_entry(const Fact_Table* self, const uint32_t index, const uint32_t hash)
+{
+    // removed entries are unlinked from the bucket chains.
+    if (index < self->num_indexes)
+        return first_in_chain(self->indexes + index, hash);
+
+    return skip_removed(self, 0);
+}
+
+inline uint32_t next_entry(const Fact_Table* self, const uint32_t index, const uint32_t entry)
+{
+    if (index < self->num_indexes)
+        return next_in_chain(self, self->indexes + index, entry);
+
+    return skip_removed(self, entry + 1);
+}
+
 /// Fact_Database
 
-inline Fact_Handle first(const Fact_Database* /*self*/, const uint32_t table_index)
+// overlay databases iterate the base table entries first, then the own ones.
+
+inline Fact_Handle first(const Fact_Database* self, const uint32_t table_index)
+{
+    plnnr_assert(table_index < self->num_tables);
+    Fact_Handle handle;
+
+    if (self->base)
+    {
+        const Fact_Table* base_table = self->base->tables + table_index;
+        handle.table = table_index + self->num_tables;
+        handle.entry = skip_removed(base_table, 0);
+
+        if (handle.entry < base_table->num_entries)
+            return handle;
+    }
+
+    handle.table = table_index;
+    handle.entry = skip_removed(self->tables + table_index, 0);
+    return handle;
+}
+
+inline Fact_Handle next(const Fact_Database* self, const Fact_Handle handle)
+{
+    const Fact_Table* table = get_table(self, handle);
+    Fact_Handle result;
+    result.table = handle.table;
+    result.entry = skip_removed(table, handle.entry + 1);
+
+    if (handle.table >= self->num_tables && result.entry >= table->num_entries)
+    {
+        result.table = handle.table - self->num_tables;
+        result.entry = skip_removed(self->tables + result.table, 0);
+    }
+
+    return result;
+}
+
+inline Fact_Handle next_table(const Fact_Database* self, const Fact_Handle handle)
+{
+    Fact_Handle result;
+
+    if (handle.table >= self->num_tables)
+    {
+        result.table = handle.table - self->num_tables;
+        result.entry = skip_removed(self->tables + result.table, 0);
+        return result;
+    }
+
+    result.table = handle.table;
+    result.entry = self->tables[handle.table].num_entries;
+    return result;
+}
+
+inline Fact_Handle first(const Fact_Database* self, const uint32_t table_index, const uint32_t index, const uint32_t hash)
+{
+    plnnr_assert(table_index < self->num_tables);
+    Fact_Handle handle;
+
+    if (self->base)
+    {
+        const Fact_Table* base_table = self->base->tables + table_index;
+        handle.table = table_index + self->num_tables;
+        handle.entry = first_entry(base_table, index, hash);
+
+        if (handle.entry < base_table->num_entries)
+            return handle;
+    }
+
+    handle.table = table_index;
+    handle.entry = first_entry(self->tables + table_index, index, hash);
+    return handle;
+}
+
+inline Fact_Handle next(const Fact_Database* self, const Fact_Handle handle, const uint32_t index)
+{
+    const Fact_Table* table = get_table(self, handle);
+    Fact_Handle result;
+    result.table = handle.table;
+    result.entry = next_entry(table, index, handle.entry);
+
+    if (handle.table >= self->num_tables && result.entry >= table->num_entries)
+    {
+        result.table = handle.table - self->num_tables;
+        const Fact_Table* own_table = self->tables + result.table;
+
+        // entries in the chain have the same hash as the probe.
+        if (index < table->num_indexes)
+            result.entry = first_entry(own_table, index, table->indexes[index].hashes[handle.entry]);
+        else
+            result.entry = skip_removed(own_table, 0);
+    }
+
+    return result;
+}
+
+/// Range lookups in `Fact_Ordered_Index`.
+
+// returns true if `x` is located before the partition point of the range `x <op> value` in the ordered index.
+template <typename T, typename V>
+inline bool range_prefix(Range_Op op, const T& x, const V& value)
+{
+    switch (op)
+    {
+    case Range_Less:
+        return x < value;
+    case Range_Less_Equal:
+        return x <= value;
+    case Range_Greater:
+        return !(x > value);
+    case Range_Greater_Equal:
+        return !(x >= value);
+    default:
+        plnnr_assert(false);
+        return false;
+    }
+}
+
+// false for values which are not ordered by comparison operators (NaNs).
+template <typename T>
+inline bool is_ordered_value(const T&)
+{
+    return true;
+}
+
+inline bool is_ordered_value(float x)
+{
+    return x == x;
+}
+
+template <typename T, typename V>
+inline Fact_Handle ordered_range(const T* column, const uint32_t* entries, uint32_t num_entries, Range_Op op, const V& value)
+{
+    // NaNs are ordered last and never satisfy a comparison, skip them.
+    uint32_t lo = 0;
+    uint32_t hi = num_entries;
+    while (lo < hi)
+    {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        if (is_ordered_value(column[entries[mid]])) { lo = mid + 1; } else { hi = mid; }
+    }
+
+    const uint32_t num_ordered = lo;
+
+    lo = 0;
+    hi = num_ordered;
+    while (lo < hi)
+    {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        if (range_prefix(op, column[entries[mid]], value)) { lo = mid + 1; } else { hi = mid; }
+    }
+
+    Fact_Handle cursor;
+
+    if (op == Range_Less || op == Range_Less_Equal)
+    {
+        cursor.entry = 0;
+        cursor.table = lo;
+    }
+    else
+    {
+        cursor.entry = lo;
+        cursor.table = num_ordered;
+    }
+
+    return cursor;
+}
+
+// returns `cursor`, or the closest cursor position after it, which refers to the entry not removed by `remove_entry_stable`.
+inline Fact_Handle skip_removed(const Fact_Table* table, const uint32_t index, Fact_Handle cursor)
+{
+    if (table->num_removed > 0)
+    {
+        const uint32_t* entries = (index < table->num_ordered_indexes) ? table->ordered_indexes[index].entries : 0;
+
+        while (cursor.entry < cursor.table && table->removed[entries ? entries[cursor.entry] : cursor.entry])
+        {
+            ++cursor.entry;
+        }
+    }
+
+    return cursor;
+}
+
+// returns cursor over the table entries in `op` range of `value`, all entries are iterated if table has no `index`.
+template <typename T>
+inline Fact_Handle table_range(const Fact_Table* table, const uint32_t index, Range_Op op, const T& value)
+{
+    Fact_Handle cursor;
+    cursor.entry = 0;
+    cursor.table = table->num_entries;
+
+    if (index < table->num_ordered_indexes)
+    {
+        const Fact_Ordered_Index* ordered_index = table->ordered_indexes + index;
+        const uint8_t column = ordered_index->column;
+        const uint32_t* entries = ordered_index->entries;
+        const uint32_t num_entries = table->num_entries;
+
+        switch (table->format.types[column])
+        {
+        case Type_Int8:
+            cursor = ordered_range(static_cast<const int8_t*>(table->columns[column]), entries, num_entries, op, value);
+            break;
+        case Type_Int32:
+            cursor = ordered_range(static_cast<const int32_t*>(table->columns[column]), entries, num_entries, op, value);
+            break;
+        case Type_Int64:
+            cursor = ordered_range(static_cast<const int64_t*>(table->columns[column]), entries, num_entries, op, value);
+            break;
+        case Type_Float:
+            cursor = ordered_range(static_cast<const float*>(table->columns[column]), entries, num_entries, op, value);
+            break;
+        default:
+            plnnr_assert(false);
+            break;
+        }
+    }
+
+    // removed entries are kept in the ordered index until `compact`.
+    return skip_removed(table, index, cursor);
+}
+
+// returns cursor over all entries of the table.
+inline Fact_Handle table_range(const Fact_Table* table, const uint32_t index)
+{
+    Fact_Handle cursor;
+    cursor.entry = 0;
+    cursor.table = table->num_entries;
+    return skip_removed(table, index, cursor);
+}
+
+// overlay databases iterate the base table range first, then all own entries (which are expected to be few),
+// so the generated code must check the range condition for each entry.
+
+template <typename T>
+inline Fact_Handle first_in_range(const Fact_Database* self, const uint32_t table_index, const uint32_t index, Range_Op op, const T& value)
+{
+    plnnr_assert(table_index < self->num_tables);
+
+    if (self->base)
+    {
+        Fact_Handle cursor = table_range(self->base->tables + table_index, index, op, value);
+
+        if (cursor.entry < cursor.table)
+        {
+            cursor.table |= Fact_Base_Cursor;
+            return cursor;
+        }
+
+        return table_range(self->tables + table_index, index);
+    }
+
+    return table_range(self->tables + table_index, index, op, value);
+}
+
+inline Fact_Handle range_entry(const Fact_Database* self, const uint32_t table_index, const uint32_t index, const Fact_Handle cursor)
+{
+    plnnr_assert(table_index < self->num_tables);
+    const bool is_base = (cursor.table & Fact_Base_Cursor) != 0;
+    const Fact_Table* table = is_base ? self->base->tables + table_index : self->tables + table_index;
+
+    Fact_Handle handle;
+    handle.table = is_base ? table_index + self->num_tables : table_index;
+    handle.entry = Fact_Index_End;
+
+    if (cursor.entry < (cursor.table & ~uint32_t(Fact_Base_Cursor)))
+    {
+        handle.entry = (index < table->num_ordered_indexes) ? table->ordered_indexes[index].entries[cursor.entry] : cursor.entry;
+    }
+
+    return handle;
+}
+
+inline Fact_Handle next_in_range(const Fact_Database* self, const uint32_t table_index, const uint32_t index, const Fact_Handle cursor)
+{
+    plnnr_assert(table_index < self->num_tables);
+    Fact_Handle result;
+    result.table = cursor.table;
+    result.entry = cursor.entry + 1;
+
+    if (cursor.table & Fact_Base_Cursor)
+    {
+        result.table = cursor.table & ~uint32_t(Fact_Base_Cursor);
+        result = skip_removed(self->base->tables + table_index, index, result);
+
+        if (result.entry < result.table)
+        {
+            result.table |= Fact_Base_Cursor;
+            return result;
+        }
+
+        return table_range(self->tables + table_index, index);
+    }
+
+    return skip_removed(self->tables + table_index, index, result);
+}
+
+// returns `entry`, or the closest entry after it, with the `column` equal to `value`, which wasn't removed by `remove_entry_stable`.
+template <typename T>
+inline uint32_t find_equal(const Fact_Table* self, const uint32_t column, uint32_t entry, const T value)
+{
+    plnnr_assert(column < self->format.num_params);
+    plnnr_assert(get_type_size(self->format.types[column]) == sizeof(T));
+    const T* values = static_cast<const T*>(self->columns[column]);
+    entry = find_equal(values, entry, self->num_entries, value);
+
+    if (self->num_removed > 0)
+    {
+        while (entry < self->num_entries && self->removed[entry])
+        {
+            entry = find_equal(values, entry + 1, self->num_entries, value);
+        }
+    }
+
+    return entry;
+}
+
+template <typename T>
+inline Fact_Handle first_equal(const Fact_Database* self, const uint32_t table_index, const uint32_t column, const T value)
+{
+    plnnr_assert(table_index < self->num_tables);
+    Fact_Handle handle;
+
+    if (self->base)
+    {
+        const Fact_Table* base_table = self->base->tables + table_index;
+        handle.table = table_index + self->num_tables;
+        handle.entry = find_equal(base_table, column, 0, value);
+
+        if (handle.entry < base_table->num_entries)
+            return handle;
+    }
+
+    handle.table = table_index;
+    handle.entry = find_equal(self->tables + table_index, column, 0, value);
+    return handle;
+}
+
+template <typename T>
+inline Fact_Handle next_equal(const Fact_Database* self, const Fact_Handle handle, const uint32_t column, const T value)
+{
+    const Fact_Table* table = get_table(self, handle);
+    Fact_Handle result;
+    result.table = handle.table;
+    result.entry = find_equal(table, column, handle.entry + 1, value);
+
+    if (handle.table >= self->num_tables && result.entry >= table->num_entries)
+    {
+        result.table = handle.table - self->num_tables;
+        result.entry = find_equal(self->tables + result.table, column, 0, value);
+    }
+
+    return result;
+}
+
+// returns `entry`, or the closest entry after it, accepted by the row `filter`, which wasn't removed by `remove_entry_stable`.
+// the filter runs when `entry` enters a new block of 64 entries, the block mask is stored in `mask`.
+template <typename Filter>
+inline uint32_t find_filtered(const Fact_Table* self, uint32_t entry, uint64_t& mask, const Filter& filter)
+{
+    uint64_t bits = mask;
+
+    while (entry < self->num_entries)
+    {
+        const uint32_t offset = entry & 63;
+
+        if (offset == 0)
+        {
+            const uint32_t end = (self->num_entries - entry > 64) ? entry + 64 : self->num_entries;
+            bits = filter(self, entry, end);
+        }
+
+        const uint64_t remaining = bits >> offset;
+
+        if (remaining == 0)
+        {
+            entry = (entry | 63) + 1;
+            continue;
+        }
+
+        entry += lowest_bit(remaining);
+
+        if (!is_removed(self, entry))
+        {
+            break;
+        }
+
+        ++entry;
+    }
+
+    mask = bits;
+    return entry;
+}
+
+template <typename Filter>
+inline Fact_Handle first_filtered(const Fact_Database* self, const uint32_t table_index, uint64_t& mask, const Filter& filter)
 {
+    plnnr_assert(table_index < self->num_tables);
     Fact_Handle handle;
+
+    if (self->base)
+    {
+        const Fact_Table* base_table = self->base->tables + table_index;
+        handle.table = table_index + self->num_tables;
+        handle.entry = find_filtered(base_table, 0, mask, filter);
+
+        if (handle.entry < base_table->num_entries)
+            return handle;
+    }
+
     handle.table = table_index;
-    handle.entry = 0;
+    handle.entry = find_filtered(self->tables + table_index, 0, mask, filter);
     return handle;
 }
 
-inline Fact_Handle next(const Fact_Database* /*self*/, const Fact_Handle handle)
+template <typename Filter>
+inline Fact_Handle next_filtered(const Fact_Database* self, const Fact_Handle handle, uint64_t& mask, const Filter& filter)
 {
+    const Fact_Table* table = get_table(self, handle);
     Fact_Handle result;
     result.table = handle.table;
-    result.entry = handle.entry + 1;
+    result.entry = find_filtered(table, handle.entry + 1, mask, filter);
+
+    if (handle.table >= self->num_tables && result.entry >= table->num_entries)
+    {
+        result.table = handle.table - self->num_tables;
+        result.entry = find_filtered(self->tables + result.table, 0, mask, filter);
+    }
+
     return result;
 }
 
@@ -146,6 +639,98 @@ inline uint32_t get_type_alignment(Type t)
     }
 }
 
+/// column values of `Fact_Table`, vec3 columns are stored according to `Fact_Table::vec3_layout`.
+
+template <typename T>
+inline T load_value(const Fact_Table* self, uint32_t column, uint32_t entry_index)
+{
+    return static_cast<const T*>(self->columns[column])[entry_index];
+}
+
+template <>
+inline Vec3 load_value<Vec3>(const Fact_Table* self, uint32_t column, uint32_t entry_index)
+{
+    if (self->vec3_layout == Vec3_Layout_Planes)
+    {
+        const float* x = static_cast<const float*>(self->columns[column]) + entry_index;
+        return Vec3(x[0], x[self->max_entries], x[2 * self->max_entries]);
+    }
+
+    return static_cast<const Vec3*>(self->columns[column])[entry_index];
+}
+
+template <typename T>
+inline void store_value(Fact_Table* self, uint32_t column, uint32_t entry_index, const T& value)
+{
+    static_cast<T*>(self->columns[column])[entry_index] = value;
+}
+
+template <>
+inline void store_value<Vec3>(Fact_Table* self, uint32_t column, uint32_t entry_index, const Vec3& value)
+{
+    if (self->vec3_layout == Vec3_Layout_Planes)
+    {
+        float* x = static_cast<float*>(self->columns[column]) + entry_index;
+        x[0] = value.x;
+        x[self->max_entries] = value.y;
+        x[2 * self->max_entries] = value.z;
+        return;
+    }
+
+    static_cast<Vec3*>(self->columns[column])[entry_index] = value;
+}
+
+template <typename T>
+inline const T* get_column(const Fact_Table* self, uint32_t column)
+{
+    plnnr_assert(column < self->format.num_params);
+    plnnr_assert(get_type_size(self->format.types[column]) == sizeof(T));
+    return static_cast<const T*>(self->columns[column]);
+}
+
+inline Vec3_Column get_vec3_column(const Fact_Table* self, uint32_t column)
+{
+    plnnr_assert(column < self->format.num_params);
+    plnnr_assert(self->format.types[column] == Type_Vec3);
+    const float* x = static_cast<const float*>(self->columns[column]);
+
+    Vec3_Column result;
+
+    if (self->vec3_layout == Vec3_Layout_Planes)
+    {
+        result.x = x;
+        result.y = x + self->max_entries;
+        result.z = x + 2 * self->max_entries;
+        result.stride = 1;
+    }
+    else
+    {
+        result.x = x;
+        result.y = x + 1;
+        result.z = x + 2;
+        result.stride = 3;
+    }
+
+    return result;
+}
+
+inline const uint8_t* get_removed(const Fact_Table* self)
+{
+    return (self->num_removed > 0) ? self->removed : 0;
+}
+
+template <typename T>
+inline T load_row(const T* column, uint32_t entry_index)
+{
+    return column[entry_index];
+}
+
+inline Vec3 load_row(const Vec3_Column& column, uint32_t entry_index)
+{
+    const uint32_t offset = entry_index * column.stride;
+    return Vec3(column.x[offset], column.y[offset], column.z[offset]);
+}
+
 /// `as_<Type>` accessors for `Fact_Table` tuple data (stored in column-major order).
 
 // converts fact parameter with index arg_index, referenced by handle or entry index to a given type.
@@ -155,14 +740,12 @@ inline uint32_t get_type_alignment(Type t)
         plnnr_assert(entry_index < self->num_entries);                                                      \
         plnnr_assert(arg_index < self->format.num_params);                                                  \
         plnnr_assert(Type_##TYPE_TAG == self->format.types[arg_index]);                                     \
-        const TYPE_NAME* values = static_cast<const TYPE_NAME*>(self->columns[arg_index]);                  \
-        return values[entry_index];                                                                         \
+        return load_value<TYPE_NAME>(self, arg_index, entry_index);                                         \
     }                                                                                                       \
                                                                                                             \
     inline TYPE_NAME as_##TYPE_TAG(const Fact_Database& db, Fact_Handle handle, uint32_t arg_index)         \
     {                                                                                                       \
-        plnnr_assert(handle.table < db.num_tables);                                                         \
-        const Fact_Table* table = db.tables + handle.table;                                                 \
+        const Fact_Table* table = get_table(&db, handle);                                                   \
         return as_##TYPE_TAG(table, handle.entry, arg_index);                                               \
     }                                                                                                       \
                                                                                                             \
@@ -198,6 +781,37 @@ inline uint32_t get_type_alignment(Type t)
     #include "derplanner/runtime/type_tags.inl"
 #undef PLNNR_TYPE
 
+/// `hash_<Type>` functions to hash indexed columns.
+
+template <typename T>
+inline uint32_t hash_value(uint32_t hash, const T& value)
+{
+    return murmur2_32(&value, sizeof(T), hash);
+}
+
+// -0.0 and 0.0 are equal, so they must be hashed the same.
+inline uint32_t hash_value(uint32_t hash, float value)
+{
+    const float normalized = (value == 0.f) ? 0.f : value;
+    return murmur2_32(&normalized, sizeof(float), hash);
+}
+
+inline uint32_t hash_value(uint32_t hash, const Vec3& value)
+{
+    hash = hash_value(hash, value.x);
+    hash = hash_value(hash, value.y);
+    return hash_value(hash, value.z);
+}
+
+#define PLNNR_TYPE(TYPE_TAG, TYPE_NAME)                                 \
+    inline uint32_t hash_##TYPE_TAG(uint32_t hash, TYPE_NAME value)     \
+    {                                                                   \
+        return hash_value(hash, value);                                 \
+    }                                                                   \
+
+    #include "derplanner/runtime/type_tags.inl"
+#undef PLNNR_TYPE
+
 /// `set_arg` functions for Fact_Table tuple data. (column-major order).
 
     template <typename T>
@@ -213,8 +827,8 @@ inline uint32_t get_type_alignment(Type t)
         plnnr_assert(entry_index < self->num_entries);                                                                      \
         plnnr_assert(param_index < self->format.num_params);                                                                \
         plnnr_assert(Type_##TYPE_TAG == self->format.types[param_index]);                                                   \
-        TYPE_NAME* column = static_cast<TYPE_NAME*>(self->columns[param_index]);                                            \
-        column[entry_index] = value;                                                                                        \
+        copy_snapshot_columns(self);                                                                                        \
+        store_value(self, param_index, entry_index, value);                                                                 \
     }                                                                                                                       \
 
     #include "derplanner/runtime/type_tags.inl"
@@ -246,84 +860,319 @@ inline uint32_t get_type_alignment(Type t)
 
 /// Fact_Table
 
-inline void clear(Fact_Table* self)
+inline void copy_snapshot_columns(Fact_Table* self)
 {
-    self->num_entries = 0;
+    if (!self->blob && self->max_entries > 0)
+    {
+        set_max_entries(self, self->max_entries);
+    }
+}
+
+inline void reserve_snapshot(Fact_Table* self, uint32_t num_entries)
+{
+    if (!self->blob)
+    {
+        const uint32_t max_entries = num_entries > self->max_entries ? growth_double(self, num_entries) : self->max_entries;
+        set_max_entries(self, max_entries);
+    }
 }
 
 inline bool empty(const Fact_Table* self)
 {
-    return self->num_entries == 0;
+    return self->num_entries == self->num_removed;
 }
 
+inline bool is_removed(const Fact_Table* self, uint32_t entry_index)
+{
+    plnnr_assert(entry_index < self->num_entries);
+    return self->num_removed > 0 && self->removed[entry_index] != 0;
+}
+
+template <typename T>
+inline void update_arg(Fact_Table* self, uint32_t entry_index, uint32_t param_index, const T& value)
+{
+    plnnr_assert(!is_removed(self, entry_index));
+    const bool has_indexes = self->num_indexes > 0 || self->num_ordered_indexes > 0;
+
+    // indexes are rebuilt by the copy, so it's done before the entry is unlinked.
+    copy_snapshot_columns(self);
+
+    if (has_indexes)
+    {
+        unlink_indexes(self, entry_index, param_index);
+    }
+
+    set_arg(self, entry_index, param_index, value);
+
+    if (has_indexes)
+    {
+        link_indexes(self, entry_index, param_index);
+    }
+
+    update_stats(self, entry_index, 1);
+}
+
+/// `find_entry` helpers, keys must have the exact types of the index columns (checked by `as_<Type>` accessors).
+
+template <typename T>
+inline uint32_t hash_key(uint32_t, const T&)
+{
+    plnnr_assert(false);
+    return 0;
+}
+
+template <typename T>
+inline bool key_value_equal(const T& a, const T& b)
+{
+    return a == b;
+}
+
+inline bool key_value_equal(const Vec3& a, const Vec3& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+template <typename T>
+inline bool key_equal(const Fact_Table*, uint32_t, uint8_t, const T&)
+{
+    plnnr_assert(false);
+    return false;
+}
+
+#define PLNNR_TYPE(TYPE_TAG, TYPE_NAME)                                                                                 \
+    template <>                                                                                                         \
+    inline uint32_t hash_key<TYPE_NAME>(uint32_t hash, const TYPE_NAME& value)                                          \
+    {                                                                                                                   \
+        return hash_##TYPE_TAG(hash, value);                                                                            \
+    }                                                                                                                   \
+                                                                                                                        \
+    template <>                                                                                                         \
+    inline bool key_equal<TYPE_NAME>(const Fact_Table* self, uint32_t entry, uint8_t column, const TYPE_NAME& value)    \
+    {                                                                                                                   \
+        return key_value_equal(as_##TYPE_TAG(self, entry, column), value);                                              \
+    }                                                                                                                   \
+
+    #include "derplanner/runtime/type_tags.inl"
+#undef PLNNR_TYPE
+
 template <typename T0>
-inline void add_entry(Fact_Table* self, const T0& a0)
+inline uint32_t find_entry(const Fact_Table* self, uint32_t index, const T0& k0)
+{
+    plnnr_assert(index < self->num_indexes);
+    const Fact_Index* fact_index = self->indexes + index;
+    const uint8_t* columns = fact_index->format.columns;
+    plnnr_assert(fact_index->format.num_columns == 1);
+
+    uint32_t hash = hash_key(0, k0);
+
+    for (uint32_t entry = first_in_chain(fact_index, hash); entry != Fact_Index_End; entry = next_in_chain(self, fact_index, entry))
+    {
+        if (key_equal(self, entry, columns[0], k0))
+        {
+            return entry;
+        }
+    }
+
+    return Fact_Index_End;
+}
+
+template <typename T0, typename T1>
+inline uint32_t find_entry(const Fact_Table* self, uint32_t index, const T0& k0, const T1& k1)
 {
+    plnnr_assert(index < self->num_indexes);
+    const Fact_Index* fact_index = self->indexes + index;
+    const uint8_t* columns = fact_index->format.columns;
+    plnnr_assert(fact_index->format.num_columns == 2);
+
+    uint32_t hash = hash_key(0, k0);
+    hash = hash_key(hash, k1);
+
+    for (uint32_t entry = first_in_chain(fact_index, hash); entry != Fact_Index_End; entry = next_in_chain(self, fact_index, entry))
+    {
+        if (key_equal(self, entry, columns[0], k0) && key_equal(self, entry, columns[1], k1))
+        {
+            return entry;
+        }
+    }
+
+    return Fact_Index_End;
+}
+
+template <typename T0, typename T1, typename T2>
+inline uint32_t find_entry(const Fact_Table* self, uint32_t index, const T0& k0, const T1& k1, const T2& k2)
+{
+    plnnr_assert(index < self->num_indexes);
+    const Fact_Index* fact_index = self->indexes + index;
+    const uint8_t* columns = fact_index->format.columns;
+    plnnr_assert(fact_index->format.num_columns == 3);
+
+    uint32_t hash = hash_key(0, k0);
+    hash = hash_key(hash, k1);
+    hash = hash_key(hash, k2);
+
+    for (uint32_t entry = first_in_chain(fact_index, hash); entry != Fact_Index_End; entry = next_in_chain(self, fact_index, entry))
+    {
+        if (key_equal(self, entry, columns[0], k0) && key_equal(self, entry, columns[1], k1) && key_equal(self, entry, columns[2], k2))
+        {
+            return entry;
+        }
+    }
+
+    return Fact_Index_End;
+}
+
+template <typename T0, typename T1, typename T2, typename T3>
+inline uint32_t find_entry(const Fact_Table* self, uint32_t index, const T0& k0, const T1& k1, const T2& k2, const T3& k3)
+{
+    plnnr_assert(index < self->num_indexes);
+    const Fact_Index* fact_index = self->indexes + index;
+    const uint8_t* columns = fact_index->format.columns;
+    plnnr_assert(fact_index->format.num_columns == 4);
+
+    uint32_t hash = hash_key(0, k0);
+    hash = hash_key(hash, k1);
+    hash = hash_key(hash, k2);
+    hash = hash_key(hash, k3);
+
+    for (uint32_t entry = first_in_chain(fact_index, hash); entry != Fact_Index_End; entry = next_in_chain(self, fact_index, entry))
+    {
+        if (key_equal(self, entry, columns[0], k0) && key_equal(self, entry, columns[1], k1) &&
+            key_equal(self, entry, columns[2], k2) && key_equal(self, entry, columns[3], k3))
+        {
+            return entry;
+        }
+    }
+
+    return Fact_Index_End;
+}
+
+// appends an uninitialized entry, growing the table if needed.
+inline uint32_t push_entry(Fact_Table* self)
+{
+    // snapshot tables are full, they're copied with room to append regardless of the growth policy.
+    if (!self->blob)
+    {
+        reserve_snapshot(self, self->num_entries + 1);
+    }
+    else if (self->num_entries == self->max_entries && self->growth)
+    {
+        reserve(self, self->num_entries + 1);
+    }
+
     uint32_t entry = self->num_entries++;
     plnnr_assert(entry < self->max_entries);
+
+    if (self->num_entries > self->high_water_mark)
+    {
+        self->high_water_mark = self->num_entries;
+    }
+
+    return entry;
+}
+
+template <typename T0>
+inline void add_entry(Fact_Table* self, const T0& a0)
+{
+    uint32_t entry = push_entry(self);
     set_arg(self, entry, 0, a0);
+
+    if (self->num_indexes > 0 || self->num_ordered_indexes > 0)
+    {
+        update_indexes(self, entry);
+    }
+
+    update_stats(self, entry, 1);
 }
 
 template <typename T0, typename T1>
 inline void add_entry(Fact_Table* self, const T0& a0, const T1& a1)
 {
-    uint32_t entry = self->num_entries++;
-    plnnr_assert(entry < self->max_entries);
+    uint32_t entry = push_entry(self);
     set_arg(self, entry, 0, a0);
     set_arg(self, entry, 1, a1);
+
+    if (self->num_indexes > 0 || self->num_ordered_indexes > 0)
+    {
+        update_indexes(self, entry);
+    }
+
+    update_stats(self, entry, 1);
 }
 
 template <typename T0, typename T1, typename T2>
 inline void add_entry(Fact_Table* self, const T0& a0, const T1& a1, const T2& a2)
 {
-    uint32_t entry = self->num_entries++;
-    plnnr_assert(entry < self->max_entries);
+    uint32_t entry = push_entry(self);
     set_arg(self, entry, 0, a0);
     set_arg(self, entry, 1, a1);
     set_arg(self, entry, 2, a2);
+
+    if (self->num_indexes > 0 || self->num_ordered_indexes > 0)
+    {
+        update_indexes(self, entry);
+    }
+
+    update_stats(self, entry, 1);
 }
 
 template <typename T0, typename T1, typename T2, typename T3>
 inline void add_entry(Fact_Table* self, const T0& a0, const T1& a1, const T2& a2, const T3& a3)
 {
-    uint32_t entry = self->num_entries++;
-    plnnr_assert(entry < self->max_entries);
+    uint32_t entry = push_entry(self);
     set_arg(self, entry, 0, a0);
     set_arg(self, entry, 1, a1);
     set_arg(self, entry, 2, a2);
     set_arg(self, entry, 3, a3);
+
+    if (self->num_indexes > 0 || self->num_ordered_indexes > 0)
+    {
+        update_indexes(self, entry);
+    }
+
+    update_stats(self, entry, 1);
 }
 
 template <typename T0, typename T1, typename T2, typename T3, typename T4>
 inline void add_entry(Fact_Table* self, const T0& a0, const T1& a1, const T2& a2, const T3& a3, const T4& a4)
 {
-    uint32_t entry = self->num_entries++;
-    plnnr_assert(entry < self->max_entries);
+    uint32_t entry = push_entry(self);
     set_arg(self, entry, 0, a0);
     set_arg(self, entry, 1, a1);
     set_arg(self, entry, 2, a2);
     set_arg(self, entry, 3, a3);
     set_arg(self, entry, 4, a4);
+
+    if (self->num_indexes > 0 || self->num_ordered_indexes > 0)
+    {
+        update_indexes(self, entry);
+    }
+
+    update_stats(self, entry, 1);
 }
 
 template <typename T0, typename T1, typename T2, typename T3, typename T4, typename T5>
 inline void add_entry(Fact_Table* self, const T0& a0, const T1& a1, const T2& a2, const T3& a3, const T4& a4, const T5& a5)
 {
-    uint32_t entry = self->num_entries++;
-    plnnr_assert(entry < self->max_entries);
+    uint32_t entry = push_entry(self);
     set_arg(self, entry, 0, a0);
     set_arg(self, entry, 1, a1);
     set_arg(self, entry, 2, a2);
     set_arg(self, entry, 3, a3);
     set_arg(self, entry, 4, a4);
     set_arg(self, entry, 5, a5);
+
+    if (self->num_indexes > 0 || self->num_ordered_indexes > 0)
+    {
+        update_indexes(self, entry);
+    }
+
+    update_stats(self, entry, 1);
 }
 
 template <typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
 inline void add_entry(Fact_Table* self, const T0& a0, const T1& a1, const T2& a2, const T3& a3, const T4& a4, const T5& a5, const T6& a6)
 {
-    uint32_t entry = self->num_entries++;
-    plnnr_assert(entry < self->max_entries);
+    uint32_t entry = push_entry(self);
     set_arg(self, entry, 0, a0);
     set_arg(self, entry, 1, a1);
     set_arg(self, entry, 2, a2);
@@ -331,13 +1180,19 @@ inline void add_entry(Fact_Table* self, const T0& a0, const T1& a1, const T2& a2
     set_arg(self, entry, 4, a4);
     set_arg(self, entry, 5, a5);
     set_arg(self, entry, 6, a6);
+
+    if (self->num_indexes > 0 || self->num_ordered_indexes > 0)
+    {
+        update_indexes(self, entry);
+    }
+
+    update_stats(self, entry, 1);
 }
 
 template <typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
 inline void add_entry(Fact_Table* self, const T0& a0, const T1& a1, const T2& a2, const T3& a3, const T4& a4, const T5& a5, const T6& a6, const T7& a7)
 {
-    uint32_t entry = self->num_entries++;
-    plnnr_assert(entry < self->max_entries);
+    uint32_t entry = push_entry(self);
     set_arg(self, entry, 0, a0);
     set_arg(self, entry, 1, a1);
     set_arg(self, entry, 2, a2);
@@ -346,6 +1201,13 @@ inline void add_entry(Fact_Table* self, const T0& a0, const T1& a1, const T2& a2
     set_arg(self, entry, 5, a5);
     set_arg(self, entry, 6, a6);
     set_arg(self, entry, 7, a7);
+
+    if (self->num_indexes > 0 || self->num_ordered_indexes > 0)
+    {
+        update_indexes(self, entry);
+    }
+
+    update_stats(self, entry, 1);
 }
 
 }
@@ -23,7 +23,7 @@
 
 /// Inline functions & macros used in auto-generated domain code.
 
-#include <algorithm>    // std::sort
+#include <algorithm>    // std::make_heap, std::pop_heap
 #include <string.h>     // memset
 
 #include "derplanner/runtime/memory.h"
@@ -43,6 +43,12 @@ namespace plnnr {
 // initializes `layout` offsets and a total size, run as part of domain initialization.
 void compute_offsets_and_size(Param_Layout* layout);
 
+// fills `Task_Info::frame_costs`, task parameter & binding layouts must be computed first.
+void compute_frame_costs(Domain_Info* domain);
+
+// the most bytes `allocate_with_layout` may take from the blob, including the alignment padding.
+uint32_t layout_cost(const Param_Layout* layout);
+
 // allocates memory from the `blob`, by bumping the `blob->top` pointer.
 uint8_t* allocate_with_layout(Blob* blob, const Param_Layout* layout);
 
@@ -53,13 +59,23 @@ inline void revert(Blob* blob, void* new_top);
 // allocates `Fact_Handle` from the expansion blob.
 void allocate_precond_handles(Planning_State* state, Expansion_Frame* frame, uint32_t num_handles);
 
+// block mask of a row filter (see `first_filtered`), kept in the handle slot `index` which is never accessed as a `Fact_Handle`.
+uint64_t& row_mask(Fact_Handle* handles, uint32_t index);
+
 // allocates memory from the expansion blob, to store precondidition output (bindings).
+// may grow the expansion blob (see `set_growth`), so pointers to the frame data must be reloaded afterwards.
 void* allocate_precond_bindings(Planning_State* state, const Param_Layout* output_layout);
 
 // allocates memory from the expansion blob, to store precondidition output (bindings).
 void allocate_precond_bindings(Planning_State* state, Expansion_Frame* frame, const Param_Layout* output_layout);
 
 
+// removes duplicate `frame` bindings keeping the first occurrences in order, updates `frame->num_bindings`.
+// `Distinct` provides `hash` and `equal` for the binding struct, the hash set is allocated on top of the expansion blob and released before returning.
+// may grow the expansion blob, so pointers to the frame data must be reloaded afterwards.
+template <typename T, typename Distinct>
+void remove_duplicates(Planning_State* state, Expansion_Frame* frame, const Distinct& distinct);
+
 // initializes and pushes an `Expansion_Frame` for the compound task with id `task_id`.
 void begin_compound(Planning_State* state, const Domain_Info* domain, uint32_t task_id);
 
@@ -67,7 +83,10 @@ void begin_compound(Planning_State* state, const Domain_Info* domain, uint32_t t
 void begin_task(Planning_State* state, const Domain_Info* domain, uint32_t task_id);
 
 // rewinds a failed case expansion data and runs `expand` for the next case.
-bool expand_next_case(Planning_State* state, const Domain_Info* domain, uint32_t task_id, Expansion_Frame* frame, Fact_Database* db, Compound_Task_Expand* expand);
+bool expand_next_case(Planning_State* state, const Domain_Info* domain, uint32_t task_id, Expansion_Frame* frame, const Fact_Database* db, Compound_Task_Expand* expand);
+
+// returns the speculation result on the first call after `apply_speculation`, otherwise calls `precond`.
+bool speculated_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db, Case_Precondition* precond);
 
 // updates rewinding info after each iteration of `each` case.
 void continue_iteration(const Planning_State* state, Expansion_Frame* frame);
@@ -80,8 +99,17 @@ void set_compound_arg(Planning_State* state, const Param_Layout* layout, uint32_
 template <typename T>
 void set_task_arg(Planning_State* state, const Param_Layout* layout, uint32_t param_index, const T& value);
 
-// helper for generated code to map domain table index to a database table index.
-uint32_t tbl(const Planning_State* state, uint32_t domain_table_idx);
+// maps domain table indices to database table indices in the generated preconditions, which are instantiated for both bindings.
+// `Identity_Binding` is used when `bind` finds the database created from the domain's `database_req`, so table indices are constants.
+struct Identity_Binding
+{
+    static uint32_t tbl(const Planning_State* state, uint32_t domain_table_idx);
+};
+
+struct Mapped_Binding
+{
+    static uint32_t tbl(const Planning_State* state, uint32_t domain_table_idx);
+};
 
 }
 
@@ -123,6 +151,36 @@ inline void plnnr::compute_offsets_and_size(plnnr::Param_Layout* layout)
     layout->size = offset;
 }
 
+inline uint32_t plnnr::layout_cost(const plnnr::Param_Layout* layout)
+{
+    return layout->size ? (uint32_t)(layout->size + layout->alignment) : 0;
+}
+
+inline void plnnr::compute_frame_costs(plnnr::Domain_Info* domain)
+{
+    plnnr::Task_Info& info = domain->task_info;
+
+    for (uint32_t task_id = 0; task_id < info.num_tasks; ++task_id)
+    {
+        const uint32_t params_cost = layout_cost(&info.parameters[task_id]);
+        info.frame_costs[task_id] = params_cost;
+
+        if (task_id < info.num_primitive)
+            continue;
+
+        const uint32_t compound_id = task_id - info.num_primitive;
+        for (uint32_t case_idx = 0; case_idx < info.num_cases[compound_id]; ++case_idx)
+        {
+            const uint32_t global_case_index = info.first_case[compound_id] + case_idx;
+            const uint32_t num_handles = info.num_case_handles[global_case_index];
+            const uint32_t handles_cost = num_handles ? (uint32_t)(sizeof(Fact_Handle) * num_handles + plnnr_alignof(uint64_t)) : 0;
+            const uint32_t cost = params_cost + handles_cost + layout_cost(&info.bindings[global_case_index]);
+
+            info.frame_costs[task_id] = (cost > info.frame_costs[task_id]) ? cost : info.frame_costs[task_id];
+        }
+    }
+}
+
 inline uint8_t* plnnr::allocate_with_layout(plnnr::Blob* blob, const plnnr::Param_Layout* layout)
 {
     if (!layout->size)
@@ -148,16 +206,26 @@ inline void plnnr::allocate_precond_handles(plnnr::Planning_State* state, plnnr:
     if (!num_handles)
         return;
 
+    // handle slots are aligned for the row masks.
     plnnr::Blob* blob = &state->expansion_blob;
-    uint8_t* bytes = blob->top;
-    blob->top = (uint8_t*)align(blob->top, plnnr_alignof(Fact_Handle)) + sizeof(Fact_Handle) * num_handles;
+    uint8_t* bytes = (uint8_t*)align(blob->top, plnnr_alignof(uint64_t));
+    blob->top = bytes + sizeof(Fact_Handle) * num_handles;
     plnnr_assert((uint32_t)(blob->top - blob->base) <= blob->max_size);
     frame->handles = reinterpret_cast<Fact_Handle*>(bytes);
     frame->num_handles = (uint16_t)(num_handles);
 }
 
+inline uint64_t& plnnr::row_mask(plnnr::Fact_Handle* handles, uint32_t index)
+{
+    plnnr_assert(sizeof(Fact_Handle) == sizeof(uint64_t));
+    return *reinterpret_cast<uint64_t*>(handles + index);
+}
+
 inline void* plnnr::allocate_precond_bindings(plnnr::Planning_State* state, const plnnr::Param_Layout* output_type)
 {
+    if (state->growth)
+        reserve_expansion_data(state, layout_cost(output_type));
+
     plnnr::Blob* blob = &state->expansion_blob;
     uint8_t* bytes = allocate_with_layout(blob, output_type);
     return bytes;
@@ -165,7 +233,61 @@ inline void* plnnr::allocate_precond_bindings(plnnr::Planning_State* state, cons
 
 inline void plnnr::allocate_precond_bindings(plnnr::Planning_State* state, plnnr::Expansion_Frame* frame, const plnnr::Param_Layout* output_type)
 {
-    frame->bindings = allocate_precond_bindings(state, output_type);
+    // space for the frame data is reserved before the planning step.
+    frame->bindings = allocate_with_layout(&state->expansion_blob, output_type);
+}
+
+template <typename T, typename Distinct>
+inline void plnnr::remove_duplicates(plnnr::Planning_State* state, plnnr::Expansion_Frame* frame, const Distinct& distinct)
+{
+    const uint32_t num_bindings = frame->num_bindings;
+    if (num_bindings < 2)
+        return;
+
+    // open addressing set of binding indices, at most half full.
+    uint32_t num_slots = 1;
+    while (num_slots < num_bindings * 2) { num_slots <<= 1; }
+
+    if (state->growth)
+        reserve_expansion_data(state, (uint32_t)(sizeof(uint32_t) * (num_slots + 1)));
+
+    plnnr::Blob* blob = &state->expansion_blob;
+    T* bindings = (T*)(frame->bindings);
+
+    const uint32_t mask = num_slots - 1;
+    const uint32_t empty = 0xffffffff;
+
+    uint32_t* slots = (uint32_t*)(align(blob->top, plnnr_alignof(uint32_t)));
+    blob->top = (uint8_t*)(slots + num_slots);
+    plnnr_assert((uint32_t)(blob->top - blob->base) <= blob->max_size);
+    memset(slots, 0xff, sizeof(uint32_t) * num_slots);
+
+    uint32_t num_unique = 0;
+    for (uint32_t binding_idx = 0; binding_idx < num_bindings; ++binding_idx)
+    {
+        const T& binding = bindings[binding_idx];
+        uint32_t slot = distinct.hash(binding) & mask;
+        bool duplicate = false;
+
+        for (; slots[slot] != empty; slot = (slot + 1) & mask)
+        {
+            if (distinct.equal(bindings[slots[slot]], binding))
+            {
+                duplicate = true;
+                break;
+            }
+        }
+
+        if (duplicate)
+            continue;
+
+        // unique bindings are compacted in place, `num_unique` <= `binding_idx`.
+        bindings[num_unique] = binding;
+        slots[slot] = num_unique++;
+    }
+
+    revert(blob, bindings + num_unique);
+    frame->num_bindings = num_unique;
 }
 
 inline void plnnr::begin_compound(plnnr::Planning_State* state, const plnnr::Domain_Info* domain, uint32_t task_id)
@@ -197,7 +319,7 @@ inline void plnnr::begin_compound(plnnr::Planning_State* state, const plnnr::Dom
 }
 
 inline bool plnnr::expand_next_case(plnnr::Planning_State* state, const plnnr::Domain_Info* domain, uint32_t task_id,
-                                    plnnr::Expansion_Frame* frame, plnnr::Fact_Database* db, plnnr::Compound_Task_Expand* expand)
+                                    plnnr::Expansion_Frame* frame, const plnnr::Fact_Database* db, plnnr::Compound_Task_Expand* expand)
 {
     const uint32_t num_primitive = domain->task_info.num_primitive;
     const Param_Layout* param_layout = &domain->task_info.parameters[task_id];
@@ -224,10 +346,27 @@ inline bool plnnr::expand_next_case(plnnr::Planning_State* state, const plnnr::D
     allocate_precond_handles(state, frame, num_handles);
     allocate_precond_bindings(state, frame, precond_output_layout);
 
+    if (state->speculation && domain->task_info.parallel[task_id - num_primitive])
+        state->speculation->apply(state, domain, task_id, frame, db);
+
     // then try the new expansion.
     return frame->expand(state, frame, db);
 }
 
+inline bool plnnr::speculated_next(plnnr::Planning_State* state, plnnr::Expansion_Frame* frame, const plnnr::Fact_Database* db, plnnr::Case_Precondition* precond)
+{
+    const uint32_t result = frame->speculation;
+    frame->speculation = plnnr::Speculation_None;
+
+    if (result == plnnr::Speculation_Found)
+        return true;
+
+    if (result == plnnr::Speculation_Empty)
+        return false;
+
+    return precond(state, frame, db);
+}
+
 inline void plnnr::begin_task(plnnr::Planning_State* state, const plnnr::Domain_Info* domain, uint32_t task_id)
 {
     plnnr_assert(task_id < domain->task_info.num_tasks);
@@ -266,7 +405,12 @@ inline void plnnr::set_task_arg(plnnr::Planning_State* state, const plnnr::Param
     set_arg(frame->arguments, layout, param_index, value);
 }
 
-inline uint32_t plnnr::tbl(const plnnr::Planning_State* state, uint32_t domain_table_idx)
+inline uint32_t plnnr::Identity_Binding::tbl(const plnnr::Planning_State*, uint32_t domain_table_idx)
+{
+    return domain_table_idx;
+}
+
+inline uint32_t plnnr::Mapped_Binding::tbl(const plnnr::Planning_State* state, uint32_t domain_table_idx)
 {
     return state->table_indices[domain_table_idx];
 }
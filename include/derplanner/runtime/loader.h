@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2015 Alexander Shafranov shafranov@gmail.com
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software. If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+
+#ifndef DERPLANNER_RUNTIME_LOADER_H_
+#define DERPLANNER_RUNTIME_LOADER_H_
+
+#include "derplanner/runtime/memory.h"
+#include "derplanner/runtime/types.h"
+
+namespace plnnr {
+
+// Streaming loader of the textual facts, one fact per line:
+//
+//   airport(SPB, LED)
+//   distance(SPB, LED, 6.5)
+//
+// Empty lines and lines starting with `//` or `#` are skipped.
+// Integer columns accept integer literals, float columns accept integer and float literals,
+// id columns accept integer literals and symbols (`:name` from the domain `Symbol_Table` or names resolved by `Fact_Loader_Resolve`).
+
+enum { Max_Fact_Line_Length = 1024 };
+
+enum Fact_Loader_Error
+{
+    Fact_Loader_Ok = 0,
+    // malformed line.
+    Fact_Loader_Syntax_Error,
+    // fact name is not in the database.
+    Fact_Loader_Unknown_Fact,
+    // symbol can't be resolved.
+    Fact_Loader_Unknown_Symbol,
+    // number of arguments doesn't match the fact arity.
+    Fact_Loader_Arity_Mismatch,
+    // argument literal doesn't match the column type.
+    Fact_Loader_Type_Mismatch,
+    // fixed size table is full.
+    Fact_Loader_Table_Full,
+    // line is longer than `Max_Fact_Line_Length`.
+    Fact_Loader_Line_Too_Long,
+};
+
+// resolves symbol name (not null terminated) to id, returns false if name is unknown.
+typedef bool Fact_Loader_Resolve(void* user_data, const char* name, uint32_t length, uint64_t* id);
+
+// Rows parsed for a single table, added to the table when the batch is full.
+struct Fact_Loader_Batch
+{
+    // row-major layout of the fact tuple.
+    Param_Layout    layout;
+    // offsets storage for `layout`.
+    size_t          offsets[Max_Fact_Arity];
+    // distance in bytes between rows.
+    size_t          stride;
+    // rows data, allocated on the first fact of the table.
+    uint8_t*        rows;
+    // number of rows parsed.
+    uint32_t        count;
+};
+
+struct Fact_Loader
+{
+    // database facts are added to.
+    Fact_Database*          db;
+    // domain symbols, optional.
+    const Symbol_Table*     symbols;
+    // open addressing map from symbol hash to symbol index.
+    uint32_t*               symbol_lookup;
+    // number of `symbol_lookup` slots minus one, the number of slots is a power of two.
+    uint32_t                symbol_lookup_mask;
+    // resolves names which are not domain symbols, optional.
+    Fact_Loader_Resolve*    resolve;
+    // `resolve` user data.
+    void*                   user_data;
+    // maximum number of rows in the batch.
+    uint32_t                batch_size;
+    // batch for each database table.
+    Fact_Loader_Batch*      batches;
+    // incomplete line left from the previous chunk.
+    char                    line[Max_Fact_Line_Length + 1];
+    // length of the incomplete line.
+    uint32_t                line_length;
+    // number of lines processed.
+    uint32_t                line_number;
+    // first error, loading stops on error.
+    Fact_Loader_Error       error;
+    // allocator.
+    Memory*                 memory;
+};
+
+// prepares loader to add facts to `db`, memory used doesn't depend on the amount of loaded facts.
+void init(Fact_Loader* self, Memory* mem, Fact_Database* db, const Symbol_Table* symbols, uint32_t batch_size);
+void destroy(Fact_Loader* self);
+
+// sets resolver for the names which are not domain symbols.
+void set_resolve(Fact_Loader* self, Fact_Loader_Resolve* resolve, void* user_data);
+
+// parses the next chunk of text, lines may span across chunks. returns false on error.
+bool load_facts(Fact_Loader* self, const char* text, size_t length);
+
+// parses the last line and adds all batched rows to the database. returns false on error.
+bool flush(Fact_Loader* self);
+
+}
+
+#endif
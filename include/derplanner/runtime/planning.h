@@ -42,10 +42,28 @@ struct Planning_State_Config
     uint32_t    plan_data_size;
 };
 
+// computes the smallest config fitting `max_depth` expansions and `max_plan_length` tasks of `domain`,
+// including the bindings `:sorted` & `:distinct` cases collect for the current table sizes of `db`.
+// returns false if the stacks don't fit 32-bit sizes, `config` is left unchanged then.
+bool compute_config(Planning_State_Config* config, const Domain_Info* domain, const Fact_Database* db, uint32_t max_depth, uint32_t max_plan_length);
+
 void init(Planning_State* self, Memory* mem, const Planning_State_Config* config);
 void destroy(Planning_State* self);
 
+// enables growing stacks & blobs through the state's `Memory`, so the config sizes become initial sizes rather than the worst case.
+// growth happens between `find_plan_step` calls (generated code keeps pointers to frames and blob data during a step),
+// except for the precondition bindings, which may grow the expansion blob at any time (see `reserve_expansion_data`).
+// with growth enabled `max_depth` & `max_plan_length` replace the config values as the limits for
+// `Find_Plan_Max_Depth_Exceeded` and `Find_Plan_Max_Plan_Length_Exceeded`.
+void set_growth(Planning_State* self, bool enabled, uint32_t max_depth, uint32_t max_plan_length);
+
+// makes sure there's at least `size` bytes free in the expansion blob, growing it if growth is enabled.
+// frames are re-based to the new blob, any other pointers to the blob data must be reloaded from the frames.
+void reserve_expansion_data(Planning_State* self, uint32_t size);
+
 // builds index map for tables required by this domain to an actual `Fact_Database`.
+// binding is an identity map, if the database was created from the domain's `database_req`.
+// fails if a table is missing or doesn't have the domain's indexes (in the declaration order), extra indexes may follow them.
 bool bind(Planning_State* self, const Domain_Info* domain, const Fact_Database* db);
 
 /// Iterative planning interface.
@@ -62,15 +80,36 @@ enum Find_Plan_Status
     Find_Plan_Max_Depth_Exceeded = 3,
     // `find_plan_step` exits with `Find_Plan_Max_Plan_Length_Exceeded` when there's no space left in the task stack.
     Find_Plan_Max_Plan_Length_Exceeded = 4,
+    // `find_plan_run` exits with `Find_Plan_Cancelled` when the budget's cancel flag is set, planning can be resumed.
+    Find_Plan_Cancelled = 5,
+};
+
+// Limits of a single `find_plan_run` call, zero means no limit. limits are checked between steps, so a step is never interrupted.
+struct Find_Plan_Budget
+{
+    // maximum number of `find_plan_step` calls.
+    uint32_t        max_steps;
+    // maximum number of precondition iterations (generated precondition iterator calls).
+    uint32_t        max_precond_iterations;
+    // maximum wall-clock time in nanoseconds.
+    uint64_t        max_nanoseconds;
+    // cooperative cancellation, planning stops when the flag is set, optional.
+    volatile bool*  cancel;
 };
 
 // pushes the first compound task on the expansion stack.
 void                find_plan_init(Planning_State* self, const Domain_Info* domain);
+// pushes the compound task `root_task_id` (without parameters) on the expansion stack.
+void                find_plan_init(Planning_State* self, const Domain_Info* domain, uint32_t root_task_id);
 // executes one step of the planning loop.
-Find_Plan_Status    find_plan_step(Planning_State* self, Fact_Database* db);
+Find_Plan_Status    find_plan_step(Planning_State* self, const Fact_Database* db);
+
+// executes `find_plan_step` until the plan is found or failed, or until the `budget` is exhausted, which returns `Find_Plan_In_Progress`.
+// the state is resumable by the next `find_plan_run` or `find_plan_step` call, `find_plan_init` must be called before the first one.
+Find_Plan_Status    find_plan_run(Planning_State* self, const Fact_Database* db, const Find_Plan_Budget* budget);
 
 // runs the full planning loop (executes `find_plan_step` until status other than `Find_Plan_In_Progress` is returned).
-Find_Plan_Status    find_plan(Planning_State* self, Fact_Database* db, const Domain_Info* domain);
+Find_Plan_Status    find_plan(Planning_State* self, const Fact_Database* db, const Domain_Info* domain);
 
 // resulting plan.
 Plan get_plan(const Planning_State* self);
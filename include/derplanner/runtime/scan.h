@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2015 Alexander Shafranov shafranov@gmail.com
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software. If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+
+
+#ifndef DERPLANNER_RUNTIME_SCAN_H_
+#define DERPLANNER_RUNTIME_SCAN_H_
+
+#include "derplanner/runtime/base.h"
+
+// Column scan kernels: find the first value equal to the key in [begin, end) of a column.
+// Row filters generated for preconditions produce 64-bit match masks, scanned with `lowest_bit`.
+// Instruction set is selected at compile time, define PLNNR_SCAN_SCALAR to force the scalar fallback.
+
+#if !defined(PLNNR_SCAN_SCALAR)
+    #if defined(__AVX2__)
+        #define PLNNR_SCAN_AVX2
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define PLNNR_SCAN_SSE2
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define PLNNR_SCAN_NEON
+    #endif
+#endif
+
+#if defined(PLNNR_SCAN_AVX2)
+    #include <immintrin.h>
+#elif defined(PLNNR_SCAN_SSE2)
+    #include <emmintrin.h>
+#elif defined(PLNNR_SCAN_NEON)
+    #include <arm_neon.h>
+#endif
+
+#if defined(PLNNR_MSVC_VERSION)
+    #include <intrin.h>
+#endif
+
+namespace plnnr {
+
+// index of the lowest set bit, `mask` is non-zero.
+inline uint32_t lowest_bit(uint32_t mask)
+{
+#if defined(PLNNR_MSVC_VERSION)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return uint32_t(index);
+#else
+    return uint32_t(__builtin_ctz(mask));
+#endif
+}
+
+inline uint32_t lowest_bit(uint64_t mask)
+{
+    const uint32_t low = uint32_t(mask);
+    return low != 0 ? lowest_bit(low) : 32 + lowest_bit(uint32_t(mask >> 32));
+}
+
+#if defined(PLNNR_SCAN_NEON)
+// true if any lane of the comparison result is set.
+inline bool any_lane(uint8x16_t eq)
+{
+    uint64x2_t lanes = vreinterpretq_u64_u8(eq);
+    return (vgetq_lane_u64(lanes, 0) | vgetq_lane_u64(lanes, 1)) != 0;
+}
+#endif
+
+// vector loops stop at the block with a match, NEON has no cheap movemask, so the block is rescanned by the scalar loop.
+
+inline uint32_t find_equal(const uint8_t* column, uint32_t begin, uint32_t end, uint8_t value)
+{
+    uint32_t i = begin;
+
+#if defined(PLNNR_SCAN_AVX2)
+    const __m256i key = _mm256_set1_epi8(char(value));
+    for (; i + 32 <= end; i += 32)
+    {
+        const __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(column + i)), key);
+        const uint32_t mask = uint32_t(_mm256_movemask_epi8(eq));
+        if (mask)
+            return i + lowest_bit(mask);
+    }
+#elif defined(PLNNR_SCAN_SSE2)
+    const __m128i key = _mm_set1_epi8(char(value));
+    for (; i + 16 <= end; i += 16)
+    {
+        const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(column + i)), key);
+        const uint32_t mask = uint32_t(_mm_movemask_epi8(eq));
+        if (mask)
+            return i + lowest_bit(mask);
+    }
+#elif defined(PLNNR_SCAN_NEON)
+    const uint8x16_t key = vdupq_n_u8(value);
+    for (; i + 16 <= end; i += 16)
+    {
+        if (any_lane(vceqq_u8(vld1q_u8(column + i), key)))
+            break;
+    }
+#endif
+
+    for (; i < end; ++i)
+    {
+        if (column[i] == value)
+            return i;
+    }
+
+    return end;
+}
+
+inline uint32_t find_equal(const uint32_t* column, uint32_t begin, uint32_t end, uint32_t value)
+{
+    uint32_t i = begin;
+
+#if defined(PLNNR_SCAN_AVX2)
+    const __m256i key = _mm256_set1_epi32(int(value));
+    for (; i + 8 <= end; i += 8)
+    {
+        const __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(column + i)), key);
+        const uint32_t mask = uint32_t(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+        if (mask)
+            return i + lowest_bit(mask);
+    }
+#elif defined(PLNNR_SCAN_SSE2)
+    const __m128i key = _mm_set1_epi32(int(value));
+    for (; i + 4 <= end; i += 4)
+    {
+        const __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(column + i)), key);
+        const uint32_t mask = uint32_t(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+        if (mask)
+            return i + lowest_bit(mask);
+    }
+#elif defined(PLNNR_SCAN_NEON)
+    const uint32x4_t key = vdupq_n_u32(value);
+    for (; i + 4 <= end; i += 4)
+    {
+        if (any_lane(vreinterpretq_u8_u32(vceqq_u32(vld1q_u32(column + i), key))))
+            break;
+    }
+#endif
+
+    for (; i < end; ++i)
+    {
+        if (column[i] == value)
+            return i;
+    }
+
+    return end;
+}
+
+inline uint32_t find_equal(const uint64_t* column, uint32_t begin, uint32_t end, uint64_t value)
+{
+    uint32_t i = begin;
+
+#if defined(PLNNR_SCAN_AVX2)
+    const __m256i key = _mm256_set1_epi64x(int64_t(value));
+    for (; i + 4 <= end; i += 4)
+    {
+        const __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(column + i)), key);
+        const uint32_t mask = uint32_t(_mm256_movemask_pd(_mm256_castsi256_pd(eq)));
+        if (mask)
+            return i + lowest_bit(mask);
+    }
+#elif defined(PLNNR_SCAN_SSE2)
+    // SSE2 has no 64-bit compare: both 32-bit halves must be equal.
+    const __m128i key = _mm_set_epi32(int(value >> 32), int(value), int(value >> 32), int(value));
+    for (; i + 2 <= end; i += 2)
+    {
+        const __m128i eq32 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(column + i)), key);
+        const __m128i eq = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+        const uint32_t mask = uint32_t(_mm_movemask_pd(_mm_castsi128_pd(eq)));
+        if (mask)
+            return i + lowest_bit(mask);
+    }
+#elif defined(PLNNR_SCAN_NEON)
+    const uint32x4_t key = vreinterpretq_u32_u64(vdupq_n_u64(value));
+    for (; i + 2 <= end; i += 2)
+    {
+        const uint32x4_t eq32 = vceqq_u32(vreinterpretq_u32_u64(vld1q_u64(column + i)), key);
+        const uint32x4_t eq = vandq_u32(eq32, vrev64q_u32(eq32));
+        if (any_lane(vreinterpretq_u8_u32(eq)))
+            break;
+    }
+#endif
+
+    for (; i < end; ++i)
+    {
+        if (column[i] == value)
+            return i;
+    }
+
+    return end;
+}
+
+inline uint32_t find_equal(const int8_t* column, uint32_t begin, uint32_t end, int8_t value)
+{
+    return find_equal(reinterpret_cast<const uint8_t*>(column), begin, end, uint8_t(value));
+}
+
+inline uint32_t find_equal(const int32_t* column, uint32_t begin, uint32_t end, int32_t value)
+{
+    return find_equal(reinterpret_cast<const uint32_t*>(column), begin, end, uint32_t(value));
+}
+
+inline uint32_t find_equal(const int64_t* column, uint32_t begin, uint32_t end, int64_t value)
+{
+    return find_equal(reinterpret_cast<const uint64_t*>(column), begin, end, uint64_t(value));
+}
+
+}
+
+#endif
@@ -57,6 +57,14 @@ enum Type
 
 enum { Max_Fact_Arity = 8 };
 
+enum { Max_Fact_Indexes = 4 };
+
+// Terminates `Fact_Index` bucket chains.
+enum { Fact_Index_End = 0xffffffff };
+
+// Marks range cursors iterating the base database of an overlay.
+enum { Fact_Base_Cursor = 0x80000000 };
+
 // Format of the fact tuple.
 struct Fact_Type
 {
@@ -67,27 +75,136 @@ struct Fact_Type
 };
 
 // Points to a fact tuple in Fact_Database.
+// handles stay valid when entries are added or removed with `remove_entry_stable`,
+// `remove_entry`, `update_arg`, `compact`, `clear` and `set_max_entries` invalidate handles referring to the table.
 struct Fact_Handle
 {
-    // index of table in Fact_Database.
+    // index of table in Fact_Database, tables of the overlay's base database are offset by `num_tables`.
     uint32_t table;
     // index of entry in Fact_Table.
     uint32_t entry;
 };
 
+// Kinds of indexes maintained by `Fact_Table`.
+enum Fact_Index_Kind
+{
+    // hash index, supports equality lookups on one or more columns.
+    Fact_Index_Hash = 0,
+    // ordered index on a single numeric column, supports range lookups.
+    Fact_Index_Ordered,
+};
+
+// Columns of a fact tuple covered by an index.
+struct Fact_Index_Format
+{
+    // number of indexed columns.
+    uint8_t num_columns;
+    // indexed columns (fact parameter indices).
+    uint8_t columns[Max_Fact_Arity];
+    // `Fact_Index_Kind`.
+    uint8_t kind;
+};
+
+// Hash index over one or more columns of `Fact_Table`.
+// bucket chains keep entries in ascending order, so probing an index visits matching entries in the same order as a full table scan.
+struct Fact_Index
+{
+    // indexed columns.
+    Fact_Index_Format   format;
+    // number of buckets, power of two.
+    uint32_t            num_buckets;
+    // first entry in each bucket chain.
+    uint32_t*           heads;
+    // last entry in each bucket chain.
+    uint32_t*           tails;
+    // next entry in the bucket chain for each table entry.
+    uint32_t*           next;
+    // hash of the indexed columns for each table entry.
+    uint32_t*           hashes;
+    // block of memory accommodating index data.
+    void*               blob;
+};
+
+// Ordered index over a single numeric column of `Fact_Table`.
+struct Fact_Ordered_Index
+{
+    // indexed column.
+    uint8_t             column;
+    // table entries sorted by the column value (NaNs last), equal values are kept in entry order.
+    uint32_t*           entries;
+};
+
+// Comparison operators supported by range lookups in `Fact_Ordered_Index`.
+enum Range_Op
+{
+    Range_Less = 0,
+    Range_Less_Equal,
+    Range_Greater,
+    Range_Greater_Equal,
+};
+
 // Collection of tuples of a single fact type.
+struct Fact_Table;
+
+// Growth policy of `Fact_Table`, returns the new capacity (at least `required_entries`) for a full table.
+typedef uint32_t Fact_Table_Growth(const Fact_Table* table, uint32_t required_entries);
+
+// Number of 64-bit words in the per-column distinct values sketch of `Fact_Table`.
+enum { Distinct_Sketch_Words = 4 };
+
+// Storage layout of `Type_Vec3` columns in `Fact_Table`.
+enum Vec3_Layout
+{
+    // array of `Vec3` structs.
+    Vec3_Layout_Interleaved = 0,
+    // three float planes (all x, then all y, then all z), each `max_entries` long.
+    Vec3_Layout_Planes,
+};
+
+// Vec3 column as seen by the row filters, `stride` is 1 for planes and 3 for interleaved vec3 values.
+struct Vec3_Column
+{
+    const float*    x;
+    const float*    y;
+    const float*    z;
+    uint32_t        stride;
+};
+
 struct Fact_Table
 {
     // type (format) of the stored data tuples.
     Fact_Type       format;
-    // current number of entries stored.
+    // current number of entries stored, including the removed ones.
     uint32_t        num_entries;
     // total allocated number of entries.
     uint32_t        max_entries;
-    // block of memory accommodating entries' data.
+    // block of memory accommodating entries' data, null if columns point to read-only snapshot data.
     void*           blob;
     // tuples in SOA layout.
     void*           columns[Max_Fact_Arity];
+    // layout of the vec3 columns.
+    Vec3_Layout     vec3_layout;
+    // number of hash indexes maintained for this table.
+    uint32_t        num_indexes;
+    // hash indexes, updated on each `add_entry`.
+    Fact_Index      indexes[Max_Fact_Indexes];
+    // number of ordered indexes maintained for this table.
+    uint32_t        num_ordered_indexes;
+    // ordered indexes, updated on each `add_entry`.
+    Fact_Ordered_Index ordered_indexes[Max_Fact_Indexes];
+    // number of entries removed by `remove_entry_stable` and not yet compacted.
+    uint32_t        num_removed;
+    // non-zero for each entry removed by `remove_entry_stable`, allocated on the first removal.
+    uint8_t*        removed;
+    // growth policy used by `add_entry` when the table is full, null for the fixed size table.
+    Fact_Table_Growth* growth;
+    // maximum number of entries the table ever had, used to tune `Database_Format::size_hints`.
+    uint32_t        high_water_mark;
+    // true if inserted values are added to `distinct_sketch` (see `set_stats`).
+    bool            stats;
+    // linear counting bitmaps of the column value hashes, estimate the number of distinct values per column.
+    // values are only added, so the estimates don't shrink on removal or update.
+    uint64_t        distinct_sketch[Max_Fact_Arity][Distinct_Sketch_Words];
     // allocator.
     Memory*         memory;
 };
@@ -109,10 +226,16 @@ struct Fact_Database
     uint32_t        hash_seed;
     // fact name hash per each table.
     uint32_t*       hashes;
+    // open addressing map from fact name hash to table index, `Fact_Index_End` marks empty slots.
+    uint32_t*       lookup;
+    // number of `lookup` slots minus one, the number of slots is a power of two.
+    uint32_t        lookup_mask;
     // fact name per each table.
     const char**    names;
     // table data.
     Fact_Table*     tables;
+    // read-only database extended by this overlay database, null for a regular database.
+    const Fact_Database* base;
     // linear block of memory accommodating database data (not including tables data).
     void*           blob;
     // allocator.
@@ -123,8 +246,28 @@ struct Planning_State;
 
 struct Expansion_Frame;
 
+struct Speculation;
+
+struct Batch_Planner;
+
+struct Domain_Info;
+
 // Generated expansion function prototype.
-typedef bool Compound_Task_Expand(Planning_State*, Expansion_Frame*, Fact_Database*);
+typedef bool Compound_Task_Expand(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+// Generated case precondition prototype, returns true for each precondition satisfier.
+typedef bool Case_Precondition(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+// Result of a speculatively evaluated case precondition, see `set_speculation`.
+enum Speculation_Result
+{
+    // precondition was not evaluated in advance.
+    Speculation_None = 0,
+    // precondition has yielded the first satisfier.
+    Speculation_Found,
+    // precondition has no satisfiers.
+    Speculation_Empty,
+};
 
 // Compound task expansion state.
 struct Expansion_Frame
@@ -152,6 +295,8 @@ struct Expansion_Frame
     uint16_t                precond_label;
     // number of handles to a fact database kept by the case precondition.
     uint16_t                num_handles;
+    // `Speculation_Result` of the case precondition, consumed by the first precondition call.
+    uint16_t                speculation;
     // number of binding tuples stored by the precondition; usually equals to 1, more for ordered preconditions.
     uint32_t                num_bindings;
     // index of a binding tuple yielded by precondition.
@@ -165,7 +310,10 @@ struct Expansion_Frame
 
     // pointer to the compound task arguments.
     void*                   arguments;
-    // fact database handles kept by the case precondition.
+    // fact database handles kept by the case precondition, iteration over an ordered index keeps an extra cursor handle,
+    // a row filter keeps its block mask in an extra slot (see `row_mask`), so the slots are 8-byte aligned.
+    // fact tables may be modified between `find_plan_step` calls only with operations keeping the handles valid (see `Fact_Handle`),
+    // any other modification requires restarting the planning with `find_plan_init`.
     Fact_Handle*            handles;
     // pointer to the variable bindings generated by the case precondition.
     void*                   bindings;
@@ -221,8 +369,63 @@ struct Planning_State
     Blob                    task_blob;
     // maps domain fact table indices to actual table indices in `Fact_Database`.
     uint32_t*               table_indices;
+    // true if the bound database has tables in the domain order, i.e. `table_indices` is an identity map.
+    bool                    identity_binding;
     // allocator used for allocating & growing planning blobs and stacks.
     Memory*                 memory;
+    // true if stacks & blobs grow between planning steps instead of running out of space (see `set_growth`).
+    bool                    growth;
+    // maximum expansion depth when growth is enabled, the stacks don't grow past it.
+    uint32_t                max_growth_depth;
+    // maximum plan length when growth is enabled.
+    uint32_t                max_growth_plan_length;
+    // free space kept in `expansion_blob` before each step, fits the data of a single compound task expansion.
+    uint32_t                expansion_reserve;
+    // free space kept in `task_blob` before each step, fits the arguments of a single task.
+    uint32_t                task_reserve;
+    // number of generated precondition iterator calls, wraps around.
+    uint32_t                precond_iterations;
+    // speculative evaluation of the `:parallel` task cases, null if disabled (see `set_speculation`).
+    Speculation*            speculation;
+};
+
+// Speculatively evaluated case precondition.
+struct Speculation_Slot
+{
+    // private copy of the expansion frame, `handles` & `bindings` point to the slot data.
+    Expansion_Frame         frame;
+    // private copy of the planning state, the evaluation updates its counters.
+    Planning_State          state;
+    // `Speculation_Result` of the evaluation.
+    uint32_t                result;
+};
+
+// Copies the speculatively evaluated precondition state to the frame of a `:parallel` task case, evaluates the following cases first if needed.
+typedef void Speculation_Apply(Planning_State* state, const Domain_Info* domain, uint32_t task_id, Expansion_Frame* frame, const Fact_Database* db);
+
+// Window of the consecutive cases of a `:parallel` task evaluated at once on the worker threads.
+struct Speculation
+{
+    // workers evaluating the preconditions.
+    Batch_Planner*          pool;
+    // called by `expand_next_case`, keeps the generated code independent of the threading runtime.
+    Speculation_Apply*      apply;
+    // maximum number of cases evaluated at once.
+    uint32_t                max_cases;
+    // frame the cases were evaluated for, the window is valid during a single `find_plan_step`.
+    const Expansion_Frame*  frame;
+    // compound task of the evaluated cases.
+    uint32_t                task_type;
+    // index of the first evaluated case.
+    uint32_t                first_case;
+    // number of evaluated cases.
+    uint32_t                num_cases;
+    // `max_cases` evaluation slots.
+    Speculation_Slot*       slots;
+    // handles & bindings storage for each slot.
+    uint8_t*                slot_data;
+    // size of the storage for a single slot, fits the largest case of the domain.
+    uint32_t                slot_data_size;
 };
 
 // Helper to wrap an array of tasks `Task_Frame`, memory is owned by `Planning_State`. 
@@ -249,6 +452,56 @@ struct Database_Format
     uint32_t*       hashes;
     // fact name per each table.
     const char**    names;
+    // number of indexes for each table, optional.
+    uint32_t*       num_indexes;
+    // index of the first index format in `indexes` for each table, optional.
+    uint32_t*       first_index;
+    // formats of the indexes declared with `:index` and `:ordered` attributes.
+    Fact_Index_Format* indexes;
+    // true for each table joined by `:unordered` cases, which keeps the distinct values statistics, optional.
+    bool*           stats;
+};
+
+// Binary database snapshot constants.
+enum
+{
+    // 'PLNS' in little-endian, also detects snapshots saved with different endianness.
+    Snapshot_Magic = 0x534e4c50,
+    // incremented on each change of the snapshot layout.
+    Snapshot_Version = 1,
+    // alignment of the column data in snapshot.
+    Snapshot_Alignment = 16,
+};
+
+// Binary database snapshot header, followed by `num_tables` `Snapshot_Table` records and column data.
+struct Snapshot_Header
+{
+    // `Snapshot_Magic`.
+    uint32_t        magic;
+    // `Snapshot_Version`.
+    uint32_t        version;
+    // seed value used to compute table name hashes.
+    uint32_t        hash_seed;
+    // number of tables stored.
+    uint32_t        num_tables;
+    // total size of the snapshot in bytes.
+    uint64_t        size;
+};
+
+// Table record of a binary database snapshot, columns are stored in the same SOA layout as `Fact_Table::columns`.
+struct Snapshot_Table
+{
+    // fact name hash.
+    uint32_t        hash;
+    // number of entries stored.
+    uint32_t        num_entries;
+    // number of parameters.
+    uint8_t         num_params;
+    // type of each parameter.
+    uint8_t         types[Max_Fact_Arity];
+    uint8_t         padding[7];
+    // offset of each column data from the beginning of the snapshot.
+    uint64_t        offsets[Max_Fact_Arity];
 };
 
 // Describes layout of task parameters in memory.
@@ -293,6 +546,19 @@ struct Task_Info
     uint32_t*                   num_case_handles;
     // pointer to generated expand function for each compound task.
     Compound_Task_Expand**      expands;
+    // worst-case number of bytes allocated by a single frame of each task, computed from the layouts by `compute_frame_costs`.
+    // primitive tasks: arguments in the task blob; compound tasks: arguments, handles & bindings of the largest case in the expansion blob.
+    uint32_t*                   frame_costs;
+    // true for each case, which collects all of its bindings before yielding them (`:sorted` & `:distinct` cases).
+    bool*                       collects_bindings;
+    // index of the first `collect_facts` entry for each case, followed by the total number of entries.
+    uint32_t*                   first_collect_fact;
+    // fact tables joined by the collecting case preconditions, the number of collected bindings is bounded by the product of their sizes.
+    uint32_t*                   collect_facts;
+    // true for each compound task marked `:parallel`, its case preconditions may be evaluated in advance (see `set_speculation`).
+    bool*                       parallel;
+    // pointer to generated precondition function for each case.
+    Case_Precondition**         case_preconds;
 };
 
 // Table of symbol strings and their hashes.
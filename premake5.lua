@@ -63,6 +63,7 @@ workspace "derplanner"
         links { "derplanner-compiler", "derplanner-runtime" }
         filter { "system:linux or system:macosx" }
             files { "test/unittestpp/src/Posix/*.cpp" }
+            links { "pthread" }
         filter { "action:vs*" }
             files { "test/unittestpp/src/Win32/*.cpp" }
 
@@ -78,5 +79,7 @@ workspace "derplanner"
         files { "examples/travel.main.cpp" }
         includedirs { "include" }
         links { "derplanner-runtime", "domain-travel" }
+        filter { "system:linux or system:macosx" }
+            links { "pthread" }
         filter { "action:vs*" }
             defines { "PLNNR_DOMAIN_API=__declspec(dllimport)" }
@@ -19,6 +19,7 @@
 //
 
 #include <limits>
+#include <stdio.h>
 #include <stdlib.h>
 
 #include "derplanner/compiler/io.h"
@@ -30,6 +31,9 @@
 #include "derplanner/compiler/function_table.h"
 #include "derplanner/compiler/ast.h"
 
+#include "derplanner/runtime/types.h" // Max_Fact_Indexes
+#include "derplanner/runtime/intrinsics.h" // constant folding
+
 using namespace plnnrc;
 
 // implementation (exposed for unit tests)
@@ -407,6 +411,24 @@ ast::Expr* plnnrc::convert_to_dnf(const ast::Root* tree, ast::Expr* root)
     return new_root;
 }
 
+ast::Expr* plnnrc::convert_to_factorized(const ast::Root* tree, ast::Expr* root)
+{
+    ast::Expr* new_root = create_op(tree, ast::Node_Or);
+
+    // empty expression.
+    if (is_And(root) && !root->child)
+    {
+        return new_root;
+    }
+
+    // same as `convert_to_dnf`, but without distributing `And` over `Or`, i.e. the expression size is linear in the source.
+    ast::Expr* nnf_root = convert_to_nnf(tree, root);
+    append_child(new_root, nnf_root);
+    flatten(new_root);
+
+    return new_root;
+}
+
 // convert Or expression to DNF by applying distributive law repeatedly, until no change could be made.
 static ast::Expr* convert_or_to_dnf(const ast::Root* tree, ast::Expr* node_Or)
 {
@@ -653,6 +675,26 @@ void plnnrc::insert_child(ast::Expr* after, ast::Expr* child)
     child->parent = parent;
 }
 
+void plnnrc::prepend_child(ast::Expr* parent, ast::Expr* child)
+{
+    plnnrc_assert(parent != 0);
+    plnnrc_assert(child != 0);
+
+    ast::Expr* first_child = parent->child;
+
+    if (!first_child)
+    {
+        append_child(parent, child);
+        return;
+    }
+
+    child->parent = parent;
+    child->next_sibling = first_child;
+    child->prev_sibling_cyclic = first_child->prev_sibling_cyclic;
+    first_child->prev_sibling_cyclic = child;
+    parent->child = child;
+}
+
 void plnnrc::unparent(ast::Expr* node)
 {
     plnnrc_assert(node != 0);
@@ -727,6 +769,8 @@ struct Find_Attribute
 
     ast::Attribute* visit(const ast::Fact* node) { return find(node->attrs); }
 
+    ast::Attribute* visit(const ast::Task* node) { return find(node->attrs); }
+
     ast::Attribute* visit(const ast::Case* node) { return find(node->attrs); }
 
     ast::Attribute* visit(const ast::Node*) { return 0; }
@@ -749,7 +793,11 @@ void plnnrc::convert_to_dnf(const ast::Root* tree)
         {
             ast::Case* case_ = task->cases[case_idx];
             ast::Expr* precond = case_->precond;
-            case_->precond = convert_to_dnf(tree, precond);
+
+            if (find_attribute(case_, Attribute_Factorized))
+                case_->precond = convert_to_factorized(tree, precond);
+            else
+                case_->precond = convert_to_dnf(tree, precond);
         }
     }
 }
@@ -1135,6 +1183,106 @@ static void create_fact_ref_literals(const ast::Root* tree, ast::Expr* expr)
     }
 }
 
+// true if the variable `name` occurs in `expr`.
+static bool has_var(const ast::Expr* expr, const Token_Value& name)
+{
+    for (const ast::Expr* node = expr; node != 0; node = preorder_next(expr, node))
+    {
+        const ast::Var* var = as_Var(node);
+        if (var && equal(var->name, name))
+            return true;
+    }
+
+    return false;
+}
+
+// true if the variable `name` occurs in `expr` whichever alternative of its disjunctions is taken.
+static bool has_var_on_all_paths(const ast::Expr* expr, const Token_Value& name)
+{
+    if (is_Or(expr))
+    {
+        for (const ast::Expr* child = expr->child; child != 0; child = child->next_sibling)
+        {
+            if (!has_var_on_all_paths(child, name))
+                return false;
+        }
+
+        return true;
+    }
+
+    if (is_And(expr))
+    {
+        for (const ast::Expr* child = expr->child; child != 0; child = child->next_sibling)
+        {
+            if (has_var_on_all_paths(child, name))
+                return true;
+        }
+
+        return false;
+    }
+
+    return has_var(expr, name);
+}
+
+// marks the first occurrence of each variable on the path through the precondition literals as binding.
+// in DNF the path is the conjunct, `:factorized` preconditions also pass the alternatives of the nested disjunctions.
+static void mark_binding_occurrences(const ast::Root* tree, ast::Case* case_)
+{
+    ast::Expr* precond = case_->precond;
+
+    for (ast::Expr* node = precond; node != 0; node = preorder_next(precond, node))
+    {
+        ast::Var* var = as_Var(node);
+        if (!var)
+            continue;
+
+        if (as_Param(var->definition) != 0)
+            continue;
+
+        ast::Expr* literal = var;
+        while (literal->parent && !is_And(literal->parent) && !is_Or(literal->parent))
+            literal = literal->parent;
+
+        // variable occurs earlier in the same literal.
+        bool bound = false;
+        for (ast::Expr* prev = literal; prev != var; prev = preorder_next(literal, prev))
+        {
+            ast::Var* prev_var = as_Var(prev);
+            if (prev_var && equal(prev_var->name, var->name))
+            {
+                bound = true;
+                break;
+            }
+        }
+
+        // variable occurs in the preceding literals of the enclosing conjunctions.
+        bool partial = false;
+        for (ast::Expr* scope = literal; !bound && scope->parent != 0; scope = scope->parent)
+        {
+            if (!is_And(scope->parent))
+                continue;
+
+            for (ast::Expr* prev = scope->parent->child; prev != scope; prev = prev->next_sibling)
+            {
+                if (has_var_on_all_paths(prev, var->name))
+                {
+                    bound = true;
+                    break;
+                }
+
+                partial |= has_var(prev, var->name);
+            }
+        }
+
+        // bound in some alternatives of a nested disjunction only.
+        if (!bound && partial)
+            emit(tree, var->loc, Error_Not_Bound_In_All_Conjuncts) << var->name;
+
+        if (!bound)
+            var->binding = true;
+    }
+}
+
 void plnnrc::annotate(ast::Root* tree)
 {
     ast::World* world = tree->world;
@@ -1315,32 +1463,7 @@ void plnnrc::annotate(ast::Root* tree)
             }
 
             // mark ast::Var binding occurrences.
-            {
-                Memory_Stack_Scope scratch_scope(tree->scratch);
-                Id_Table<ast::Var*> seen;
-                init(seen, tree->scratch, size(case_->precond_var_lookup));
-
-                for (ast::Expr* conjunct = case_->precond->child; conjunct != 0; conjunct = conjunct->next_sibling)
-                {
-                    for (ast::Expr* node = conjunct; node != 0; node = preorder_next(conjunct, node))
-                    {
-                        ast::Var* var = as_Var(node);
-                        if (!var)
-                            continue;
-
-                        if (as_Param(var->definition) != 0)
-                            continue;
-
-                        if (get(seen, var->name) == 0)
-                        {
-                            var->binding = true;
-                            set(seen, var->name, var);
-                        }
-                    }
-
-                    clear(seen);
-                }
-            }
+            mark_binding_occurrences(tree, case_);
         }
     }
 }
@@ -1444,31 +1567,8 @@ static bool check_all_precond_vars_bound(const ast::Root* tree, const ast::Case*
 
 static bool has_var_in_all_conjuncts(const ast::Expr* precond, const ast::Var* var)
 {
-    const uint32_t hash_val = hash(var->name);
-    plnnrc_assert(is_Or(precond)); // must be in Disjunctive-Normal-Form.
-
-    for (ast::Expr* conjunct = precond->child; conjunct != 0; conjunct = conjunct->next_sibling)
-    {
-        bool found = false;
-        for (ast::Expr* n = conjunct; n != 0; n = preorder_next(conjunct, n))
-        {
-            ast::Var* v = as_Var(n);
-            if (!v)
-                continue;
-
-            const uint32_t h = hash(v->name);
-            if (h != hash_val)
-                continue;
-
-            if (equal(v->name, var->name))
-                found = true;
-        }
-
-        if (!found)
-            return false;
-    }
-
-    return true;
+    plnnrc_assert(is_Or(precond)); // must be in Disjunctive-Normal-Form or factorized.
+    return has_var_on_all_paths(precond, var->name);
 }
 
 static bool init_precond_variable_assignments(const ast::Root* tree)
@@ -2158,23 +2258,25 @@ static bool process_attributes(const ast::Root* tree, const Array<ast::Attribute
 
         attr_counts[attr_type] += 1;
 
-        if (attr_counts[attr_type] > 1)
+        if (attr_counts[attr_type] > 1 && !is_repeatable(attr_type))
         {
             emit(tree, attr->loc, Error_Only_Single_Attr_Allowed) << attr->name;
             continue;
         }
 
         const uint32_t attr_num_args = get_num_args(attr_type);
-        if (size(attr->args) != attr_num_args)
+        const bool arg_list = has_arg_list(attr_type);
+        if (size(attr->args) != attr_num_args && !(arg_list && size(attr->args) > attr_num_args))
         {
             emit(tree, attr->loc, Error_Mismatching_Number_Of_Args) << attr->name;
             continue;
         }
 
         const Attribute_Arg_Class* arg_classes = get_arg_classes(attr_type);
-        for (uint32_t arg_idx = 0; arg_idx < attr_num_args; ++arg_idx)
+        for (uint32_t arg_idx = 0; arg_idx < size(attr->args); ++arg_idx)
         {
-            if (arg_classes[arg_idx] != Attribute_Arg_Constant_Expression)
+            const uint32_t class_idx = (arg_idx < attr_num_args) ? arg_idx : attr_num_args - 1;
+            if (arg_classes[class_idx] != Attribute_Arg_Constant_Expression)
                 continue;
 
             Is_Const_Expr visitor;
@@ -2189,6 +2291,55 @@ static bool process_attributes(const ast::Root* tree, const Array<ast::Attribute
     return err_count == size(*tree->errs);
 }
 
+static bool process_attributes(const ast::Root* tree, const Array<ast::Attribute*>& attrs, const ast::Fact* fact)
+{
+    const uint32_t err_count = size(*tree->errs);
+
+    if (!process_attributes(tree, attrs))
+        return false;
+
+    uint32_t num_indexes = 0;
+    uint32_t num_ordered_indexes = 0;
+    for (uint32_t attr_idx = 0; attr_idx < size(attrs); ++attr_idx)
+    {
+        ast::Attribute* attr = attrs[attr_idx];
+        if (!is_Index(attr) && !is_Ordered(attr))
+            continue;
+
+        uint32_t& count = is_Index(attr) ? num_indexes : num_ordered_indexes;
+        if (++count > plnnr::Max_Fact_Indexes)
+        {
+            emit(tree, attr->loc, Error_Too_Many_Indexes) << fact->name;
+            break;
+        }
+
+        // index arguments are unique column numbers of the fact.
+        uint32_t used_columns = 0;
+        for (uint32_t arg_idx = 0; arg_idx < size(attr->args); ++arg_idx)
+        {
+            const ast::Literal* literal = as_Literal(attr->args[arg_idx]);
+            const int64_t column = (literal && is_Literal_Integer(literal->value_type)) ? as_int(literal) : -1;
+
+            if (column < 0 || column >= int64_t(size(fact->params)) || (used_columns & (1u << column)))
+            {
+                emit(tree, attr->loc, Error_Invalid_Index_Column) << attr->name << fact->name;
+                break;
+            }
+
+            used_columns |= (1u << column);
+
+            const Token_Type column_type = fact->params[column]->data_type;
+            if (is_Ordered(attr) && !is_Scalar_Numeric(column_type))
+            {
+                emit(tree, attr->loc, Error_Ordered_Index_Not_Numeric) << attr->name;
+                break;
+            }
+        }
+    }
+
+    return err_count == size(*tree->errs);
+}
+
 static bool process_attributes(const ast::Root* tree, const Array<ast::Attribute*>& attrs, const ast::Case* case_)
 {
     const uint32_t err_count = size(*tree->errs);
@@ -2209,9 +2360,10 @@ static bool process_attributes(const ast::Root* tree, const Array<ast::Attribute
 
         const uint32_t attr_num_args = get_num_args(attr_type);
         const Attribute_Arg_Class* arg_classes = get_arg_classes(attr_type);
-        for (uint32_t arg_idx = 0; arg_idx < attr_num_args; ++arg_idx)
+        for (uint32_t arg_idx = 0; arg_idx < size(attr->args); ++arg_idx)
         {
-            if (arg_classes[arg_idx] != Attribute_Arg_Expression)
+            const uint32_t class_idx = (arg_idx < attr_num_args) ? arg_idx : attr_num_args - 1;
+            if (arg_classes[class_idx] != Attribute_Arg_Expression)
                 continue;
 
             ast::Expr* arg = attr->args[arg_idx];
@@ -2252,7 +2404,13 @@ static bool process_attributes(const ast::Root* tree)
     for (uint32_t fact_idx = 0; fact_idx < size(tree->world->facts); ++fact_idx)
     {
         const ast::Fact* fact = tree->world->facts[fact_idx];
-        process_attributes(tree, fact->attrs);
+        process_attributes(tree, fact->attrs, fact);
+    }
+
+    for (uint32_t task_idx = 0; task_idx < size(tree->domain->tasks); ++task_idx)
+    {
+        const ast::Task* task = tree->domain->tasks[task_idx];
+        process_attributes(tree, task->attrs);
     }
 
     for (uint32_t case_idx = 0; case_idx < size(tree->cases); ++case_idx)
@@ -2315,49 +2473,783 @@ bool plnnrc::infer_types(const ast::Root* tree)
     return true;
 }
 
-struct Attribute_Args_Spec
+// true if the conjunct literal iterates a fact table, i.e. it's a positive fact literal.
+static bool is_fact_literal(const ast::Root* tree, const ast::Expr* literal)
 {
-    Attribute_Arg_Class classes[2];
-};
+    const ast::Func* func = as_Func(literal);
+    return func != 0 && get_fact(tree, func->name) != 0;
+}
 
-static const Attribute_Args_Spec s_attribute_specs[] =
+// true if `a` and `b` reference a common variable, task parameters are not counted.
+static bool has_common_vars(const ast::Expr* a, const ast::Expr* b)
 {
-    { { } },
-    #define PLNNRC_ATTRIBUTE(TAG, STR) { {
-    #define PLNNRC_ATTRIBUTE_ARG(TYPE) Attribute_Arg_##TYPE,
-    #define PLNNRC_ATTRIBUTE_END } },
-    #include "derplanner/compiler/attribute_tags.inl"
-    #undef PLNNRC_ATTRIBUTE_END
-    #undef PLNNRC_ATTRIBUTE_ARG
-    #undef PLNNRC_ATTRIBUTE
-};
+    for (const ast::Expr* node_a = a; node_a != 0; node_a = preorder_next(a, node_a))
+    {
+        const ast::Var* var_a = as_Var(node_a);
+        if (!var_a || as_Param(var_a->definition))
+            continue;
 
-static const uint32_t s_attribute_arg_count[] =
+        for (const ast::Expr* node_b = b; node_b != 0; node_b = preorder_next(b, node_b))
+        {
+            const ast::Var* var_b = as_Var(node_b);
+            if (var_b && equal(var_a->name, var_b->name))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// moves expressions and negations in front of the fact loops they don't depend on.
+// these literals pass or reject the current bindings and don't produce new ones, so the result and its order are the same.
+static void hoist_filters(const ast::Root* tree, ast::Expr* conjunct)
 {
-    0,
-    #define PLNNRC_ATTRIBUTE(TAG, STR) (0
-    #define PLNNRC_ATTRIBUTE_ARG(TYPE) +1
-    #define PLNNRC_ATTRIBUTE_END ),
-    #include "derplanner/compiler/attribute_tags.inl"
-    #undef PLNNRC_ATTRIBUTE_END
-    #undef PLNNRC_ATTRIBUTE_ARG
-    #undef PLNNRC_ATTRIBUTE
-};
+    for (ast::Expr* literal = conjunct->child; literal != 0; )
+    {
+        ast::Expr* next = literal->next_sibling;
 
-uint32_t plnnrc::get_num_args(Attribute_Type type)
+        if (!is_fact_literal(tree, literal))
+        {
+            // the outermost fact loop not binding any of the literal variables, other expressions keep their order.
+            ast::Expr* target = literal;
+            for (ast::Expr* prev = literal; prev != conjunct->child; )
+            {
+                prev = prev->prev_sibling_cyclic;
+                if (has_common_vars(prev, literal))
+                    break;
+
+                if (is_fact_literal(tree, prev))
+                    target = prev;
+            }
+
+            if (target != literal)
+            {
+                ast::Expr* after = (target != conjunct->child) ? target->prev_sibling_cyclic : 0;
+                unparent(literal);
+
+                if (after)
+                    insert_child(after, literal);
+                else
+                    prepend_child(conjunct, literal);
+            }
+        }
+
+        literal = next;
+    }
+}
+
+// the `:size` of the fact if it's a literal, otherwise the fact is considered unbounded.
+static uint32_t get_size_hint(const ast::Fact* fact)
 {
-    if (type >= Attribute_Count)
-        return 0;
+    const ast::Attribute* attr = find_attribute(fact, Attribute_Size);
+    const ast::Literal* literal = attr ? as_Literal(attr->args[0]) : 0;
 
-    return s_attribute_arg_count[type];
+    if (!literal)
+        return 0xffffffff;
+
+    return uint32_t(as_int(literal));
 }
 
-const Attribute_Arg_Class* plnnrc::get_arg_classes(Attribute_Type type)
+// true if the variable is a task parameter or it's bound by the already ordered literals.
+static bool is_bound_var(const Id_Table<bool>& bound, const ast::Var* var)
 {
-    if (type >= Attribute_Count)
-        return 0;
+    return as_Param(var->definition) != 0 || get(bound, var->name) != 0;
+}
 
-    return s_attribute_specs[type].classes;
+// sorts the leading fact literals of the conjunct (up to the first negation or assignment), so that the facts
+// with more bound arguments come first, and the facts with the smaller `:size` break ties. returns true if the order has changed.
+static bool reorder_facts(const ast::Root* tree, ast::Expr* conjunct)
+{
+    Memory_Stack_Scope scratch_scope(tree->scratch);
+
+    Array<ast::Expr*> facts;
+    init(facts, tree->scratch, 8);
+
+    for (ast::Expr* literal = conjunct->child; literal != 0; literal = literal->next_sibling)
+    {
+        if (is_Not(literal) || is_Assign(literal))
+            break;
+
+        if (is_fact_literal(tree, literal))
+            push_back(facts, literal);
+    }
+
+    Id_Table<bool> bound;
+    init(bound, tree->scratch, 8);
+
+    bool changed = false;
+    for (uint32_t pos = 0; pos < size(facts); ++pos)
+    {
+        uint32_t best_idx = size(facts);
+        uint32_t best_bound = 0;
+        uint32_t best_size = 0;
+
+        for (uint32_t idx = pos; idx < size(facts); ++idx)
+        {
+            const ast::Func* func = as_Func(facts[idx]);
+            uint32_t num_bound = 0;
+            bool ready = true;
+
+            for (uint32_t arg_idx = 0; arg_idx < size(func->args) && ready; ++arg_idx)
+            {
+                const ast::Expr* arg = func->args[arg_idx];
+                if (const ast::Var* var = as_Var(arg))
+                {
+                    num_bound += is_bound_var(bound, var) ? 1 : 0;
+                    continue;
+                }
+
+                // expression arguments can only be evaluated when all their variables are bound.
+                for (const ast::Expr* node = arg; node != 0; node = preorder_next(arg, node))
+                {
+                    const ast::Var* var = as_Var(node);
+                    if (var && !is_bound_var(bound, var))
+                    {
+                        ready = false;
+                        break;
+                    }
+                }
+
+                ++num_bound;
+            }
+
+            if (!ready)
+                continue;
+
+            const uint32_t size_hint = get_size_hint(get_fact(tree, func->name));
+
+            if (best_idx == size(facts) || num_bound > best_bound || (num_bound == best_bound && size_hint < best_size))
+            {
+                best_idx = idx;
+                best_bound = num_bound;
+                best_size = size_hint;
+            }
+        }
+
+        plnnrc_assert(best_idx < size(facts));
+
+        if (best_idx != pos)
+        {
+            ast::Expr* best = facts[best_idx];
+            for (uint32_t idx = best_idx; idx > pos; --idx)
+                facts[idx] = facts[idx - 1];
+
+            facts[pos] = best;
+            changed = true;
+        }
+
+        const ast::Func* func = as_Func(facts[pos]);
+        for (uint32_t arg_idx = 0; arg_idx < size(func->args); ++arg_idx)
+        {
+            if (const ast::Var* var = as_Var(func->args[arg_idx]))
+                set(bound, var->name, true);
+        }
+    }
+
+    if (!changed)
+        return false;
+
+    // facts go first, the other leading literals follow them and are hoisted later.
+    for (uint32_t idx = 0; idx < size(facts); ++idx)
+    {
+        unparent(facts[idx]);
+
+        if (idx == 0)
+            prepend_child(conjunct, facts[idx]);
+        else
+            insert_child(facts[idx - 1], facts[idx]);
+    }
+
+    return true;
+}
+
+// rebuilds `precond_vars`, `precond_var_lookup`, definitions and binding flags after the precondition literals were reordered.
+static void rebind_precond_vars(const ast::Root* tree, ast::Case* case_)
+{
+    clear(case_->precond_vars);
+    clear(case_->precond_var_lookup);
+
+    for (ast::Expr* node = case_->precond; node != 0; node = preorder_next(case_->precond, node))
+    {
+        ast::Var* var = as_Var(node);
+        if (!var)
+            continue;
+
+        push_back(case_->precond_vars, var);
+        var->binding = false;
+
+        ast::Var* first = get(case_->precond_var_lookup, var->name);
+
+        if (!first)
+            set(case_->precond_var_lookup, var->name, var);
+
+        if (as_Param(var->definition))
+            continue;
+
+        var->definition = first;
+    }
+
+    // task list and attribute variables refer to the first occurrence.
+    for (uint32_t var_idx = 0; var_idx < size(case_->task_list_vars); ++var_idx)
+    {
+        ast::Var* var = case_->task_list_vars[var_idx];
+        if (is_Var(var->definition))
+            var->definition = get(case_->precond_var_lookup, var->name);
+    }
+
+    for (uint32_t attr_idx = 0; attr_idx < size(case_->attrs); ++attr_idx)
+    {
+        ast::Attribute* attr = case_->attrs[attr_idx];
+        for (uint32_t arg_idx = 0; arg_idx < size(attr->args); ++arg_idx)
+        {
+            ast::Expr* arg = attr->args[arg_idx];
+            for (ast::Expr* node = arg; node != 0; node = preorder_next(arg, node))
+            {
+                ast::Var* var = as_Var(node);
+                if (var && is_Var(var->definition))
+                    var->definition = get(case_->precond_var_lookup, var->name);
+            }
+        }
+    }
+
+    Memory_Stack_Scope scratch_scope(tree->scratch);
+    Id_Table<ast::Var*> seen;
+    init(seen, tree->scratch, size(case_->precond_var_lookup));
+
+    for (ast::Expr* conjunct = case_->precond->child; conjunct != 0; conjunct = conjunct->next_sibling)
+    {
+        for (ast::Expr* node = conjunct; node != 0; node = preorder_next(conjunct, node))
+        {
+            ast::Var* var = as_Var(node);
+            if (!var || as_Param(var->definition))
+                continue;
+
+            if (get(seen, var->name) == 0)
+            {
+                var->binding = true;
+                set(seen, var->name, var);
+            }
+        }
+
+        clear(seen);
+    }
+}
+
+// C++ type of a constant in the generated code: integer and float literals are `int` and `double`, intrinsics return `float`.
+enum Constant_Kind
+{
+    Constant_Int = 0,
+    Constant_Float,
+    Constant_Double,
+};
+
+struct Constant
+{
+    Constant_Kind   kind;
+    double          value;
+};
+
+static bool get_constant(const ast::Expr* node, Constant& out)
+{
+    const ast::Literal* literal = as_Literal(node);
+    if (!literal)
+        return false;
+
+    if (is_Literal_Float(literal->value_type))
+    {
+        // folded `float` values are written with `f` suffix.
+        const bool is_float = literal->value.str[literal->value.length - 1] == 'f';
+        out.kind = is_float ? Constant_Float : Constant_Double;
+        out.value = strtod(literal->value.str, 0);
+        return true;
+    }
+
+    if (is_Literal_Integer(literal->value_type))
+    {
+        out.kind = Constant_Int;
+        out.value = double(as_int(literal));
+        return true;
+    }
+
+    return false;
+}
+
+static bool is_named(const ast::Func* func, const char* name)
+{
+    const uint32_t length = uint32_t(strlen(name));
+    return func->name.length == length && strncmp(func->name.str, name, length) == 0;
+}
+
+// evaluates a float intrinsic with constant arguments.
+static bool evaluate_intrinsic(const ast::Root* tree, const ast::Func* func, Constant& out)
+{
+    if (get_fact(tree, func->name))
+        return false;
+
+    float args[3];
+    const uint32_t num_args = size(func->args);
+    if (num_args > 3)
+        return false;
+
+    for (uint32_t arg_idx = 0; arg_idx < num_args; ++arg_idx)
+    {
+        Constant arg;
+        if (!get_constant(func->args[arg_idx], arg))
+            return false;
+
+        args[arg_idx] = float(arg.value);
+    }
+
+    out.kind = Constant_Float;
+
+    if (num_args == 0 && is_named(func, "pi"))
+        out.value = plnnr::pi();
+    else if (num_args == 1 && is_named(func, "abs"))
+        out.value = plnnr::abs(args[0]);
+    else if (num_args == 1 && is_named(func, "cos"))
+        out.value = plnnr::cos(args[0]);
+    else if (num_args == 1 && is_named(func, "sin"))
+        out.value = plnnr::sin(args[0]);
+    else if (num_args == 1 && is_named(func, "rad"))
+        out.value = plnnr::rad(args[0]);
+    else if (num_args == 1 && is_named(func, "deg"))
+        out.value = plnnr::deg(args[0]);
+    else if (num_args == 3 && is_named(func, "clamp"))
+        out.value = plnnr::clamp(args[0], args[1], args[2]);
+    else
+        return false;
+
+    return true;
+}
+
+static double apply_arithmetic(ast::Node_Type op, Constant_Kind kind, double a, double b)
+{
+    if (kind == Constant_Float)
+    {
+        switch (op)
+        {
+        case ast::Node_Plus:    return float(a) + float(b);
+        case ast::Node_Minus:   return float(a) - float(b);
+        case ast::Node_Mul:     return float(a) * float(b);
+        default:                return float(a) / float(b);
+        }
+    }
+
+    switch (op)
+    {
+    case ast::Node_Plus:    return a + b;
+    case ast::Node_Minus:   return a - b;
+    case ast::Node_Mul:     return a * b;
+    default:                return a / b;
+    }
+}
+
+// evaluates arithmetic with constant operands, integer arithmetic is left to the C++ compiler.
+static bool evaluate_arithmetic(const ast::Op* op, Constant& out)
+{
+    if (!op->child || !get_constant(op->child, out))
+        return false;
+
+    // unary.
+    if (!op->child->next_sibling)
+    {
+        if (out.kind == Constant_Int)
+            return false;
+
+        out.value = is_Minus(op) ? -out.value : out.value;
+        return true;
+    }
+
+    for (ast::Expr* arg = op->child->next_sibling; arg != 0; arg = arg->next_sibling)
+    {
+        Constant rhs;
+        if (!get_constant(arg, rhs))
+            return false;
+
+        const Constant_Kind kind = out.kind > rhs.kind ? out.kind : rhs.kind;
+        if (kind == Constant_Int || (is_Div(op) && rhs.value == 0.0))
+            return false;
+
+        out.value = apply_arithmetic(op->type, kind, out.value, rhs.value);
+        out.kind = kind;
+    }
+
+    return true;
+}
+
+// replaces `node` with `replacement` in the parent node and in the parent function arguments.
+static void replace_node(ast::Expr* node, ast::Expr* replacement)
+{
+    insert_child(node, replacement);
+    unparent(node);
+
+    if (ast::Func* func = as_Func(replacement->parent))
+    {
+        for (uint32_t arg_idx = 0; arg_idx < size(func->args); ++arg_idx)
+        {
+            if (func->args[arg_idx] == node)
+                func->args[arg_idx] = replacement;
+        }
+    }
+}
+
+// replaces arithmetic and intrinsic calls with constant arguments by their values.
+static void fold_constants(ast::Root* tree, ast::Expr* root)
+{
+    for (ast::Expr* child = root->child; child != 0; )
+    {
+        ast::Expr* next = child->next_sibling;
+        fold_constants(tree, child);
+        child = next;
+    }
+
+    if (!root->parent)
+        return;
+
+    Constant result;
+
+    if (ast::Func* func = as_Func(root))
+    {
+        if (!evaluate_intrinsic(tree, func, result))
+            return;
+    }
+    else if (is_Arithmetic(root))
+    {
+        if (!evaluate_arithmetic(static_cast<ast::Op*>(root), result))
+            return;
+    }
+    else
+    {
+        return;
+    }
+
+    if (result.value != result.value || result.value - result.value != 0.0)
+        return;
+
+    char text[64];
+    snprintf(text, sizeof(text), result.kind == Constant_Float ? "%.9g" : "%.17g", result.value);
+
+    if (!strchr(text, '.') && !strchr(text, 'e'))
+        strcat(text, ".0");
+
+    if (result.kind == Constant_Float)
+        strcat(text, "f");
+
+    Token tok;
+    tok.type = Token_Literal_Float;
+    push_back(tree->names, text);
+    // null-terminated for `as_float`.
+    put_chars(tree->names, "", 1);
+    tok.value = get(tree->names, size(tree->names) - 1);
+
+    replace_node(root, create_literal(tree, tok, root->loc));
+}
+
+// true if the expression is worth computing once: it's an arithmetic or an intrinsic call without fact table references.
+static bool is_invariant_candidate(const ast::Root* tree, const ast::Expr* expr)
+{
+    if (!is_Arithmetic(expr))
+    {
+        const ast::Func* func = as_Func(expr);
+        if (!func || get_fact(tree, func->name))
+            return false;
+    }
+
+    for (const ast::Expr* node = expr; node != 0; node = preorder_next(expr, node))
+    {
+        const ast::Literal* literal = as_Literal(node);
+        if (literal && is_Literal_Fact(literal->value_type))
+            return false;
+    }
+
+    return true;
+}
+
+// true if there is a fact loop between the literals `expr` depends on and `literal`, i.e. `expr` is evaluated more often than its value changes.
+static bool is_loop_invariant(const ast::Root* tree, ast::Expr* conjunct, ast::Expr* literal, const ast::Expr* expr)
+{
+    for (ast::Expr* prev = literal; prev != conjunct->child; )
+    {
+        prev = prev->prev_sibling_cyclic;
+        if (has_common_vars(prev, expr))
+            return false;
+
+        if (is_fact_literal(tree, prev))
+            return true;
+    }
+
+    return false;
+}
+
+// moves `expr` into a new assignment in front of `literal`, `expr` is replaced with the assigned variable.
+static void hoist_expression(ast::Root* tree, ast::Case* case_, ast::Expr* conjunct, ast::Expr* literal, ast::Expr* expr)
+{
+    Compute_Expr_Result_Type type_visitor = { tree };
+    const Token_Type data_type = visit_node<Token_Type>(expr, &type_visitor);
+
+    const Token_Value name = make_unique_name(tree);
+    ast::Var* target = create_var(tree, name, expr->loc);
+    ast::Var* ref = create_var(tree, name, expr->loc);
+    target->data_type = data_type;
+    target->binding = true;
+    ref->data_type = data_type;
+    ref->definition = target;
+
+    replace_node(expr, ref);
+
+    ast::Op* assign = create_op(tree, ast::Node_Assign, expr->loc);
+    append_child(assign, target);
+    append_child(assign, expr);
+
+    if (literal == conjunct->child)
+        prepend_child(conjunct, assign);
+    else
+        insert_child(literal->prev_sibling_cyclic, assign);
+
+    push_back(case_->precond_vars, target);
+    push_back(case_->precond_vars, ref);
+    set(case_->precond_var_lookup, name, target);
+}
+
+static void hoist_invariants(ast::Root* tree, ast::Case* case_, ast::Expr* conjunct, ast::Expr* literal, ast::Expr* expr)
+{
+    for (ast::Expr* child = expr->child; child != 0; )
+    {
+        ast::Expr* next = child->next_sibling;
+
+        if (is_invariant_candidate(tree, child) && is_loop_invariant(tree, conjunct, literal, child))
+            hoist_expression(tree, case_, conjunct, literal, child);
+        else
+            hoist_invariants(tree, case_, conjunct, literal, child);
+
+        child = next;
+    }
+}
+
+// true if the fact column value is known when the negated literal is evaluated, index probes hash values in column type.
+static bool is_bound_column(const ast::Fact* fact, const ast::Func* func, uint32_t column)
+{
+    const ast::Var* var = as_Var(func->args[column]);
+    return !var || (!var->binding && var->data_type == fact->params[column]->data_type);
+}
+
+// true if the fact has a hash index with all columns bound in `func`.
+static bool has_bound_index(const ast::Fact* fact, const ast::Func* func)
+{
+    for (uint32_t attr_idx = 0; attr_idx < size(fact->attrs); ++attr_idx)
+    {
+        ast::Attribute* attr = fact->attrs[attr_idx];
+        if (!is_Index(attr))
+            continue;
+
+        bool all_bound = true;
+        for (uint32_t arg_idx = 0; arg_idx < size(attr->args); ++arg_idx)
+            all_bound &= is_bound_column(fact, func, uint32_t(as_int(as_Literal(attr->args[arg_idx]))));
+
+        if (all_bound)
+            return true;
+    }
+
+    return false;
+}
+
+// declares a hash index over the bound columns of negated fact literals without a usable `:index`,
+// so the negation probes the index for a matching entry instead of scanning the table.
+static void declare_negation_indexes(ast::Root* tree, ast::Case* case_)
+{
+    ast::Expr* precond = case_->precond;
+    for (ast::Expr* node = precond; node != 0; node = preorder_next(precond, node))
+    {
+        if (!is_Not(node))
+            continue;
+
+        ast::Func* func = as_Func(node->child);
+        ast::Fact* fact = func ? get_fact(tree, func->name) : 0;
+        if (!fact || has_bound_index(fact, func))
+            continue;
+
+        uint32_t num_indexes = 0;
+        for (uint32_t attr_idx = 0; attr_idx < size(fact->attrs); ++attr_idx)
+            num_indexes += is_Index(fact->attrs[attr_idx]) ? 1 : 0;
+
+        if (num_indexes >= plnnr::Max_Fact_Indexes)
+            continue;
+
+        ast::Attribute* attr = 0;
+        for (uint32_t column = 0; column < size(func->args); ++column)
+        {
+            if (!is_bound_column(fact, func, column))
+                continue;
+
+            if (!attr)
+            {
+                const Token_Value name = { 6, ":index" };
+                attr = create_attribute(tree, name, node->loc);
+                attr->attr_type = Attribute_Index;
+                init(attr->args, tree->pool, size(func->args));
+            }
+
+            // column number literal, fact arity is less than 10.
+            char* digits = allocate<char>(tree->pool, 2);
+            digits[0] = char('0' + column);
+            digits[1] = 0;
+
+            Token token;
+            token.type = Token_Literal_Integer;
+            token.value.str = digits;
+            token.value.length = 1;
+            push_back(attr->args, static_cast<ast::Expr*>(create_literal(tree, token, node->loc)));
+        }
+
+        if (!attr)
+            continue;
+
+        if (!fact->attrs.memory)
+            init(fact->attrs, tree->pool, 1);
+
+        push_back(fact->attrs, attr);
+    }
+}
+
+void plnnrc::optimize_preconditions(ast::Root* tree)
+{
+    for (uint32_t case_idx = 0; case_idx < size(tree->cases); ++case_idx)
+    {
+        ast::Case* case_ = tree->cases[case_idx];
+        const bool unordered = find_attribute(case_, Attribute_Unordered) != 0;
+        bool reordered = false;
+
+        fold_constants(tree, case_->precond);
+
+        for (uint32_t task_idx = 0; task_idx < size(case_->task_list); ++task_idx)
+            fold_constants(tree, case_->task_list[task_idx]);
+
+        declare_negation_indexes(tree, case_);
+
+        // literals of `:factorized` preconditions are kept in the source order, nested disjunctions are generated in place.
+        if (find_attribute(case_, Attribute_Factorized))
+            continue;
+
+        for (ast::Expr* conjunct = case_->precond->child; conjunct != 0; conjunct = conjunct->next_sibling)
+        {
+            if (!is_And(conjunct))
+                continue;
+
+            // facts can be reordered only if the order of the results doesn't matter.
+            if (unordered)
+                reordered |= reorder_facts(tree, conjunct);
+
+            hoist_filters(tree, conjunct);
+        }
+
+        if (reordered)
+            rebind_precond_vars(tree, case_);
+
+        // `:sorted` cases copy each result to a new bindings slot, so the values computed before the loops are not available there.
+        if (find_attribute(case_, Attribute_Sorted))
+            continue;
+
+        // subexpressions of filters which don't depend on the inner loops are assigned to hidden variables stored in the frame bindings.
+        for (ast::Expr* conjunct = case_->precond->child; conjunct != 0; conjunct = conjunct->next_sibling)
+        {
+            if (!is_And(conjunct))
+                continue;
+
+            for (ast::Expr* literal = conjunct->child; literal != 0; literal = literal->next_sibling)
+            {
+                ast::Expr* expr = is_Not(literal) ? literal->child : literal;
+                if (!is_fact_literal(tree, expr))
+                    hoist_invariants(tree, case_, conjunct, literal, is_Assign(expr) ? expr->child->next_sibling : expr);
+            }
+
+            hoist_filters(tree, conjunct);
+        }
+    }
+}
+
+struct Attribute_Args_Spec
+{
+    Attribute_Arg_Class classes[2];
+};
+
+static const Attribute_Args_Spec s_attribute_specs[] =
+{
+    { { } },
+    #define PLNNRC_ATTRIBUTE(TAG, STR) { {
+    #define PLNNRC_ATTRIBUTE_ARG(TYPE) Attribute_Arg_##TYPE,
+    #define PLNNRC_ATTRIBUTE_END } },
+    #include "derplanner/compiler/attribute_tags.inl"
+    #undef PLNNRC_ATTRIBUTE_END
+    #undef PLNNRC_ATTRIBUTE_ARG
+    #undef PLNNRC_ATTRIBUTE
+};
+
+static const uint32_t s_attribute_arg_count[] =
+{
+    0,
+    #define PLNNRC_ATTRIBUTE(TAG, STR) (0
+    #define PLNNRC_ATTRIBUTE_ARG(TYPE) +1
+    #define PLNNRC_ATTRIBUTE_END ),
+    #include "derplanner/compiler/attribute_tags.inl"
+    #undef PLNNRC_ATTRIBUTE_END
+    #undef PLNNRC_ATTRIBUTE_ARG
+    #undef PLNNRC_ATTRIBUTE
+};
+
+static const bool s_attribute_has_arg_list[] =
+{
+    false,
+    #define PLNNRC_ATTRIBUTE(TAG, STR) (false
+    #define PLNNRC_ATTRIBUTE_ARG_LIST(TYPE) || true
+    #define PLNNRC_ATTRIBUTE_END ),
+    #include "derplanner/compiler/attribute_tags.inl"
+    #undef PLNNRC_ATTRIBUTE_END
+    #undef PLNNRC_ATTRIBUTE_ARG_LIST
+    #undef PLNNRC_ATTRIBUTE
+};
+
+static const bool s_attribute_is_repeatable[] =
+{
+    false,
+    #define PLNNRC_ATTRIBUTE(TAG, STR) (false
+    #define PLNNRC_ATTRIBUTE_REPEATABLE || true
+    #define PLNNRC_ATTRIBUTE_END ),
+    #include "derplanner/compiler/attribute_tags.inl"
+    #undef PLNNRC_ATTRIBUTE_END
+    #undef PLNNRC_ATTRIBUTE_REPEATABLE
+    #undef PLNNRC_ATTRIBUTE
+};
+
+uint32_t plnnrc::get_num_args(Attribute_Type type)
+{
+    if (type >= Attribute_Count)
+        return 0;
+
+    return s_attribute_arg_count[type];
+}
+
+const Attribute_Arg_Class* plnnrc::get_arg_classes(Attribute_Type type)
+{
+    if (type >= Attribute_Count)
+        return 0;
+
+    return s_attribute_specs[type].classes;
+}
+
+bool plnnrc::has_arg_list(Attribute_Type type)
+{
+    if (type >= Attribute_Count)
+        return false;
+
+    return s_attribute_has_arg_list[type];
+}
+
+bool plnnrc::is_repeatable(Attribute_Type type)
+{
+    if (type >= Attribute_Count)
+        return false;
+
+    return s_attribute_is_repeatable[type];
 }
 
 static const char* s_node_type_names[] =
@@ -2430,7 +3322,7 @@ struct Debug_Output_Visitor
 
     void visit(const ast::Macro* node) { print_named(node); print_children(node->params); print_expr(node->expression); }
 
-    void visit(const ast::Task* node) { print_named(node); print_children(node->params); print_children(node->macros); print_children(node->cases); }
+    void visit(const ast::Task* node) { print_named(node); print_children(node->params); print_children(node->attrs); print_children(node->macros); print_children(node->cases); }
 
     void visit(const ast::Case* node) { print(node); print_children(node->attrs); print_expr(node->precond); print_children(node->task_list); }
 
@@ -61,6 +61,26 @@ void plnnrc::generate_header(Codegen* self, const char* header_guard, Writer* ou
     writeln(fmtr, "#define PLNNR_DOMAIN_API");
     writeln(fmtr, "#endif");
     newline(fmtr);
+    // fact table ids.
+    {
+        ast::World* world = tree->world;
+        writeln(fmtr, "// fact table ids, match table indices of `Fact_Database` created from `database_req`.");
+        writeln(fmtr, "enum %n_Fact_Id", domain_name);
+        writeln(fmtr, "{");
+        for (uint32_t fact_idx = 0; fact_idx < size(world->facts); ++fact_idx)
+        {
+            Indent_Scope s(fmtr);
+            ast::Fact* fact = world->facts[fact_idx];
+            writeln(fmtr, "%n_fact_%n = %d,", domain_name, fact->name, fact_idx);
+        }
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "%n_num_facts = %d", domain_name, size(world->facts));
+        }
+        writeln(fmtr, "};");
+        newline(fmtr);
+    }
+
     writeln(fmtr, "extern \"C\" PLNNR_DOMAIN_API void %n_init_domain_info();", domain_name);
     writeln(fmtr, "extern \"C\" PLNNR_DOMAIN_API const plnnr::Domain_Info* %n_get_domain_info();", domain_name);
     newline(fmtr);
@@ -70,9 +90,14 @@ void plnnrc::generate_header(Codegen* self, const char* header_guard, Writer* ou
 
 static void generate_precondition(Codegen* self, uint32_t case_idx, Formatter& fmtr);
 static void generate_comparator(Codegen* self, ast::Expr* key_expr, Token_Type key_type, bool has_args, uint32_t case_index, uint32_t struct_index, uint32_t output_index, Formatter& fmtr);
+static void generate_distinct(Codegen* self, uint32_t case_index, uint32_t output_index, Formatter& fmtr);
+static void generate_row_filter(Codegen* self, ast::Expr* literal, bool has_args, bool has_output, uint32_t case_index, uint32_t filter_index, uint32_t struct_index, uint32_t output_index, Formatter& fmtr);
 static void generate_empty_expansion(Codegen* self, ast::Task* task, Formatter& fmtr);
+struct Branch_Scope;
+struct Row_Scan;
 static void generate_expansion(Codegen* self, ast::Case* case_, uint32_t case_idx, Formatter& fmtr);
-static void generate_conjunct(Codegen* self, ast::Case* case_, ast::Expr* literal, uint32_t& handle_id, uint32_t& yield_id, bool store_binds, uint32_t case_index, uint32_t output_index, Formatter& fmtr);
+static void generate_conjunct(Codegen* self, ast::Case* case_, ast::Expr* literal, const Branch_Scope* branch, const Row_Scan* scans, uint32_t& handle_id, uint32_t& filter_id, uint32_t& yield_id, bool store_binds, uint32_t case_index, uint32_t output_index, Formatter& fmtr);
+static void write_frame_reload(Codegen* self, ast::Case* case_, Formatter& fmtr);
 
 static const char* s_runtime_type_tag[] =
 {
@@ -332,212 +357,915 @@ static bool build_hashes(const Array<Token_Value>& names, Array<uint32_t>& out_h
     return false;
 }
 
-struct Expr_Writer
+static uint32_t get_num_indexes(const ast::Fact* fact)
 {
-    Formatter* fmtr;
-    ast::Root* tree;
+    uint32_t result = 0;
+    for (uint32_t attr_idx = 0; attr_idx < size(fact->attrs); ++attr_idx)
+    {
+        if (is_Index(fact->attrs[attr_idx]) || is_Ordered(fact->attrs[attr_idx]))
+            ++result;
+    }
 
-    void visit(const ast::Var* node)
+    return result;
+}
+
+static uint32_t get_index_column(const ast::Attribute* attr, uint32_t arg_idx)
+{
+    const ast::Literal* literal = as_Literal(attr->args[arg_idx]);
+    plnnrc_assert(literal);
+    return uint32_t(as_int(literal));
+}
+
+// true if the value of fact argument is known before iterating the fact table, e.g. bound variable or expression.
+static bool is_bound_arg(const ast::Fact* fact, const ast::Func* func, uint32_t arg_idx)
+{
+    const ast::Expr* arg = func->args[arg_idx];
+    const ast::Var* var = as_Var(arg);
+
+    if (!var)
+        return true;
+
+    // index probes hash values in column type, so the variable type must match it exactly.
+    return !var->binding && var->data_type == fact->params[arg_idx]->data_type;
+}
+
+// finds the declared `:index` with the largest number of columns, where all columns are bound in the `func` literal.
+static ast::Attribute* find_probe_index(const ast::Fact* fact, const ast::Func* func, uint32_t& out_index)
+{
+    ast::Attribute* result = 0;
+    uint32_t index = 0;
+
+    for (uint32_t attr_idx = 0; attr_idx < size(fact->attrs); ++attr_idx)
     {
-        // the variable is an assignment target.
-        if (!node->definition)
-        {
-            write(*fmtr, "binds->_%d", node->output_index);
-            return;
-        }
+        ast::Attribute* attr = fact->attrs[attr_idx];
+        if (!is_Index(attr))
+            continue;
 
-        if (is_Param(node->definition))
+        bool all_bound = true;
+        for (uint32_t arg_idx = 0; arg_idx < size(attr->args); ++arg_idx)
         {
-            write(*fmtr, "args->_%d", node->input_index);
-            return;
+            if (!is_bound_arg(fact, func, get_index_column(attr, arg_idx)))
+            {
+                all_bound = false;
+                break;
+            }
         }
 
-        if (is_Var(node->definition))
+        if (all_bound && (!result || size(attr->args) > size(result->args)))
         {
-            write(*fmtr, "binds->_%d", node->output_index);
-            return;
+            result = attr;
+            out_index = index;
         }
 
-        plnnrc_assert(false);
+        ++index;
     }
 
-    void visit(const ast::Literal* node)
+    return result;
+}
+
+// range iteration over an ordered index.
+struct Range_Probe
+{
+    // index of the ordered index among the fact `:ordered` attributes.
+    uint32_t        index;
+    // runtime `Range_Op` of the comparison, with the indexed column on the left side.
+    const char*     op;
+    // value expression the indexed column is compared to.
+    ast::Expr*      value;
+};
+
+// true if all variables in `expr` are bound by parameters or by the conjunct literals preceding `literal`.
+static bool is_bound_before(ast::Expr* literal, ast::Expr* expr)
+{
+    for (ast::Expr* node = expr; node != 0; node = preorder_next(expr, node))
     {
-        if (is_Literal_Fact(node->value_type))
-        {
-            ast::Fact* fact = get_fact(tree, node->value);
-            plnnrc_assert(fact);
-            const uint32_t fact_idx = index_of(tree->world->facts, fact);
-            write(*fmtr, "db->tables + %d", fact_idx);
-        }
-        else
+        ast::Var* var = as_Var(node);
+        if (!var || is_Param(var->definition))
+            continue;
+
+        // literals of the conjunctions enclosing the nested disjunction alternative precede it too.
+        bool found = false;
+        for (ast::Expr* scope = literal; scope->parent != 0 && !found; scope = scope->parent)
         {
-            write(*fmtr, "%n", node->value);
+            if (!is_And(scope->parent))
+                continue;
+
+            for (ast::Expr* prev = scope->parent->child; prev != scope && !found; prev = prev->next_sibling)
+            {
+                for (ast::Expr* prev_node = prev; prev_node != 0; prev_node = preorder_next(prev, prev_node))
+                {
+                    ast::Var* prev_var = as_Var(prev_node);
+                    if (prev_var && prev_var->binding && equal(prev_var->name, var->name))
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+            }
         }
+
+        if (!found)
+            return false;
     }
 
-    const char* get_op_str(ast::Node_Type node_type)
+    return true;
+}
+
+// finds the first argument known before iterating the fact table, with the column type supported by `first_equal`.
+static bool find_scan_column(const ast::Fact* fact, ast::Expr* literal, uint32_t& out_column)
+{
+    const ast::Func* func = as_Func(literal);
+
+    for (uint32_t arg_idx = 0; arg_idx < size(func->args); ++arg_idx)
     {
-        switch (node_type)
+        const Token_Type type = fact->params[arg_idx]->data_type;
+        const bool scannable = type == Token_Id32 || type == Token_Id64 || type == Token_Int8 || type == Token_Int32 || type == Token_Int64;
+
+        // expressions may refer to the variables bound by the literal itself.
+        if (scannable && is_bound_arg(fact, func, arg_idx) && is_bound_before(literal, func->args[arg_idx]))
         {
-        case ast::Node_Or: return "||";
-        case ast::Node_And: return "&&";
-        case ast::Node_Not: return "!";
-        case ast::Node_Assign: return "=";
-        case ast::Node_Equal: return "==";
-        case ast::Node_NotEqual: return "!=";
-        case ast::Node_Less: return "<";
-        case ast::Node_LessEqual: return "<=";
-        case ast::Node_Greater: return ">";
-        case ast::Node_GreaterEqual: return ">=";
-        case ast::Node_Plus: return "+";
-        case ast::Node_Minus: return "-";
-        case ast::Node_Mul: return "*";
-        case ast::Node_Div: return "/";
-        default:
-            plnnrc_assert(false);
-            return "";
+            out_column = arg_idx;
+            return true;
         }
     }
 
-    void visit(const ast::Op* node)
+    return false;
+}
+
+// finds a comparison following the fact `literal` in the conjunct, which compares a variable bound by `literal`
+// in the column with `:ordered` index to the value known before iterating the fact table.
+static bool find_range_probe(const ast::Fact* fact, ast::Expr* literal, Range_Probe& out_probe)
+{
+    ast::Func* func = as_Func(literal);
+    ast::Expr* conjunct = literal->parent;
+
+    if (!func || !conjunct || !is_And(conjunct))
+        return false;
+
+    uint32_t index = 0;
+    for (uint32_t attr_idx = 0; attr_idx < size(fact->attrs); ++attr_idx)
     {
-        const char* op = get_op_str(node->type);
-        plnnrc_assert(node->child);
+        ast::Attribute* attr = fact->attrs[attr_idx];
+        if (!is_Ordered(attr))
+            continue;
 
-        // unary
-        if (!node->child->next_sibling)
-        {
-            plnnrc_assert(is_Plus(node) || is_Minus(node) || is_Not(node));
-            write(*fmtr, "%s", op);
-            write(*fmtr, "(");
-            visit_node<void>(node->child, this);
-            write(*fmtr, ")");
-        }
-        // binary
-        else
+        const uint32_t column = get_index_column(attr, 0);
+        ast::Var* column_var = as_Var(func->args[column]);
+
+        if (column_var && column_var->binding && column_var->data_type == fact->params[column]->data_type)
         {
-            write(*fmtr, "(");
-            for (ast::Expr* arg = node->child; arg != 0; arg = arg->next_sibling)
+            for (ast::Expr* cmp = literal->next_sibling; cmp != 0; cmp = cmp->next_sibling)
             {
-                visit_node<void>(arg, this);
-                if (arg->next_sibling != 0)
-                    write(*fmtr, " %s ", op);
-            }
-            write(*fmtr, ")");
-        }
-    }
+                if (!is_Less(cmp) && !is_LessEqual(cmp) && !is_Greater(cmp) && !is_GreaterEqual(cmp))
+                    continue;
 
-    void visit(const ast::Func* func)
-    {
-        const Signature sig = get_params_signature(tree->functions, func->signature_index);
-        plnnrc_assert(sig.length == size(func->args));
+                ast::Expr* lhs = cmp->child;
+                ast::Expr* rhs = lhs->next_sibling;
+                ast::Var* lhs_var = as_Var(lhs);
+                ast::Var* rhs_var = as_Var(rhs);
+                const bool on_left = lhs_var && equal(lhs_var->name, column_var->name);
+                const bool on_right = rhs_var && equal(rhs_var->name, column_var->name);
 
-        write(*fmtr, "plnnr::%n(", func->name);
-        for (uint32_t arg_idx = 0; arg_idx < size(func->args); ++arg_idx)
-        {
-            const ast::Expr* arg = func->args[arg_idx];
-            const Token_Type param_type = sig.types[arg_idx];
+                if (on_left == on_right)
+                    continue;
 
-            write(*fmtr, "%s(", get_runtime_type_name(param_type));
-            visit_node<void>(arg, this);
-            write(*fmtr, ")");
+                ast::Expr* value = on_left ? rhs : lhs;
+                if (!is_bound_before(literal, value))
+                    continue;
 
-            if (arg->next_sibling != 0)
-                write(*fmtr, ", ");
+                // normalize to `column <op> value`.
+                const bool less = is_Less(cmp) || is_LessEqual(cmp);
+                const bool strict = is_Less(cmp) || is_Greater(cmp);
+                if (less == on_left)
+                    out_probe.op = strict ? "Range_Less" : "Range_Less_Equal";
+                else
+                    out_probe.op = strict ? "Range_Greater" : "Range_Greater_Equal";
+
+                out_probe.index = index;
+                out_probe.value = value;
+                return true;
+            }
         }
-        write(*fmtr, ")");
+
+        ++index;
     }
 
-    void visit(const ast::Node*) { plnnrc_assert(false); }
-};
+    return false;
+}
 
-void plnnrc::generate_source(Codegen* self, const char* domain_header, Writer* output)
+// returns the index of the argument binding the variable `var` in the fact literal `func`, or `func` arity if it's not bound by `func`.
+static uint32_t find_row_column(const ast::Func* func, const ast::Var* var)
 {
-    Memory_Stack_Scope scratch_scope(self->scratch);
+    for (uint32_t arg_idx = 0; arg_idx < size(func->args); ++arg_idx)
+    {
+        const ast::Var* arg_var = as_Var(func->args[arg_idx]);
+        if (arg_var && arg_var->binding && equal(arg_var->name, var->name))
+            return arg_idx;
+    }
 
-    Formatter fmtr;
-    init(fmtr, "  ", "\n", output);
+    return size(func->args);
+}
 
-    ast::Root* tree = self->tree;
-    ast::World* world = tree->world;
-    ast::Primitive* prim = tree->primitive;
-    ast::Domain* domain = tree->domain;
+// true if the expression `filter` following the fact `literal` depends only on the variables bound by `literal`
+// and the values known before iterating the fact table, so it can be evaluated for a block of fact table rows.
+static bool is_row_filter(ast::Root* tree, ast::Expr* literal, ast::Expr* filter)
+{
+    ast::Func* func = as_Func(literal);
+    ast::Expr* expr = is_Not(filter) ? filter->child : filter;
 
-    init(self->expand_names, self->scratch, 64, 4096);
-    init(self->task_and_binding_sigs, self->scratch, size(prim->tasks) + size(domain->tasks) + size(tree->cases));
-    init(self->struct_sigs, self->scratch, size(domain->tasks) + size(tree->cases));
+    // nested disjunctions of `:factorized` preconditions are not single expressions.
+    if (is_Assign(expr) || is_Logical(expr))
+        return false;
 
-    // includes & pragmas
+    if (ast::Func* filter_func = as_Func(expr))
     {
-        writeln(fmtr, "// generated by derplanner [http://www.github.com/alexshafranov/derplanner]");
-        writeln(fmtr, "#include \"derplanner/runtime/domain.h\"");
-        writeln(fmtr, "#include \"%s\"", domain_header);
-        newline(fmtr);
-        writeln(fmtr, "using namespace plnnr;");
-        newline(fmtr);
-        writeln(fmtr, "#ifdef __GNUC__");
-        writeln(fmtr, "#pragma GCC diagnostic ignored \"-Wunused-parameter\"");
-        writeln(fmtr, "#pragma GCC diagnostic ignored \"-Wunused-variable\"");
-        writeln(fmtr, "#endif");
-        newline(fmtr);
-        writeln(fmtr, "#ifdef _MSC_VER");
-        writeln(fmtr, "#pragma warning(disable: 4100) // unreferenced formal parameter");
-        writeln(fmtr, "#pragma warning(disable: 4189) // local variable is initialized but not referenced");
-        writeln(fmtr, "#endif");
-        newline(fmtr);
+        if (get_fact(tree, filter_func->name))
+            return false;
     }
 
-    build_expand_names(self->expand_names, domain);
-
-    // expand forward declarations
+    bool depends_on_row = false;
+    for (ast::Expr* node = expr; node != 0; node = preorder_next(expr, node))
     {
-        for (uint32_t case_idx = 0; case_idx < size(self->expand_names); ++case_idx)
+        if (ast::Literal* value = as_Literal(node))
         {
-            Token_Value name = get(self->expand_names, case_idx);
-            writeln(fmtr, "static bool %n(Planning_State*, Expansion_Frame*, Fact_Database*);", name);
+            // fact table references need the database.
+            if (is_Literal_Fact(value->value_type))
+                return false;
         }
 
-        // tasks with no cases
-        for (uint32_t task_idx = 0; task_idx < size(domain->tasks); ++task_idx)
+        ast::Var* var = as_Var(node);
+        if (!var)
+            continue;
+
+        if (!var->definition)
+            return false;
+
+        if (find_row_column(func, var) < size(func->args))
         {
-            ast::Task* task = domain->tasks[task_idx];
-            if (empty(task->cases))
-            {
-                writeln(fmtr, "static bool %n_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);", task->name);
-            }
+            depends_on_row = true;
+            continue;
         }
 
-        newline(fmtr);
+        if (!is_bound_before(literal, var))
+            return false;
     }
 
-    // s_task_expands
+    return depends_on_row;
+}
+
+// true if the fact `literal` is iterated with `first_filtered`: it's a full table scan and there's a row filter following it.
+static bool has_row_filter(ast::Root* tree, const ast::Fact* fact, ast::Expr* literal)
+{
+    ast::Func* func = as_Func(literal);
+    uint32_t probe_index = 0;
+    uint32_t scan_column = 0;
+    Range_Probe probe;
+
+    if (!func || !literal->parent || !is_And(literal->parent))
+        return false;
+
+    if (find_probe_index(fact, func, probe_index) || find_range_probe(fact, literal, probe) || find_scan_column(fact, literal, scan_column))
+        return false;
+
+    for (ast::Expr* filter = literal->next_sibling; filter != 0; filter = filter->next_sibling)
     {
-        writeln(fmtr, "static Compound_Task_Expand* s_task_expands[] = {");
-        for (uint32_t task_idx = 0; task_idx < size(domain->tasks); ++task_idx)
-        {
-            ast::Task* task = domain->tasks[task_idx];
-            Indent_Scope s(fmtr);
-            writeln(fmtr, "%n_case_0,", task->name);
-        }
+        if (is_row_filter(tree, literal, filter))
+            return true;
+    }
 
-        if (empty(domain->tasks))
+    return false;
+}
+
+// true if the variable `name` occurs in `expr`, skipping the `excluded` subtree.
+static bool has_var_outside(const ast::Expr* expr, const ast::Expr* excluded, const Token_Value& name)
+{
+    for (const ast::Expr* node = expr; node != 0; node = preorder_next(expr, node))
+    {
+        if (node == excluded)
         {
-            Indent_Scope s(fmtr);
-            writeln(fmtr, "0");
+            // skip the subtree.
+            const ast::Expr* last = node;
+            while (last->child)
+                last = last->child->prev_sibling_cyclic;
+
+            node = last;
+            continue;
         }
-        writeln(fmtr, "};");
-        newline(fmtr);
+
+        const ast::Var* var = as_Var(node);
+        if (var && equal(var->name, name))
+            return true;
     }
 
-    // s_fact_names
+    return false;
+}
+
+// true if the fact literal of the `case` only checks existence: bindings it creates are not used by the rest of the conjunct or the task list.
+// the following literals then behave the same for every matching entry, so the first one is enough.
+static bool is_existence_check(Codegen* self, ast::Case* case_, ast::Expr* literal)
+{
+    // `each` expands every satisfier, duplicates included.
+    if (case_->foreach || is_Not(literal))
+        return false;
+
+    ast::Func* func = as_Func(literal);
+    if (!func || !get_fact(self->tree, func->name))
+        return false;
+
+    ast::Expr* conjunct = literal;
+    while (conjunct->parent != case_->precond)
+        conjunct = conjunct->parent;
+
+    ast::Attribute* attr_sorted = find_attribute(case_, Attribute_Sorted);
+
+    for (uint32_t arg_idx = 0; arg_idx < size(func->args); ++arg_idx)
     {
-        writeln(fmtr, "static const char* s_fact_names[] = {");
-        for (uint32_t fact_idx = 0; fact_idx < size(world->facts); ++fact_idx)
+        ast::Var* var = as_Var(func->args[arg_idx]);
+        if (!var || !var->binding)
+            continue;
+
+        if (has_var_outside(conjunct, literal, var->name))
+            return false;
+
+        if (attr_sorted && has_var_outside(attr_sorted->args[0], 0, var->name))
+            return false;
+
+        for (uint32_t item_idx = 0; item_idx < size(case_->task_list); ++item_idx)
         {
-            Indent_Scope s(fmtr);
-            ast::Fact* fact = world->facts[fact_idx];
-            writeln(fmtr, "\"%n\",", fact->name);
+            if (has_var_outside(case_->task_list[item_idx], 0, var->name))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+enum { Max_Join_Orders = 3 };
+
+// true if all variables of the expression are task parameters.
+static bool has_only_param_vars(ast::Expr* expr)
+{
+    for (ast::Expr* node = expr; node != 0; node = preorder_next(expr, node))
+    {
+        ast::Var* var = as_Var(node);
+        if (var && !as_Param(var->definition))
+            return false;
+    }
+
+    return true;
+}
+
+// true if the non-variable arguments of the fact literal depend only on the task parameters, i.e. the literal can lead the conjunct.
+static bool has_only_param_args(const ast::Func* func)
+{
+    for (uint32_t arg_idx = 0; arg_idx < size(func->args); ++arg_idx)
+    {
+        ast::Expr* arg = func->args[arg_idx];
+        if (!is_Var(arg) && !has_only_param_vars(arg))
+            return false;
+    }
+
+    return true;
+}
+
+// true if `fact` is joined by an `:unordered` case, its table keeps the distinct values statistics for the join order estimates.
+static bool has_unordered_join(ast::Root* tree, ast::Fact* fact)
+{
+    for (uint32_t case_idx = 0; case_idx < size(tree->cases); ++case_idx)
+    {
+        ast::Case* case_ = tree->cases[case_idx];
+        if (!find_attribute(case_, Attribute_Unordered))
+            continue;
+
+        for (ast::Expr* node = case_->precond; node != 0; node = preorder_next(case_->precond, node))
+        {
+            ast::Func* func = as_Func(node);
+            if (func && get_fact(tree, func->name) == fact)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// join orders of the `:unordered` case conjunct: fact literals which may be moved to the front of the conjunct, followed by null for the source order.
+// `out_first` is the fact literal iterated first in the source order. returns the number of orders.
+static uint32_t find_join_orders(ast::Root* tree, ast::Case* case_, ast::Expr* conjunct, ast::Expr*& out_first, ast::Expr** out_leading)
+{
+    uint32_t count = 0;
+    out_first = 0;
+
+    // rebinding variables of the reordered conjunct doesn't handle the nested disjunctions of `:factorized` cases.
+    if (find_attribute(case_, Attribute_Unordered) && !find_attribute(case_, Attribute_Factorized) && is_And(conjunct))
+    {
+        for (ast::Expr* literal = conjunct->child; literal != 0; literal = literal->next_sibling)
+        {
+            // values computed from the parameters only don't depend on the order.
+            if (is_Assign(literal) && has_only_param_vars(literal->child->next_sibling))
+                continue;
+
+            // moving a fact over negations and assignments changes what they mean.
+            if (is_Not(literal) || is_Assign(literal))
+                break;
+
+            ast::Func* func = as_Func(literal);
+            if (!func || !get_fact(tree, func->name))
+                continue;
+
+            if (!out_first)
+            {
+                out_first = literal;
+                continue;
+            }
+
+            if (count < Max_Join_Orders - 1 && has_only_param_args(func))
+                out_leading[count++] = literal;
+        }
+    }
+
+    out_leading[count++] = 0;
+    return count;
+}
+
+// binding state of the conjunct variable, saved while generating an alternative join order.
+struct Var_Binding
+{
+    ast::Var*   var;
+    ast::Node*  definition;
+    uint8_t     binding;
+};
+
+// moves `leading` to the front of the conjunct and makes the first occurrence of each variable in the new order binding.
+// returns the literal preceding `leading` in the source order.
+static ast::Expr* apply_join_order(ast::Root* tree, ast::Case* case_, ast::Expr* conjunct, ast::Expr* leading, Array<Var_Binding>& saved)
+{
+    ast::Expr* prev = leading->prev_sibling_cyclic;
+    unparent(leading);
+
+    prepend_child(conjunct, leading);
+
+    Id_Table<ast::Var*> bindings;
+    init(bindings, tree->scratch, size(case_->precond_vars));
+
+    for (ast::Expr* node = conjunct->child; node != 0; node = preorder_next(conjunct, node))
+    {
+        ast::Var* var = as_Var(node);
+        if (!var || (var->definition && is_Param(var->definition)))
+            continue;
+
+        Var_Binding state = { var, var->definition, var->binding };
+        push_back(saved, state);
+
+        ast::Var* binding = get(bindings, var->name);
+        var->binding = (binding == 0);
+
+        if (!binding)
+            set(bindings, var->name, var);
+        // the first occurrence in the precondition is no longer binding -> refer to the new binding.
+        else if (!var->definition)
+            var->definition = binding;
+    }
+
+    return prev;
+}
+
+// restores the source order after `apply_join_order`.
+static void revert_join_order(ast::Expr* leading, ast::Expr* prev, const Array<Var_Binding>& saved)
+{
+    for (uint32_t idx = 0; idx < size(saved); ++idx)
+    {
+        saved[idx].var->definition = saved[idx].definition;
+        saved[idx].var->binding = saved[idx].binding;
+    }
+
+    unparent(leading);
+    insert_child(prev, leading);
+}
+
+// calls `visitor(literal)` for each literal of the conjunction, nested disjunctions are visited before their alternatives.
+template <typename Visitor>
+static void visit_literals(ast::Expr* conjunct, Visitor& visitor)
+{
+    for (ast::Expr* literal = conjunct->child; literal != 0; literal = literal->next_sibling)
+    {
+        visitor(literal);
+
+        if (!is_Or(literal))
+            continue;
+
+        for (ast::Expr* alternative = literal->child; alternative != 0; alternative = alternative->next_sibling)
+        {
+            if (is_And(alternative))
+                visit_literals(alternative, visitor);
+            else
+                visitor(alternative);
+        }
+    }
+}
+
+// calls `visitor(literal)` for each literal of the conjunct in each of its join orders, in the order they are generated.
+template <typename Visitor>
+static void for_each_join_order(ast::Root* tree, ast::Case* case_, ast::Expr* conjunct, Visitor& visitor)
+{
+    ast::Expr* first = 0;
+    ast::Expr* leading[Max_Join_Orders];
+    const uint32_t num_orders = find_join_orders(tree, case_, conjunct, first, leading);
+
+    for (uint32_t order_idx = 0; order_idx < num_orders; ++order_idx)
+    {
+        Memory_Stack_Scope scratch_scope(tree->scratch);
+        Array<Var_Binding> saved;
+        ast::Expr* prev = 0;
+
+        if (leading[order_idx])
+        {
+            init(saved, tree->scratch, size(case_->precond_vars));
+            prev = apply_join_order(tree, case_, conjunct, leading[order_idx], saved);
+        }
+
+        visitor.begin_order();
+        visit_literals(conjunct, visitor);
+
+        if (leading[order_idx])
+            revert_join_order(leading[order_idx], prev, saved);
+    }
+}
+
+// counts extra fact handles of a conjunct: a cursor per range iteration, a mask per row filter and an alternative index per nested disjunction,
+// the maximum over join orders.
+struct Extra_Handle_Counter
+{
+    ast::Root* tree;
+    uint32_t count;
+    uint32_t max_count;
+
+    void begin_order()
+    {
+        count = 0;
+    }
+
+    void operator()(ast::Expr* literal)
+    {
+        ast::Func* func = as_Func(literal);
+        ast::Fact* fact = func ? get_fact(tree, func->name) : 0;
+        uint32_t probe_index = 0;
+        Range_Probe probe;
+
+        if (is_Or(literal))
+            ++count;
+        else if (fact && !find_probe_index(fact, func, probe_index) && find_range_probe(fact, literal, probe))
+            ++count;
+        else if (fact && has_row_filter(tree, fact, literal))
+            ++count;
+
+        max_count = count > max_count ? count : max_count;
+    }
+};
+
+// true if the case precondition collects all of its bindings before yielding them, see `generate_precondition`.
+static bool collects_bindings(Codegen* self, uint32_t case_idx)
+{
+    ast::Case* case_ = self->tree->cases[case_idx];
+    const uint32_t output_idx = get_dense_index(self->struct_sigs, size(self->tree->domain->tasks) + case_idx);
+    const bool has_output = get_dense(self->struct_sigs, output_idx).length > 0;
+
+    return find_attribute(case_, Attribute_Sorted) || (has_output && find_attribute(case_, Attribute_Distinct));
+}
+
+// writes the fact table indices of the positive fact literals in the case precondition (if `fmtr` is not null), returns their number.
+static uint32_t write_collect_facts(Codegen* self, ast::Case* case_, Formatter* fmtr)
+{
+    uint32_t count = 0;
+    for (ast::Expr* node = case_->precond; node != 0; node = preorder_next(case_->precond, node))
+    {
+        ast::Func* func = as_Func(node);
+        ast::Fact* fact = func ? get_fact(self->tree, func->name) : 0;
+        if (!fact || is_Not(node->parent))
+            continue;
+
+        if (fmtr)
+        {
+            Indent_Scope s(*fmtr);
+            writeln(*fmtr, "%d, // %n", index_of(self->tree->world->facts, fact), fact->name);
+        }
+
+        ++count;
+    }
+
+    return count;
+}
+
+// the number of fact handles used by a case precondition: one per fact literal, a cursor per range iteration, a mask per row filter
+// and an alternative index per nested disjunction.
+static uint32_t get_num_case_handles(ast::Root* tree, ast::Case* case_)
+{
+    uint32_t result = size(case_->precond_facts);
+
+    for (ast::Expr* conjunct = case_->precond->child; conjunct != 0; conjunct = conjunct->next_sibling)
+    {
+        if (!is_And(conjunct))
+            continue;
+
+        Extra_Handle_Counter counter = { tree, 0, 0 };
+        for_each_join_order(tree, case_, conjunct, counter);
+        result += counter.max_count;
+    }
+
+    return result;
+}
+
+// numbers the row filters of a conjunct in all of its join orders.
+template <typename Visitor>
+struct Row_Filter_Visitor
+{
+    ast::Root* tree;
+    Visitor* visitor;
+    uint32_t filter_index;
+
+    void begin_order() {}
+
+    void operator()(ast::Expr* literal)
+    {
+        ast::Func* func = as_Func(literal);
+        ast::Fact* fact = func ? get_fact(tree, func->name) : 0;
+
+        if (fact && has_row_filter(tree, fact, literal))
+            (*visitor)(literal, filter_index++);
+    }
+};
+
+// calls `visitor(literal, filter_index)` for each fact literal of the case precondition iterated with a row filter, in the order they are generated.
+template <typename Visitor>
+static void for_each_row_filter(ast::Root* tree, ast::Case* case_, Visitor& visitor)
+{
+    Row_Filter_Visitor<Visitor> filter_visitor = { tree, &visitor, 0 };
+
+    for (ast::Expr* conjunct = case_->precond->child; conjunct != 0; conjunct = conjunct->next_sibling)
+    {
+        if (!is_And(conjunct))
+            continue;
+
+        for_each_join_order(tree, case_, conjunct, filter_visitor);
+    }
+}
+
+struct Expr_Writer
+{
+    Formatter* fmtr;
+    ast::Root* tree;
+    // fact literal iterated by the row filter, its variables are read from the table columns.
+    const ast::Func* row;
+
+    void visit(const ast::Var* node)
+    {
+        if (row && node->definition && !is_Param(node->definition))
+        {
+            const uint32_t column = find_row_column(row, node);
+            if (column < size(row->args))
+            {
+                const ast::Var* binding = as_Var(row->args[column]);
+                write(*fmtr, "%s(load_row(c%d, i))", get_runtime_type_name(binding->data_type), column);
+                return;
+            }
+        }
+
+        // the variable is an assignment target.
+        if (!node->definition)
+        {
+            write(*fmtr, "binds->_%d", node->output_index);
+            return;
+        }
+
+        if (is_Param(node->definition))
+        {
+            write(*fmtr, "args->_%d", node->input_index);
+            return;
+        }
+
+        if (is_Var(node->definition))
+        {
+            write(*fmtr, "binds->_%d", node->output_index);
+            return;
+        }
+
+        plnnrc_assert(false);
+    }
+
+    void visit(const ast::Literal* node)
+    {
+        if (is_Literal_Fact(node->value_type))
+        {
+            ast::Fact* fact = get_fact(tree, node->value);
+            plnnrc_assert(fact);
+            const uint32_t fact_idx = index_of(tree->world->facts, fact);
+            write(*fmtr, "db->tables + %d", fact_idx);
+        }
+        else
+        {
+            write(*fmtr, "%n", node->value);
+        }
+    }
+
+    const char* get_op_str(ast::Node_Type node_type)
+    {
+        switch (node_type)
+        {
+        case ast::Node_Or: return "||";
+        case ast::Node_And: return "&&";
+        case ast::Node_Not: return "!";
+        case ast::Node_Assign: return "=";
+        case ast::Node_Equal: return "==";
+        case ast::Node_NotEqual: return "!=";
+        case ast::Node_Less: return "<";
+        case ast::Node_LessEqual: return "<=";
+        case ast::Node_Greater: return ">";
+        case ast::Node_GreaterEqual: return ">=";
+        case ast::Node_Plus: return "+";
+        case ast::Node_Minus: return "-";
+        case ast::Node_Mul: return "*";
+        case ast::Node_Div: return "/";
+        default:
+            plnnrc_assert(false);
+            return "";
+        }
+    }
+
+    void visit(const ast::Op* node)
+    {
+        const char* op = get_op_str(node->type);
+        plnnrc_assert(node->child);
+
+        // unary
+        if (!node->child->next_sibling)
+        {
+            plnnrc_assert(is_Plus(node) || is_Minus(node) || is_Not(node));
+            write(*fmtr, "%s", op);
+            write(*fmtr, "(");
+            visit_node<void>(node->child, this);
+            write(*fmtr, ")");
+        }
+        // binary
+        else
+        {
+            write(*fmtr, "(");
+            for (ast::Expr* arg = node->child; arg != 0; arg = arg->next_sibling)
+            {
+                visit_node<void>(arg, this);
+                if (arg->next_sibling != 0)
+                    write(*fmtr, " %s ", op);
+            }
+            write(*fmtr, ")");
+        }
+    }
+
+    void visit(const ast::Func* func)
+    {
+        const Signature sig = get_params_signature(tree->functions, func->signature_index);
+        plnnrc_assert(sig.length == size(func->args));
+
+        write(*fmtr, "plnnr::%n(", func->name);
+        for (uint32_t arg_idx = 0; arg_idx < size(func->args); ++arg_idx)
+        {
+            const ast::Expr* arg = func->args[arg_idx];
+            const Token_Type param_type = sig.types[arg_idx];
+
+            write(*fmtr, "%s(", get_runtime_type_name(param_type));
+            visit_node<void>(arg, this);
+            write(*fmtr, ")");
+
+            if (arg->next_sibling != 0)
+                write(*fmtr, ", ");
+        }
+        write(*fmtr, ")");
+    }
+
+    void visit(const ast::Node*) { plnnrc_assert(false); }
+};
+
+// writes the value of fact argument known before iterating the fact table (see `is_bound_arg`).
+static void write_bound_arg(Codegen* self, ast::Case* case_, ast::Expr* arg, Formatter& fmtr)
+{
+    if (ast::Var* var = as_Var(arg))
+    {
+        if (ast::Param* param = as_Param(var->definition))
+            write(fmtr, "args->_%d", get(case_->precond_var_lookup, param->name)->input_index);
+        else
+            write(fmtr, "binds->_%d", as_Var(var->definition)->output_index);
+    }
+    else
+    {
+        Expr_Writer visitor = { &fmtr, self->tree };
+        visit_node<void>(arg, &visitor);
+    }
+}
+
+// writes the list of the row filter constructor arguments.
+static void write_row_filter_args(bool has_args, bool has_output, Formatter& fmtr)
+{
+    if (has_args)
+        write(fmtr, has_output ? "args, " : "args");
+
+    if (has_output)
+        write(fmtr, "binds");
+}
+
+void plnnrc::generate_source(Codegen* self, const char* domain_header, Writer* output)
+{
+    Memory_Stack_Scope scratch_scope(self->scratch);
+
+    Formatter fmtr;
+    init(fmtr, "  ", "\n", output);
+
+    ast::Root* tree = self->tree;
+    ast::World* world = tree->world;
+    ast::Primitive* prim = tree->primitive;
+    ast::Domain* domain = tree->domain;
+
+    init(self->expand_names, self->scratch, 64, 4096);
+    init(self->task_and_binding_sigs, self->scratch, size(prim->tasks) + size(domain->tasks) + size(tree->cases));
+    init(self->struct_sigs, self->scratch, size(domain->tasks) + size(tree->cases));
+
+    // includes & pragmas
+    {
+        writeln(fmtr, "// generated by derplanner [http://www.github.com/alexshafranov/derplanner]");
+        writeln(fmtr, "#include \"derplanner/runtime/domain.h\"");
+        writeln(fmtr, "#include \"%s\"", domain_header);
+        newline(fmtr);
+        writeln(fmtr, "using namespace plnnr;");
+        newline(fmtr);
+        writeln(fmtr, "#ifdef __GNUC__");
+        writeln(fmtr, "#pragma GCC diagnostic ignored \"-Wunused-parameter\"");
+        writeln(fmtr, "#pragma GCC diagnostic ignored \"-Wunused-variable\"");
+        writeln(fmtr, "#endif");
+        newline(fmtr);
+        writeln(fmtr, "#ifdef _MSC_VER");
+        writeln(fmtr, "#pragma warning(disable: 4100) // unreferenced formal parameter");
+        writeln(fmtr, "#pragma warning(disable: 4189) // local variable is initialized but not referenced");
+        writeln(fmtr, "#endif");
+        newline(fmtr);
+    }
+
+    build_expand_names(self->expand_names, domain);
+
+    // expand forward declarations
+    {
+        for (uint32_t case_idx = 0; case_idx < size(self->expand_names); ++case_idx)
+        {
+            Token_Value name = get(self->expand_names, case_idx);
+            writeln(fmtr, "static bool %n(Planning_State*, Expansion_Frame*, const Fact_Database*);", name);
+        }
+
+        // tasks with no cases
+        for (uint32_t task_idx = 0; task_idx < size(domain->tasks); ++task_idx)
+        {
+            ast::Task* task = domain->tasks[task_idx];
+            if (empty(task->cases))
+            {
+                writeln(fmtr, "static bool %n_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);", task->name);
+            }
+        }
+
+        newline(fmtr);
+    }
+
+    // precondition forward declarations
+    {
+        for (uint32_t case_idx = 0; case_idx < size(tree->cases); ++case_idx)
+        {
+            writeln(fmtr, "static bool p%d_next(Planning_State*, Expansion_Frame*, const Fact_Database*);", case_idx);
+        }
+
+        if (!empty(tree->cases))
+            newline(fmtr);
+    }
+
+    // s_task_expands
+    {
+        writeln(fmtr, "static Compound_Task_Expand* s_task_expands[] = {");
+        for (uint32_t task_idx = 0; task_idx < size(domain->tasks); ++task_idx)
+        {
+            ast::Task* task = domain->tasks[task_idx];
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "%n_case_0,", task->name);
+        }
+
+        if (empty(domain->tasks))
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "0");
+        }
+        writeln(fmtr, "};");
+        newline(fmtr);
+    }
+
+    // s_fact_names
+    {
+        writeln(fmtr, "static const char* s_fact_names[] = {");
+        for (uint32_t fact_idx = 0; fact_idx < size(world->facts); ++fact_idx)
+        {
+            Indent_Scope s(fmtr);
+            ast::Fact* fact = world->facts[fact_idx];
+            writeln(fmtr, "\"%n\",", fact->name);
         }
 
         if (empty(world->facts))
@@ -612,100 +1340,299 @@ void plnnrc::generate_source(Codegen* self, const char* domain_header, Writer* o
         writeln(fmtr, "static Type s_layout_types[] = {");
         for (uint32_t type_idx = 0; type_idx < size(self->task_and_binding_sigs.types); ++type_idx)
         {
-            Token_Type type = self->task_and_binding_sigs.types[type_idx];
+            Token_Type type = self->task_and_binding_sigs.types[type_idx];
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "%s,", get_runtime_type_enum(type));
+        }
+        writeln(fmtr, "};");
+        newline(fmtr);
+
+        writeln(fmtr, "static size_t s_layout_offsets[%d];", size(self->task_and_binding_sigs.types));
+        newline(fmtr);
+    }
+
+    // s_task_parameters & s_bindings.
+    {
+        struct Format_Param_Layout
+        {
+            void operator()(Formatter& fmtr, Signature_Table& signatures, uint32_t sig_idx)
+            {
+                Signature sig = get_sparse(signatures, sig_idx);
+
+                Indent_Scope s(fmtr);
+                if (sig.length > 0)
+                {
+                    writeln(fmtr, "{ %d, 0, 0, s_layout_types + %d, s_layout_offsets + %d },", sig.length, sig.offset, sig.offset);
+                }
+                else
+                {
+                    writeln(fmtr, "{ 0, 0, 0, 0, 0 },");
+                }
+            }
+        };
+
+        const uint32_t num_tasks = size(prim->tasks) + size(domain->tasks);
+
+        writeln(fmtr, "static Param_Layout s_task_parameters[] = {");
+        for (uint32_t sig_idx = 0; sig_idx < num_tasks; ++sig_idx)
+        {
+            Format_Param_Layout()(fmtr, self->task_and_binding_sigs, sig_idx);
+        }
+
+        if (!num_tasks)
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "{ 0, 0, 0, 0 }");
+        }
+        writeln(fmtr, "};");
+        newline(fmtr);
+
+        writeln(fmtr, "static Param_Layout s_bindings[] = {");
+        for (uint32_t sig_idx = num_tasks; sig_idx < size(self->task_and_binding_sigs.remap); ++sig_idx)
+        {
+            Format_Param_Layout()(fmtr, self->task_and_binding_sigs, sig_idx);
+        }
+
+        if (num_tasks == size(self->task_and_binding_sigs.remap))
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "{ 0, 0, 0, 0 }");
+        }
+        writeln(fmtr, "};");
+        newline(fmtr);
+    }
+
+    // s_num_cases
+    {
+        writeln(fmtr, "static uint32_t s_num_cases[] = {");
+        for (uint32_t task_idx = 0; task_idx < size(domain->tasks); ++task_idx)
+        {
+            ast::Task* task = domain->tasks[task_idx];
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "%d, ", size(task->cases));
+        }
+
+        if (empty(domain->tasks))
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "0");
+        }
+        writeln(fmtr, "};");
+        newline(fmtr);
+    }
+
+    // s_first_case
+    {
+        writeln(fmtr, "static uint32_t s_first_case[] = {");
+        uint32_t first_case = 0;
+        for (uint32_t task_idx = 0; task_idx < size(domain->tasks); ++task_idx)
+        {
+            ast::Task* task = domain->tasks[task_idx];
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "%d, ", first_case);
+            first_case += size(task->cases);
+        }
+
+        if (empty(domain->tasks))
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "0");
+        }
+        writeln(fmtr, "};");
+        newline(fmtr);
+    }
+
+    // s_size_hints
+    {
+        writeln(fmtr, "static uint32_t s_size_hints[] = {");
+        for (uint32_t fact_idx = 0; fact_idx < size(world->facts); ++fact_idx)
+        {
+            Indent_Scope s(fmtr);
+            ast::Fact* fact = world->facts[fact_idx];
+            ast::Attribute* attr = find_attribute(fact, Attribute_Size);
+
+            if (attr)
+            {
+                Expr_Writer visitor = { &fmtr, self->tree };
+                write(fmtr, "%i");
+                const ast::Expr* expr = attr->args[0];
+                visit_node<void>(expr, &visitor);
+                write(fmtr, ",");
+                newline(fmtr);
+            }
+            else
+            {
+                writeln(fmtr, "0,");
+            }
+        }
+
+        if (empty(world->facts))
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "0");
+        }
+        writeln(fmtr, "};");
+        newline(fmtr);
+    }
+
+    // s_num_fact_indexes, s_first_fact_index & s_fact_indexes
+    {
+        writeln(fmtr, "static uint32_t s_num_fact_indexes[] = {");
+        for (uint32_t fact_idx = 0; fact_idx < size(world->facts); ++fact_idx)
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "%d, ", get_num_indexes(world->facts[fact_idx]));
+        }
+
+        if (empty(world->facts))
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "0");
+        }
+        writeln(fmtr, "};");
+        newline(fmtr);
+
+        writeln(fmtr, "static uint32_t s_first_fact_index[] = {");
+        uint32_t first_index = 0;
+        for (uint32_t fact_idx = 0; fact_idx < size(world->facts); ++fact_idx)
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "%d, ", first_index);
+            first_index += get_num_indexes(world->facts[fact_idx]);
+        }
+
+        if (empty(world->facts))
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "0");
+        }
+        writeln(fmtr, "};");
+        newline(fmtr);
+
+        writeln(fmtr, "static Fact_Index_Format s_fact_indexes[] = {");
+        for (uint32_t fact_idx = 0; fact_idx < size(world->facts); ++fact_idx)
+        {
+            ast::Fact* fact = world->facts[fact_idx];
+            for (uint32_t attr_idx = 0; attr_idx < size(fact->attrs); ++attr_idx)
+            {
+                ast::Attribute* attr = fact->attrs[attr_idx];
+                if (!is_Index(attr) && !is_Ordered(attr))
+                    continue;
+
+                Indent_Scope s(fmtr);
+                write(fmtr, "%i{ %d, {", size(attr->args));
+                for (uint32_t arg_idx = 0; arg_idx < size(attr->args); ++arg_idx)
+                {
+                    write(fmtr, "%d, ", get_index_column(attr, arg_idx));
+                }
+                write(fmtr, "}, %s }, // %n", is_Ordered(attr) ? "Fact_Index_Ordered" : "Fact_Index_Hash", fact->name);
+                newline(fmtr);
+            }
+        }
+
+        if (first_index == 0)
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "{ 0, { 0, }, Fact_Index_Hash }");
+        }
+        writeln(fmtr, "};");
+        newline(fmtr);
+    }
+
+    // s_fact_stats
+    {
+        writeln(fmtr, "static bool s_fact_stats[] = {");
+        for (uint32_t fact_idx = 0; fact_idx < size(world->facts); ++fact_idx)
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "%s, ", has_unordered_join(tree, world->facts[fact_idx]) ? "true" : "false");
+        }
+
+        if (empty(world->facts))
+        {
             Indent_Scope s(fmtr);
-            writeln(fmtr, "%s,", get_runtime_type_enum(type));
+            writeln(fmtr, "false");
         }
         writeln(fmtr, "};");
         newline(fmtr);
-
-        writeln(fmtr, "static size_t s_layout_offsets[%d];", size(self->task_and_binding_sigs.types));
-        newline(fmtr);
     }
 
-    // s_task_parameters & s_bindings.
+    // s_num_case_handles
     {
-        struct Format_Param_Layout
-        {
-            void operator()(Formatter& fmtr, Signature_Table& signatures, uint32_t sig_idx)
-            {
-                Signature sig = get_sparse(signatures, sig_idx);
-
-                Indent_Scope s(fmtr);
-                if (sig.length > 0)
-                {
-                    writeln(fmtr, "{ %d, 0, 0, s_layout_types + %d, s_layout_offsets + %d },", sig.length, sig.offset, sig.offset);
-                }
-                else
-                {
-                    writeln(fmtr, "{ 0, 0, 0, 0, 0 },");
-                }
-            }
-        };
-
-        const uint32_t num_tasks = size(prim->tasks) + size(domain->tasks);
-
-        writeln(fmtr, "static Param_Layout s_task_parameters[] = {");
-        for (uint32_t sig_idx = 0; sig_idx < num_tasks; ++sig_idx)
+        writeln(fmtr, "static uint32_t s_num_case_handles[] = {");
+        for (uint32_t case_idx = 0; case_idx < size(tree->cases); ++case_idx)
         {
-            Format_Param_Layout()(fmtr, self->task_and_binding_sigs, sig_idx);
+            ast::Case* case_ = tree->cases[case_idx];
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "%d, ", get_num_case_handles(tree, case_));
         }
 
-        if (!num_tasks)
+        if (empty(world->facts))
         {
             Indent_Scope s(fmtr);
-            writeln(fmtr, "{ 0, 0, 0, 0 }");
+            writeln(fmtr, "0");
         }
         writeln(fmtr, "};");
         newline(fmtr);
+    }
+
+    // s_frame_costs, filled by `compute_frame_costs` once the layouts are known.
+    {
+        const uint32_t num_tasks = size(prim->tasks) + size(domain->tasks);
+        writeln(fmtr, "static uint32_t s_frame_costs[%d];", num_tasks > 0 ? num_tasks : 1);
+        newline(fmtr);
+    }
 
-        writeln(fmtr, "static Param_Layout s_bindings[] = {");
-        for (uint32_t sig_idx = num_tasks; sig_idx < size(self->task_and_binding_sigs.remap); ++sig_idx)
+    // s_collects_bindings
+    {
+        writeln(fmtr, "static bool s_collects_bindings[] = {");
+        for (uint32_t case_idx = 0; case_idx < size(tree->cases); ++case_idx)
         {
-            Format_Param_Layout()(fmtr, self->task_and_binding_sigs, sig_idx);
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "%s, ", collects_bindings(self, case_idx) ? "true" : "false");
         }
 
-        if (num_tasks == size(self->task_and_binding_sigs.remap))
+        if (empty(tree->cases))
         {
             Indent_Scope s(fmtr);
-            writeln(fmtr, "{ 0, 0, 0, 0 }");
+            writeln(fmtr, "false");
         }
         writeln(fmtr, "};");
         newline(fmtr);
     }
 
-    // s_num_cases
+    // s_first_collect_fact
     {
-        writeln(fmtr, "static uint32_t s_num_cases[] = {");
-        for (uint32_t task_idx = 0; task_idx < size(domain->tasks); ++task_idx)
+        writeln(fmtr, "static uint32_t s_first_collect_fact[] = {");
+        uint32_t first_collect_fact = 0;
+        for (uint32_t case_idx = 0; case_idx < size(tree->cases); ++case_idx)
         {
-            ast::Task* task = domain->tasks[task_idx];
             Indent_Scope s(fmtr);
-            writeln(fmtr, "%d, ", size(task->cases));
+            writeln(fmtr, "%d, ", first_collect_fact);
+
+            if (collects_bindings(self, case_idx))
+                first_collect_fact += write_collect_facts(self, tree->cases[case_idx], 0);
         }
 
-        if (empty(domain->tasks))
         {
             Indent_Scope s(fmtr);
-            writeln(fmtr, "0");
+            writeln(fmtr, "%d", first_collect_fact);
         }
         writeln(fmtr, "};");
         newline(fmtr);
     }
 
-    // s_first_case
+    // s_collect_facts
     {
-        writeln(fmtr, "static uint32_t s_first_case[] = {");
-        uint32_t first_case = 0;
-        for (uint32_t task_idx = 0; task_idx < size(domain->tasks); ++task_idx)
+        writeln(fmtr, "static uint32_t s_collect_facts[] = {");
+        uint32_t num_collect_facts = 0;
+        for (uint32_t case_idx = 0; case_idx < size(tree->cases); ++case_idx)
         {
-            ast::Task* task = domain->tasks[task_idx];
-            Indent_Scope s(fmtr);
-            writeln(fmtr, "%d, ", first_case);
-            first_case += size(task->cases);
+            if (collects_bindings(self, case_idx))
+                num_collect_facts += write_collect_facts(self, tree->cases[case_idx], &fmtr);
         }
 
-        if (empty(domain->tasks))
+        if (num_collect_facts == 0)
         {
             Indent_Scope s(fmtr);
             writeln(fmtr, "0");
@@ -714,50 +1641,34 @@ void plnnrc::generate_source(Codegen* self, const char* domain_header, Writer* o
         newline(fmtr);
     }
 
-    // s_size_hints
+    // s_parallel
     {
-        writeln(fmtr, "static uint32_t s_size_hints[] = {");
-        for (uint32_t fact_idx = 0; fact_idx < size(world->facts); ++fact_idx)
+        writeln(fmtr, "static bool s_parallel[] = {");
+        for (uint32_t task_idx = 0; task_idx < size(domain->tasks); ++task_idx)
         {
             Indent_Scope s(fmtr);
-            ast::Fact* fact = world->facts[fact_idx];
-            ast::Attribute* attr = find_attribute(fact, Attribute_Size);
-
-            if (attr)
-            {
-                Expr_Writer visitor = { &fmtr, self->tree };
-                write(fmtr, "%i");
-                const ast::Expr* expr = attr->args[0];
-                visit_node<void>(expr, &visitor);
-                write(fmtr, ",");
-                newline(fmtr);
-            }
-            else
-            {
-                writeln(fmtr, "0,");
-            }
+            writeln(fmtr, "%s, ", find_attribute(domain->tasks[task_idx], Attribute_Parallel) ? "true" : "false");
         }
 
-        if (empty(world->facts))
+        if (empty(domain->tasks))
         {
             Indent_Scope s(fmtr);
-            writeln(fmtr, "0");
+            writeln(fmtr, "false");
         }
         writeln(fmtr, "};");
         newline(fmtr);
     }
 
-    // s_num_case_handles
+    // s_case_preconds
     {
-        writeln(fmtr, "static uint32_t s_num_case_handles[] = {");
+        writeln(fmtr, "static Case_Precondition* s_case_preconds[] = {");
         for (uint32_t case_idx = 0; case_idx < size(tree->cases); ++case_idx)
         {
-            ast::Case* case_ = tree->cases[case_idx];
             Indent_Scope s(fmtr);
-            writeln(fmtr, "%d, ", size(case_->precond_facts));
+            writeln(fmtr, "p%d_next,", case_idx);
         }
 
-        if (empty(world->facts))
+        if (empty(tree->cases))
         {
             Indent_Scope s(fmtr);
             writeln(fmtr, "0");
@@ -895,10 +1806,10 @@ void plnnrc::generate_source(Codegen* self, const char* domain_header, Writer* o
         {
             Indent_Scope s(fmtr);
             // task_info
-            writeln(fmtr, "{ %d, %d, %d, s_num_cases, s_first_case, %d, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands },",
+            writeln(fmtr, "{ %d, %d, %d, s_num_cases, s_first_case, %d, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },",
                 num_tasks, num_primitive, num_compound, task_names_hash_seed);
             // database_req
-            writeln(fmtr, "{ %d, %d, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names },", size(world->facts), fact_names_hash_seed);
+            writeln(fmtr, "{ %d, %d, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },", size(world->facts), fact_names_hash_seed);
             // symbols
             writeln(fmtr, "{ %d, %d, s_symbol_hashes, s_symbol_values }", size(self->tree->symbols), symbol_values_hash_seed);
         }
@@ -926,6 +1837,8 @@ void plnnrc::generate_source(Codegen* self, const char* domain_header, Writer* o
                 writeln(fmtr, "compute_offsets_and_size(&s_bindings[i]);");
             }
             writeln(fmtr, "}");
+            newline(fmtr);
+            writeln(fmtr, "compute_frame_costs(&s_domain_info);");
         }
         writeln(fmtr, "}");
         newline(fmtr);
@@ -934,8 +1847,11 @@ void plnnrc::generate_source(Codegen* self, const char* domain_header, Writer* o
         newline(fmtr);
     }
 
-    // accessor structs
+    // accessor structs, in anonymous namespace so the same names in other generated domains don't clash.
     {
+        writeln(fmtr, "namespace {");
+        newline(fmtr);
+
         for (uint32_t sig_idx = 0; sig_idx < size_dense(self->struct_sigs); ++sig_idx)
         {
             Signature sig = get_dense(self->struct_sigs, sig_idx);
@@ -952,6 +1868,9 @@ void plnnrc::generate_source(Codegen* self, const char* domain_header, Writer* o
             writeln(fmtr, "};");
             newline(fmtr);
         }
+
+        writeln(fmtr, "}");
+        newline(fmtr);
     }
 
     // precondition iterators
@@ -980,6 +1899,104 @@ void plnnrc::generate_source(Codegen* self, const char* domain_header, Writer* o
     flush(fmtr);
 }
 
+// emits the row filter functors of a case precondition.
+struct Row_Filter_Generator
+{
+    Codegen* self;
+    Formatter* fmtr;
+    bool has_args;
+    bool has_output;
+    uint32_t case_idx;
+    uint32_t struct_idx;
+    uint32_t output_idx;
+
+    void operator()(ast::Expr* literal, uint32_t filter_index)
+    {
+        generate_row_filter(self, literal, has_args, has_output, case_idx, filter_index, struct_idx, output_idx, *fmtr);
+    }
+};
+
+// writes the estimated number of rows the fact literal iterates when it leads the conjunct, i.e. only constants and parameters are bound.
+static void write_join_estimate(Codegen* self, ast::Expr* literal, Formatter& fmtr)
+{
+    ast::Func* func = as_Func(literal);
+    ast::Fact* fact = get_fact(self->tree, func->name);
+    uint32_t bound_columns = 0;
+
+    for (uint32_t arg_idx = 0; arg_idx < size(func->args); ++arg_idx)
+    {
+        ast::Var* var = as_Var(func->args[arg_idx]);
+        if (!var || (var->definition && is_Param(var->definition)))
+            bound_columns |= (1u << arg_idx);
+    }
+
+    write(fmtr, "estimate_rows(db, Binding::tbl(state, %d), %d)", index_of(self->tree->world->facts, fact), bound_columns);
+}
+
+// generates the conjunct once per join order, the order leading with the fewest estimated rows is picked at runtime.
+static void generate_join_orders(Codegen* self, ast::Case* case_, ast::Expr* conjunct, ast::Expr* first, ast::Expr** leading, uint32_t num_orders,
+    uint32_t& handle_id, uint32_t& filter_id, uint32_t& yield_id, bool store_binds, uint32_t case_index, uint32_t output_index, Formatter& fmtr)
+{
+    const uint32_t first_handle_id = handle_id;
+    uint32_t last_handle_id = handle_id;
+
+    for (uint32_t order_idx = 0; order_idx < num_orders; ++order_idx)
+    {
+        ast::Expr* literal = leading[order_idx];
+
+        // source order is the fallback.
+        if (!literal)
+        {
+            writeln(fmtr, "else {");
+        }
+        else
+        {
+            write(fmtr, order_idx == 0 ? "%iif (" : "%ielse if (");
+            write_join_estimate(self, literal, fmtr);
+            write(fmtr, " < ");
+            write_join_estimate(self, first, fmtr);
+
+            for (uint32_t other_idx = 0; leading[other_idx] != 0; ++other_idx)
+            {
+                if (other_idx == order_idx)
+                    continue;
+
+                write(fmtr, " && ");
+                write_join_estimate(self, literal, fmtr);
+                write(fmtr, other_idx < order_idx ? " < " : " <= ");
+                write_join_estimate(self, leading[other_idx], fmtr);
+            }
+
+            write(fmtr, ") {");
+            newline(fmtr);
+        }
+
+        {
+            Indent_Scope s(fmtr);
+            Memory_Stack_Scope scratch_scope(self->tree->scratch);
+            Array<Var_Binding> saved;
+            ast::Expr* prev = 0;
+
+            if (literal)
+            {
+                init(saved, self->tree->scratch, size(case_->precond_vars));
+                prev = apply_join_order(self->tree, case_, conjunct, literal, saved);
+            }
+
+            handle_id = first_handle_id;
+            generate_conjunct(self, case_, conjunct->child, 0, 0, handle_id, filter_id, yield_id, store_binds, case_index, output_index, fmtr);
+            last_handle_id = handle_id > last_handle_id ? handle_id : last_handle_id;
+
+            if (literal)
+                revert_join_order(literal, prev, saved);
+        }
+
+        writeln(fmtr, "}");
+    }
+
+    handle_id = last_handle_id;
+}
+
 static void generate_precondition(Codegen* self, uint32_t case_idx, Formatter& fmtr)
 {
     ast::Domain* domain = self->tree->domain;
@@ -1001,7 +2018,18 @@ static void generate_precondition(Codegen* self, uint32_t case_idx, Formatter& f
         generate_comparator(self, attr_sorted->args[0], attr_sorted->types[0], has_args, case_idx, struct_idx, output_idx, fmtr);
     }
 
-    writeln(fmtr, "static bool p%d_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)", case_idx);
+    // `:sorted` case materializes all bindings anyway and commits to one of them, so duplicates are removed as well.
+    const bool distinct = has_output && (find_attribute(case_, Attribute_Distinct) || (attr_sorted && !case_->foreach));
+    if (distinct)
+    {
+        generate_distinct(self, case_idx, output_idx, fmtr);
+    }
+
+    // bindings are collected in the expansion blob, then yielded one by one.
+    const bool store_binds = collects_bindings(self, case_idx);
+
+    Row_Filter_Generator filter_generator = { self, &fmtr, has_args, has_output, case_idx, struct_idx, output_idx };
+    for_each_row_filter(self->tree, case_, filter_generator);
 
     ast::Expr* precond = case_->precond;
     plnnrc_assert(is_Or(precond));
@@ -1009,9 +2037,11 @@ static void generate_precondition(Codegen* self, uint32_t case_idx, Formatter& f
     // trivial precondition expression.
     if (!precond->child)
     {
+        writeln(fmtr, "static bool p%d_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)", case_idx);
         writeln(fmtr, "{");
         {
             Indent_Scope s(fmtr);
+            writeln(fmtr, "++state->precond_iterations;");
             writeln(fmtr, "plnnr_coroutine_begin(frame, precond_label);");
             writeln(fmtr, "plnnr_coroutine_yield(frame, precond_label, 1);");
             writeln(fmtr, "plnnr_coroutine_end();");
@@ -1021,6 +2051,9 @@ static void generate_precondition(Codegen* self, uint32_t case_idx, Formatter& f
         return;
     }
 
+    // the body is instantiated for both table bindings, so tables of an identity bound database are addressed by constant indices.
+    writeln(fmtr, "template <typename Binding>");
+    writeln(fmtr, "static bool p%d_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)", case_idx);
     writeln(fmtr, "{");
     {
         Indent_Scope s(fmtr);
@@ -1033,10 +2066,12 @@ static void generate_precondition(Codegen* self, uint32_t case_idx, Formatter& f
             writeln(fmtr, "S_%d* binds = (S_%d*)(frame->bindings);", output_idx, output_idx);
 
         newline(fmtr);
+        writeln(fmtr, "++state->precond_iterations;");
         writeln(fmtr, "plnnr_coroutine_begin(frame, precond_label);");
         newline(fmtr);
 
         uint32_t handle_id = 0;
+        uint32_t filter_id = 0;
         uint32_t yield_id = 1;
         bool is_empty_precond = true;
         for (ast::Expr* conjunct = precond->child; conjunct != 0; conjunct = conjunct->next_sibling)
@@ -1055,60 +2090,287 @@ static void generate_precondition(Codegen* self, uint32_t case_idx, Formatter& f
                 node = conjunct->child;
             }
 
-            if (attr_sorted)
+            if (store_binds)
             {
                 if (conjunct != precond->child)
                     writeln(fmtr, "revert(&state->expansion_blob, binds + 1);");
 
-                writeln(fmtr, "frame->num_bindings = 0;");
-            }
+                writeln(fmtr, "frame->num_bindings = 0;");
+            }
+
+            ast::Expr* first = 0;
+            ast::Expr* leading[Max_Join_Orders];
+            const uint32_t num_orders = find_join_orders(self->tree, case_, conjunct, first, leading);
+
+            if (num_orders == 1)
+            {
+                generate_conjunct(self, case_, node, 0, 0, handle_id, filter_id, yield_id, store_binds, case_idx, output_idx, fmtr);
+            }
+            else
+            {
+                generate_join_orders(self, case_, conjunct, first, leading, num_orders, handle_id, filter_id, yield_id, store_binds, case_idx, output_idx, fmtr);
+            }
+
+            if (store_binds)
+            {
+                newline(fmtr);
+
+                writeln(fmtr, "if (frame->num_bindings > 0) {");
+                {
+                    Indent_Scope s(fmtr);
+                    writeln(fmtr, "revert(&state->expansion_blob, binds);");
+                }
+                writeln(fmtr, "}");
+                newline(fmtr);
+
+                if (distinct)
+                {
+                    writeln(fmtr, "remove_duplicates<S_%d>(state, frame, Distinct_p%d());", output_idx, case_idx);
+                    write_frame_reload(self, case_, fmtr);
+                }
+
+                writeln(fmtr, "binds = (S_%d*)(frame->bindings);", output_idx);
+
+                if (attr_sorted)
+                {
+                    // bindings are heapified in O(n) and the next best one is popped only when backtracking asks for it,
+                    // so committing to the first binding doesn't pay for sorting the rest.
+                    const char* compare_args = has_args ? "args" : "";
+                    writeln(fmtr, "std::make_heap(binds, binds + frame->num_bindings, Compare_p%d(%s));", case_idx, compare_args);
+                    newline(fmtr);
+                    writeln(fmtr, "for (frame->binding_index = frame->num_bindings; frame->binding_index > 0; ) {");
+                    {
+                        Indent_Scope s(fmtr);
+                        writeln(fmtr, "std::pop_heap(binds, binds + frame->binding_index, Compare_p%d(%s));", case_idx, compare_args);
+                        writeln(fmtr, "--frame->binding_index;");
+                        writeln(fmtr, "plnnr_coroutine_yield(frame, precond_label, %d);", yield_id++);
+                    }
+                    writeln(fmtr, "}");
+                }
+                else
+                {
+                    newline(fmtr);
+                    writeln(fmtr, "for (frame->binding_index = 0; frame->binding_index < frame->num_bindings; ++frame->binding_index) {");
+                    {
+                        Indent_Scope s(fmtr);
+                        writeln(fmtr, "plnnr_coroutine_yield(frame, precond_label, %d);", yield_id++);
+                    }
+                    writeln(fmtr, "}");
+                }
+
+                newline(fmtr);
+            }
+        }
+
+        // empty precondition expression.
+        if (is_empty_precond)
+        {
+            writeln(fmtr, "plnnr_coroutine_yield(frame, precond_label, %d);", yield_id++);
+        }
+
+        newline(fmtr);
+        writeln(fmtr, "plnnr_coroutine_end();");
+    }
+
+    writeln(fmtr, "}");
+    newline(fmtr);
+
+    writeln(fmtr, "static bool p%d_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)", case_idx);
+    writeln(fmtr, "{");
+    {
+        Indent_Scope s(fmtr);
+        writeln(fmtr, "return state->identity_binding ? p%d_body<Identity_Binding>(state, frame, db) : p%d_body<Mapped_Binding>(state, frame, db);", case_idx, case_idx);
+    }
+    writeln(fmtr, "}");
+    newline(fmtr);
+}
+
+// alternative of a nested disjunction in the `:factorized` precondition. the literals following the disjunction are generated once:
+// the end of each alternative jumps to them, and their end jumps back to the alternative to continue its loops.
+struct Branch_Scope
+{
+    // handle keeping the index of the alternative to jump back to, also names the jump labels.
+    uint32_t            handle_id;
+    // index of the alternative in the disjunction, starting from 1.
+    uint32_t            alternative;
+    // alternative enclosing the disjunction, null at the conjunct level.
+    const Branch_Scope* outer;
+};
+
+// full table scan iterating the entries of each table by index, with the row count and the column pointers kept in locals.
+// locals don't survive the coroutine yield, the current entry is saved to the handle before the yield and the locals are reloaded after.
+struct Row_Scan
+{
+    // handle of the scanned fact, also names the locals.
+    uint32_t            handle_id;
+    // scanned fact.
+    const ast::Fact*    fact;
+    // enclosing full table scan.
+    const Row_Scan*     outer;
+};
+
+// declares the locals without initialization, resuming the coroutine jumps over the declarations.
+static void write_row_scan_locals(const Row_Scan* scan, Formatter& fmtr)
+{
+    const uint32_t id = scan->handle_id;
+    writeln(fmtr, "const Fact_Table* table_%d;", id);
+    writeln(fmtr, "const uint8_t* removed_%d;", id);
+    writeln(fmtr, "uint32_t rows_%d;", id);
+    writeln(fmtr, "uint32_t row_%d;", id);
+
+    for (uint32_t column = 0; column < size(scan->fact->params); ++column)
+    {
+        const Token_Type column_type = scan->fact->params[column]->data_type;
+        if (column_type == Token_Vec3)
+            writeln(fmtr, "Vec3_Column c%d_%d;", id, column);
+        else
+            writeln(fmtr, "const %s* c%d_%d;", get_runtime_type_name(column_type), id, column);
+    }
+}
+
+// loads the locals from the handle.
+static void write_row_scan_load(const Row_Scan* scan, Formatter& fmtr)
+{
+    const uint32_t id = scan->handle_id;
+    writeln(fmtr, "table_%d = get_table(db, handles[%d]);", id, id);
+    writeln(fmtr, "removed_%d = get_removed(table_%d);", id, id);
+    writeln(fmtr, "rows_%d = table_%d->num_entries;", id, id);
+    writeln(fmtr, "row_%d = handles[%d].entry;", id, id);
+
+    for (uint32_t column = 0; column < size(scan->fact->params); ++column)
+    {
+        const Token_Type column_type = scan->fact->params[column]->data_type;
+        if (column_type == Token_Vec3)
+            writeln(fmtr, "c%d_%d = get_vec3_column(table_%d, %d);", id, column, id, column);
+        else
+            writeln(fmtr, "c%d_%d = get_column<%s>(table_%d, %d);", id, column, get_runtime_type_name(column_type), id, column);
+    }
+}
+
+// writes the value of the fact `column` for the current entry, read from the column pointer in the full table scan.
+static void write_column_value(const Row_Scan* scan, Token_Type column_type, uint32_t handle_id, uint32_t column, Formatter& fmtr)
+{
+    if (scan)
+        write(fmtr, "load_row(c%d_%d, row_%d)", handle_id, column, handle_id);
+    else
+        write(fmtr, "as_%s(db, handles[%d], %d)", get_runtime_type_tag(column_type), handle_id, column);
+}
+
+// saves the current entries of the enclosing scans to their handles.
+static void write_row_scan_save(const Row_Scan* scan, Formatter& fmtr)
+{
+    if (!scan)
+        return;
+
+    write_row_scan_save(scan->outer, fmtr);
+    writeln(fmtr, "handles[%d].entry = row_%d;", scan->handle_id, scan->handle_id);
+}
+
+// reloads the locals of the enclosing scans after resuming.
+static void write_row_scan_resume(const Row_Scan* scan, Formatter& fmtr)
+{
+    if (!scan)
+        return;
+
+    write_row_scan_resume(scan->outer, fmtr);
+    write_row_scan_load(scan, fmtr);
+}
+
+// generates the end of the literal sequence: yields the bindings at the conjunct level, otherwise jumps out of the alternative.
+// the expansion blob may grow when precondition bindings are allocated, so pointers into it are reloaded from the frame.
+static void write_frame_reload(Codegen* self, ast::Case* case_, Formatter& fmtr)
+{
+    ast::Domain* domain = self->tree->domain;
+    const uint32_t struct_idx = get_dense_index(self->struct_sigs, index_of(domain->tasks, case_->task));
+
+    writeln(fmtr, "handles = frame->handles;");
 
-            generate_conjunct(self, case_, node, handle_id, yield_id, attr_sorted != 0, case_idx, output_idx, fmtr);
+    if (get_dense(self->struct_sigs, struct_idx).length > 0)
+        writeln(fmtr, "args = (const S_%d*)(frame->arguments);", struct_idx);
+}
 
-            if (attr_sorted)
-            {
-                newline(fmtr);
+static void generate_conjunct_end(Codegen* self, ast::Case* case_, const Branch_Scope* branch, const Row_Scan* scans, uint32_t& yield_id, bool store_binds, uint32_t case_index, uint32_t output_index, Formatter& fmtr)
+{
+    if (branch)
+    {
+        writeln(fmtr, "handles[%d].entry = %d;", branch->handle_id, branch->alternative);
+        writeln(fmtr, "goto branch_%d;", branch->handle_id);
+        writeln(fmtr, "branch_%d_%d:;", branch->handle_id, branch->alternative);
+    }
+    else if (!store_binds)
+    {
+        write_row_scan_save(scans, fmtr);
+        writeln(fmtr, "plnnr_coroutine_yield(frame, precond_label, %d);", yield_id++);
+        write_row_scan_resume(scans, fmtr);
+    }
+    else
+    {
+        // the enclosing loops keep matching against the current bindings, so they are carried to the new slot.
+        writeln(fmtr, "binds = (S_%d*)(allocate_precond_bindings(state, &s_bindings[%d]));", output_index, case_index);
+        write_frame_reload(self, case_, fmtr);
+        writeln(fmtr, "*binds = *(binds - 1);");
+        writeln(fmtr, "++frame->num_bindings;");
+    }
+}
 
-                writeln(fmtr, "if (frame->num_bindings > 0) {");
-                {
-                    Indent_Scope s(fmtr);
-                    writeln(fmtr, "revert(&state->expansion_blob, binds);");
-                }
-                writeln(fmtr, "}");
-                newline(fmtr);
+// generates the literals following `literal`, a single literal alternative of a disjunction has no following literals.
+static void generate_conjunct_next(Codegen* self, ast::Case* case_, ast::Expr* literal, const Branch_Scope* branch, const Row_Scan* scans, uint32_t& handle_id, uint32_t& filter_id, uint32_t& yield_id, bool store_binds, uint32_t case_index, uint32_t output_index, Formatter& fmtr)
+{
+    ast::Expr* next = is_Or(literal->parent) ? 0 : literal->next_sibling;
 
-                if (has_args)
-                    writeln(fmtr, "std::sort(binds - frame->num_bindings, binds, Compare_p%d(args));", case_idx);
-                else
-                    writeln(fmtr, "std::sort(binds - frame->num_bindings, binds, Compare_p%d());", case_idx);
+    if (!next)
+        generate_conjunct_end(self, case_, branch, scans, yield_id, store_binds, case_index, output_index, fmtr);
+    else
+        generate_conjunct(self, case_, next, branch, scans, handle_id, filter_id, yield_id, store_binds, case_index, output_index, fmtr);
+}
 
-                newline(fmtr);
-                writeln(fmtr, "for (frame->binding_index = 0; frame->binding_index < frame->num_bindings; ++frame->binding_index) {");
-                {
-                    Indent_Scope s(fmtr);
-                    writeln(fmtr, "plnnr_coroutine_yield(frame, precond_label, %d);", yield_id++);
-                }
-                writeln(fmtr, "}");
-                newline(fmtr);
-            }
-        }
+// nested disjunction -> generate each alternative, then the following literals once, jumping back to the alternative which reached them.
+static void generate_branches(Codegen* self, ast::Case* case_, ast::Expr* literal, const Branch_Scope* branch, const Row_Scan* scans, uint32_t& handle_id, uint32_t& filter_id, uint32_t& yield_id, bool store_binds, uint32_t case_index, uint32_t output_index, Formatter& fmtr)
+{
+    const uint32_t branch_id = handle_id++;
+    uint32_t num_alternatives = 0;
 
-        // empty precondition expression.
-        if (is_empty_precond)
+    for (ast::Expr* alternative = literal->child; alternative != 0; alternative = alternative->next_sibling)
+    {
+        Branch_Scope scope = { branch_id, ++num_alternatives, branch };
+        ast::Expr* first = is_And(alternative) ? alternative->child : alternative;
+
+        writeln(fmtr, "{");
         {
-            writeln(fmtr, "plnnr_coroutine_yield(frame, precond_label, %d);", yield_id++);
+            Indent_Scope s(fmtr);
+
+            if (first)
+                generate_conjunct(self, case_, first, &scope, scans, handle_id, filter_id, yield_id, store_binds, case_index, output_index, fmtr);
+            else
+                generate_conjunct_end(self, case_, &scope, scans, yield_id, store_binds, case_index, output_index, fmtr);
         }
+        writeln(fmtr, "}");
+    }
 
-        newline(fmtr);
-        writeln(fmtr, "plnnr_coroutine_end();");
+    writeln(fmtr, "goto branch_%d_end;", branch_id);
+    writeln(fmtr, "branch_%d:;", branch_id);
+
+    generate_conjunct_next(self, case_, literal, branch, scans, handle_id, filter_id, yield_id, store_binds, case_index, output_index, fmtr);
+
+    for (uint32_t alternative = 1; alternative <= num_alternatives; ++alternative)
+    {
+        if (alternative < num_alternatives)
+            writeln(fmtr, "if (handles[%d].entry == %d) goto branch_%d_%d;", branch_id, alternative, branch_id, alternative);
+        else
+            writeln(fmtr, "goto branch_%d_%d;", branch_id, alternative);
     }
 
-    writeln(fmtr, "}");
-    newline(fmtr);
+    writeln(fmtr, "branch_%d_end:;", branch_id);
 }
 
-static void generate_conjunct(Codegen* self, ast::Case* case_, ast::Expr* literal, uint32_t& handle_id, uint32_t& yield_id, bool store_binds, uint32_t case_index, uint32_t output_index, Formatter& fmtr)
+static void generate_conjunct(Codegen* self, ast::Case* case_, ast::Expr* literal, const Branch_Scope* branch, const Row_Scan* scans, uint32_t& handle_id, uint32_t& filter_id, uint32_t& yield_id, bool store_binds, uint32_t case_index, uint32_t output_index, Formatter& fmtr)
 {
+    if (is_Or(literal))
+    {
+        generate_branches(self, case_, literal, branch, scans, handle_id, filter_id, yield_id, store_binds, case_index, output_index, fmtr);
+        return;
+    }
+
     ast::Func* func = is_Not(literal) ? as_Func(literal->child) : as_Func(literal);
 
     ast::Fact* fact = 0;
@@ -1143,41 +2405,137 @@ static void generate_conjunct(Codegen* self, ast::Case* case_, ast::Expr* litera
 
         Indent_Scope indent_scope(fmtr);
 
-        if (!literal->next_sibling)
+        generate_conjunct_next(self, case_, literal, branch, scans, handle_id, filter_id, yield_id, store_binds, case_index, output_index, fmtr);
+    }
+    // fact -> generate iterator.
+    else
+    {
+        ast::Fact* fact = get_fact(self->tree, func->name);
+        uint32_t fact_idx = index_of(self->tree->world->facts, fact);
+
+        uint32_t probe_index = 0;
+        ast::Attribute* probe_attr = find_probe_index(fact, func, probe_index);
+        Row_Scan row_scan;
+        Range_Probe range_probe;
+        uint32_t scan_column = 0;
+        const bool exists = is_existence_check(self, case_, literal);
+        const uint32_t literal_handle_id = handle_id;
+
+        // all columns of an index are bound -> iterate entries with the matching hash.
+        if (probe_attr)
         {
-            if (!store_binds)
+            const uint32_t num_columns = size(probe_attr->args);
+
+            write(fmtr, "%ifor (handles[%d] = first(db, Binding::tbl(state, %d), %d, ", handle_id, fact_idx, probe_index);
+            for (uint32_t arg_idx = num_columns; arg_idx > 0; --arg_idx)
             {
-                writeln(fmtr, "plnnr_coroutine_yield(frame, precond_label, %d);", yield_id++);
+                const uint32_t column = get_index_column(probe_attr, arg_idx - 1);
+                write(fmtr, "hash_%s(", get_runtime_type_tag(fact->params[column]->data_type));
             }
-            else
+
+            write(fmtr, "0");
+            for (uint32_t arg_idx = 0; arg_idx < num_columns; ++arg_idx)
+            {
+                const uint32_t column = get_index_column(probe_attr, arg_idx);
+                ast::Expr* arg = func->args[column];
+                write(fmtr, ", %s(", get_runtime_type_name(fact->params[column]->data_type));
+                write_bound_arg(self, case_, arg, fmtr);
+                write(fmtr, "))");
+            }
+
+            write(fmtr, "); is_valid(db, handles[%d]); handles[%d] = next(db, handles[%d], %d)) { // %n",
+                handle_id, handle_id, handle_id, probe_index, fact->name);
+            newline(fmtr);
+        }
+        // bound range of an ordered column -> iterate the range in the ordered index, using an extra handle as a cursor.
+        else if (!is_Not(literal) && find_range_probe(fact, literal, range_probe))
+        {
+            const uint32_t cursor_id = handle_id++;
+            Expr_Writer visitor = { &fmtr, self->tree };
+
+            write(fmtr, "%ifor (handles[%d] = first_in_range(db, Binding::tbl(state, %d), %d, %s, ", cursor_id, fact_idx, range_probe.index, range_probe.op);
+            visit_node<void>(range_probe.value, &visitor);
+            write(fmtr, "); handles[%d] = range_entry(db, Binding::tbl(state, %d), %d, handles[%d]), is_valid(db, handles[%d]); handles[%d] = next_in_range(db, Binding::tbl(state, %d), %d, handles[%d])) { // %n",
+                handle_id, fact_idx, range_probe.index, cursor_id, handle_id, cursor_id, fact_idx, range_probe.index, cursor_id, fact->name);
+            newline(fmtr);
+        }
+        // bound integer or id column -> skip non-matching entries with a vectorized column scan.
+        else if (!is_Not(literal) && find_scan_column(fact, literal, scan_column))
+        {
+            const char* scan_type_name = get_runtime_type_name(fact->params[scan_column]->data_type);
+
+            write(fmtr, "%ifor (handles[%d] = first_equal(db, Binding::tbl(state, %d), %d, %s(", handle_id, fact_idx, scan_column, scan_type_name);
+            write_bound_arg(self, case_, func->args[scan_column], fmtr);
+            write(fmtr, ")); is_valid(db, handles[%d]); handles[%d] = next_equal(db, handles[%d], %d, %s(", handle_id, handle_id, handle_id, scan_column, scan_type_name);
+            write_bound_arg(self, case_, func->args[scan_column], fmtr);
+            write(fmtr, "))) { // %n", fact->name);
+            newline(fmtr);
+        }
+        // row filters following the literal -> iterate entries accepted by the filter, using an extra handle slot for the block mask.
+        else if (!is_Not(literal) && has_row_filter(self->tree, fact, literal))
+        {
+            const uint32_t mask_id = handle_id++;
+            const uint32_t filter_index = filter_id++;
+
+            const bool has_args = (get_dense(self->struct_sigs, get_dense_index(self->struct_sigs, index_of(self->tree->domain->tasks, case_->task))).length > 0);
+            const bool has_output = (get_dense(self->struct_sigs, output_index).length > 0);
+
+            write(fmtr, "%ifor (handles[%d] = first_filtered(db, Binding::tbl(state, %d), row_mask(handles, %d), Filter_p%d_%d(", handle_id, fact_idx, mask_id, case_index, filter_index);
+            write_row_filter_args(has_args, has_output, fmtr);
+            write(fmtr, ")); is_valid(db, handles[%d]); handles[%d] = next_filtered(db, handles[%d], row_mask(handles, %d), Filter_p%d_%d(", handle_id, handle_id, handle_id, mask_id, case_index, filter_index);
+            write_row_filter_args(has_args, has_output, fmtr);
+            write(fmtr, "))) { // %n", fact->name);
+            newline(fmtr);
+        }
+        // full table scan outside of the disjunction alternatives -> iterate entries of each table by index.
+        else if (!is_Not(literal) && !branch)
+        {
+            row_scan.handle_id = handle_id;
+            row_scan.fact = fact;
+            row_scan.outer = scans;
+            scans = &row_scan;
+
+            writeln(fmtr, "for (handles[%d] = first(db, Binding::tbl(state, %d)); is_valid(db, handles[%d]); handles[%d] = next_table(db, handles[%d])) { // %n",
+                handle_id, fact_idx, handle_id, handle_id, handle_id, fact->name);
             {
-                writeln(fmtr, "binds = (S_%d*)(allocate_precond_bindings(state, &s_bindings[%d]));", output_index, case_index);
-                writeln(fmtr, "++frame->num_bindings;");
+                Indent_Scope s(fmtr);
+                write_row_scan_locals(&row_scan, fmtr);
+                write_row_scan_load(&row_scan, fmtr);
+                newline(fmtr);
+
+                writeln(fmtr, "for (; row_%d < rows_%d; ++row_%d) {", handle_id, handle_id, handle_id);
             }
+
+            // the entry loop is closed before the table loop.
+            enter_indent_level(fmtr);
         }
         else
         {
-            generate_conjunct(self, case_, literal->next_sibling, handle_id, yield_id, store_binds, case_index, output_index, fmtr);
+            writeln(fmtr, "for (handles[%d] = first(db, Binding::tbl(state, %d)); is_valid(db, handles[%d]); handles[%d] = next(db, handles[%d])) { // %n",
+                handle_id, fact_idx, handle_id, handle_id, handle_id, fact->name);
         }
-    }
-    // fact -> generate iterator.
-    else
-    {
-        ast::Fact* fact = get_fact(self->tree, func->name);
-        uint32_t fact_idx = index_of(self->tree->world->facts, fact);
 
-        writeln(fmtr, "for (handles[%d] = first(db, tbl(state, %d)); is_valid(db, handles[%d]); handles[%d] = next(db, handles[%d])) { // %n",
-            handle_id, fact_idx, handle_id, handle_id, handle_id, fact->name);
         {
             Indent_Scope indent_scope(fmtr);
 
-            const char* comparison_op = is_Not(literal) ? "==" : "!=";
+            if (scans == &row_scan)
+            {
+                writeln(fmtr, "if (removed_%d && removed_%d[row_%d]) {", handle_id, handle_id, handle_id);
+                {
+                    Indent_Scope s(fmtr);
+                    writeln(fmtr, "continue;");
+                }
+                writeln(fmtr, "}");
+                newline(fmtr);
+            }
+
+            const Row_Scan* scan = (scans == &row_scan) ? scans : 0;
+            const char* comparison_op = "!=";
             for (uint32_t arg_idx = 0; arg_idx < size(func->args); ++arg_idx)
             {
                 ast::Expr* arg = func->args[arg_idx];
 
                 Token_Type source_data_type = fact->params[arg_idx]->data_type;
-                const char* source_data_type_tag = get_runtime_type_tag(source_data_type);
                 const char* source_data_type_name = get_runtime_type_name(source_data_type);
 
                 // variable -> match or create a new binding.
@@ -1186,11 +2544,17 @@ static void generate_conjunct(Codegen* self, ast::Case* case_, ast::Expr* litera
                     Token_Type target_data_type = var->data_type;
                     const char* target_data_type_name = get_runtime_type_name(target_data_type);
 
+                    // unbound variable in negated literal -> matches any value.
+                    if (var->binding && is_Not(literal))
+                        continue;
+
                     // yet unbound variable -> create binding.
                     if (var->binding)
                     {
-                        writeln(fmtr, "binds->_%d = %s(as_%s(db, handles[%d], %d));",
-                            var->output_index, target_data_type_name, source_data_type_tag, handle_id, arg_idx);
+                        write(fmtr, "%ibinds->_%d = %s(", var->output_index, target_data_type_name);
+                        write_column_value(scan, source_data_type, handle_id, arg_idx, fmtr);
+                        write(fmtr, ");");
+                        newline(fmtr);
                         continue;
                     }
 
@@ -1200,8 +2564,10 @@ static void generate_conjunct(Codegen* self, ast::Case* case_, ast::Expr* litera
                     if (ast::Param* param = as_Param(def))
                     {
                         ast::Var* first = get(case_->precond_var_lookup, param->name);
-                        writeln(fmtr, "if (args->_%d %s %s(as_%s(db, handles[%d], %d))) {",
-                            first->input_index, comparison_op, target_data_type_name, source_data_type_tag, handle_id, arg_idx);
+                        write(fmtr, "%iif (args->_%d %s %s(", first->input_index, comparison_op, target_data_type_name);
+                        write_column_value(scan, source_data_type, handle_id, arg_idx, fmtr);
+                        write(fmtr, ")) {");
+                        newline(fmtr);
                         {
                             Indent_Scope s(fmtr);
                             writeln(fmtr, "continue;");
@@ -1214,8 +2580,10 @@ static void generate_conjunct(Codegen* self, ast::Case* case_, ast::Expr* litera
                     // variable -> matching with existing binding.
                     if (ast::Var* var_def = as_Var(def))
                     {
-                        writeln(fmtr, "if (binds->_%d %s %s(as_%s(db, handles[%d], %d))) {",
-                            var_def->output_index, comparison_op, target_data_type_name, source_data_type_tag, handle_id, arg_idx);
+                        write(fmtr, "%iif (binds->_%d %s %s(", var_def->output_index, comparison_op, target_data_type_name);
+                        write_column_value(scan, source_data_type, handle_id, arg_idx, fmtr);
+                        write(fmtr, ")) {");
+                        newline(fmtr);
                         {
                             Indent_Scope s(fmtr);
                             writeln(fmtr, "continue;");
@@ -1234,7 +2602,9 @@ static void generate_conjunct(Codegen* self, ast::Case* case_, ast::Expr* litera
 
                     write(fmtr, "%iif (%s(", source_data_type_name);
                     visit_node<void>(arg, &visitor);
-                    write(fmtr, ") %s as_%s(db, handles[%d], %d)) {", comparison_op, source_data_type_tag, handle_id, arg_idx);
+                    write(fmtr, ") %s ", comparison_op);
+                    write_column_value(scan, source_data_type, handle_id, arg_idx, fmtr);
+                    write(fmtr, ") {");
                     newline(fmtr);
                     {
                         Indent_Scope s(fmtr);
@@ -1247,22 +2617,48 @@ static void generate_conjunct(Codegen* self, ast::Case* case_, ast::Expr* litera
 
             ++handle_id;
 
-            if (!literal->next_sibling)
+            // negated literal -> stop at the first matching entry, the following literals are generated after the loop.
+            if (is_Not(literal))
             {
-                if (!store_binds)
-                {
-                    writeln(fmtr, "plnnr_coroutine_yield(frame, precond_label, %d);", yield_id++);
-                }
-                else
-                {
-                    writeln(fmtr, "binds = (S_%d*)(allocate_precond_bindings(state, &s_bindings[%d]));", output_index, case_index);
-                    writeln(fmtr, "++frame->num_bindings;");
-                }
+                writeln(fmtr, "break;");
             }
             else
             {
-                generate_conjunct(self, case_, literal->next_sibling, handle_id, yield_id, store_binds, case_index, output_index, fmtr);
+                generate_conjunct_next(self, case_, literal, branch, scans, handle_id, filter_id, yield_id, store_binds, case_index, output_index, fmtr);
+
+                if (exists)
+                    writeln(fmtr, "break;");
+            }
+        }
+
+        if (scans == &row_scan)
+        {
+            writeln(fmtr, "}");
+
+            // the entry loop stopped at the first match -> skip the remaining tables.
+            if (exists)
+            {
+                newline(fmtr);
+                writeln(fmtr, "if (row_%d < rows_%d) {", row_scan.handle_id, row_scan.handle_id);
+                {
+                    Indent_Scope s(fmtr);
+                    writeln(fmtr, "break;");
+                }
+                writeln(fmtr, "}");
             }
+
+            exit_indent_level(fmtr);
+        }
+
+        // anti-join: continue only if no entry matched.
+        if (is_Not(literal))
+        {
+            writeln(fmtr, "}");
+            newline(fmtr);
+            writeln(fmtr, "if (!is_valid(db, handles[%d])) {", literal_handle_id);
+
+            Indent_Scope indent_scope(fmtr);
+            generate_conjunct_next(self, case_, literal, branch, scans, handle_id, filter_id, yield_id, store_binds, case_index, output_index, fmtr);
         }
     }
 
@@ -1273,6 +2669,7 @@ static void generate_comparator(Codegen* self, ast::Expr* key_expr, Token_Type k
 {
     const char* key_data_type_name = get_runtime_type_name(key_type);
 
+    writeln(fmtr, "namespace {");
     writeln(fmtr, "struct Compare_p%d {", case_index);
     {
         Indent_Scope s(fmtr);
@@ -1296,17 +2693,223 @@ static void generate_comparator(Codegen* self, ast::Expr* key_expr, Token_Type k
         writeln(fmtr, "}");
         newline(fmtr);
 
+        // reversed, so the heap top is the binding with the smallest key.
         writeln(fmtr, "inline bool operator()(const S_%d& a, const S_%d& b) const {", output_index, output_index);
         {
             Indent_Scope s(fmtr);
-            writeln(fmtr, "return key(&a) < key(&b);");
+            writeln(fmtr, "return key(&b) < key(&a);");
+        }
+        writeln(fmtr, "}");
+    }
+    writeln(fmtr, "};");
+    writeln(fmtr, "}");
+    newline(fmtr);
+}
+
+// true if the expression refers to the precondition binding `binding_index`.
+static bool refers_to_binding(const ast::Expr* expr, uint32_t binding_index)
+{
+    for (const ast::Expr* node = expr; node != 0; node = preorder_next(expr, node))
+    {
+        const ast::Var* var = as_Var(node);
+        if (!var)
+            continue;
+
+        const ast::Var* def = as_Var(var->definition);
+        if (def && def->output_index == binding_index)
+            return true;
+    }
+
+    return false;
+}
+
+// true if the binding is observable by the expansion, i.e. used in the task list or in the `:sorted` key.
+static bool is_binding_used(const ast::Case* case_, uint32_t binding_index)
+{
+    for (uint32_t item_idx = 0; item_idx < size(case_->task_list); ++item_idx)
+    {
+        if (refers_to_binding(case_->task_list[item_idx], binding_index))
+            return true;
+    }
+
+    ast::Attribute* attr_sorted = find_attribute(case_, Attribute_Sorted);
+    return attr_sorted && refers_to_binding(attr_sorted->args[0], binding_index);
+}
+
+// bindings are compared only by the values used in the expansion, the rest lead to the same task list.
+static void generate_distinct(Codegen* self, uint32_t case_index, uint32_t output_index, Formatter& fmtr)
+{
+    ast::Case* case_ = self->tree->cases[case_index];
+    Signature output_sig = get_dense(self->struct_sigs, output_index);
+
+    uint32_t num_used = 0;
+    for (uint32_t param_idx = 0; param_idx < output_sig.length; ++param_idx)
+        num_used += is_binding_used(case_, param_idx) ? 1 : 0;
+
+    // no bindings used -> all bindings are equal.
+    const char* a = num_used ? "a" : "";
+    const char* b = num_used ? "b" : "";
+
+    writeln(fmtr, "namespace {");
+    writeln(fmtr, "struct Distinct_p%d {", case_index);
+    {
+        Indent_Scope s(fmtr);
+
+        writeln(fmtr, "inline uint32_t hash(const S_%d& %s) const {", output_index, a);
+        {
+            Indent_Scope s(fmtr);
+            writeln(fmtr, "uint32_t h = 0;");
+            for (uint32_t param_idx = 0; param_idx < output_sig.length; ++param_idx)
+            {
+                if (is_binding_used(case_, param_idx))
+                    writeln(fmtr, "h = hash_%s(h, a._%d);", get_runtime_type_tag(output_sig.types[param_idx]), param_idx);
+            }
+            writeln(fmtr, "return h;");
+        }
+        writeln(fmtr, "}");
+        newline(fmtr);
+
+        writeln(fmtr, "inline bool equal(const S_%d& %s, const S_%d& %s) const {", output_index, a, output_index, b);
+        {
+            Indent_Scope s(fmtr);
+            write(fmtr, "%ireturn ");
+
+            if (!num_used)
+                write(fmtr, "true");
+
+            bool first = true;
+            for (uint32_t param_idx = 0; param_idx < output_sig.length; ++param_idx)
+            {
+                if (!is_binding_used(case_, param_idx))
+                    continue;
+
+                if (!first)
+                    write(fmtr, " && ");
+
+                if (output_sig.types[param_idx] == Token_Vec3)
+                    write(fmtr, "a._%d.x == b._%d.x && a._%d.y == b._%d.y && a._%d.z == b._%d.z", param_idx, param_idx, param_idx, param_idx, param_idx, param_idx);
+                else
+                    write(fmtr, "a._%d == b._%d", param_idx, param_idx);
+
+                first = false;
+            }
+
+            write(fmtr, ";");
+            newline(fmtr);
+        }
+        writeln(fmtr, "}");
+    }
+    writeln(fmtr, "};");
+    writeln(fmtr, "}");
+    newline(fmtr);
+}
+
+static void generate_row_filter(Codegen* self, ast::Expr* literal, bool has_args, bool has_output, uint32_t case_index, uint32_t filter_index, uint32_t struct_index, uint32_t output_index, Formatter& fmtr)
+{
+    ast::Func* func = as_Func(literal);
+    ast::Fact* fact = get_fact(self->tree, func->name);
+
+    // functors of different domains have the same names, so they must have internal linkage.
+    writeln(fmtr, "namespace {");
+    writeln(fmtr, "struct Filter_p%d_%d {", case_index, filter_index);
+    {
+        Indent_Scope s(fmtr);
+
+        if (has_args)
+            writeln(fmtr, "const S_%d* args;", struct_index);
+
+        if (has_output)
+            writeln(fmtr, "const S_%d* binds;", output_index);
+
+        if (has_args && has_output)
+            writeln(fmtr, "Filter_p%d_%d(const S_%d* args, const S_%d* binds) :args(args), binds(binds) {}", case_index, filter_index, struct_index, output_index);
+        else if (has_args)
+            writeln(fmtr, "Filter_p%d_%d(const S_%d* args) :args(args) {}", case_index, filter_index, struct_index);
+        else if (has_output)
+            writeln(fmtr, "Filter_p%d_%d(const S_%d* binds) :binds(binds) {}", case_index, filter_index, output_index);
+
+        if (has_args || has_output)
+            newline(fmtr);
+
+        writeln(fmtr, "inline uint64_t operator()(const Fact_Table* table, uint32_t begin, uint32_t end) const {");
+        {
+            Indent_Scope s(fmtr);
+
+            // load column pointers once per block of rows.
+            bool used[plnnr::Max_Fact_Arity] = {};
+            for (ast::Expr* filter = literal->next_sibling; filter != 0; filter = filter->next_sibling)
+            {
+                if (!is_row_filter(self->tree, literal, filter))
+                    continue;
+
+                for (ast::Expr* node = filter; node != 0; node = preorder_next(filter, node))
+                {
+                    ast::Var* var = as_Var(node);
+                    const uint32_t column = var ? find_row_column(func, var) : size(func->args);
+                    if (column < size(func->args))
+                        used[column] = true;
+                }
+            }
+
+            for (uint32_t column = 0; column < size(func->args); ++column)
+            {
+                if (!used[column])
+                    continue;
+
+                const Token_Type column_type = fact->params[column]->data_type;
+                if (column_type == Token_Vec3)
+                    writeln(fmtr, "const Vec3_Column c%d = get_vec3_column(table, %d);", column, column);
+                else
+                    writeln(fmtr, "const %s* c%d = get_column<%s>(table, %d);", get_runtime_type_name(column_type), column, get_runtime_type_name(column_type), column);
+            }
+
+            // branch-free loop body, so the compiler can evaluate several rows per instruction.
+            writeln(fmtr, "uint64_t mask = 0;");
+            writeln(fmtr, "for (uint32_t i = begin; i < end; ++i) {");
+            {
+                Indent_Scope s(fmtr);
+                Expr_Writer visitor = { &fmtr, self->tree, func };
+                write(fmtr, "%iconst bool match = ");
+
+                bool first = true;
+                for (ast::Expr* filter = literal->next_sibling; filter != 0; filter = filter->next_sibling)
+                {
+                    if (!is_row_filter(self->tree, literal, filter))
+                        continue;
+
+                    write(fmtr, first ? "%s(" : " & %s(", is_Not(filter) ? "!bool" : "bool");
+                    visit_node<void>(is_Not(filter) ? filter->child : filter, &visitor);
+                    write(fmtr, ")");
+                    first = false;
+                }
+
+                write(fmtr, ";");
+                newline(fmtr);
+                writeln(fmtr, "mask |= uint64_t(match) << (i - begin);");
+            }
+            writeln(fmtr, "}");
+            newline(fmtr);
+            writeln(fmtr, "return mask;");
         }
         writeln(fmtr, "}");
     }
     writeln(fmtr, "};");
+    writeln(fmtr, "}");
     newline(fmtr);
 }
 
+// true if the case task list reads the task arguments (`params == true`) or the precondition bindings.
+static bool task_list_reads(const ast::Case* case_, bool params)
+{
+    for (uint32_t var_idx = 0; var_idx < size(case_->task_list_vars); ++var_idx)
+    {
+        if (is_Param(case_->task_list_vars[var_idx]->definition) == params)
+            return true;
+    }
+
+    return false;
+}
+
 template <typename Param_Node>
 static void generate_arg_setters(Codegen* self, const char* set_arg_name, ast::Func* task_func, uint32_t target_task_index, const Array<Param_Node*>& param_types, Formatter& fmtr)
 {
@@ -1359,20 +2962,21 @@ static void generate_expansion(Codegen* self, ast::Case* case_, uint32_t case_id
     Token_Value name = get(self->expand_names, case_idx);
     uint32_t yield_id = 1;
 
-    writeln(fmtr, "static bool %n(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)", name);
+    writeln(fmtr, "static bool %n(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)", name);
     writeln(fmtr, "{");
     {
         Indent_Scope s(fmtr);
 
         uint32_t struct_idx = get_dense_index(self->struct_sigs, task_idx);
-        if (get_dense(self->struct_sigs, struct_idx).length > 0)
+        const bool has_args = get_dense(self->struct_sigs, struct_idx).length > 0;
+        if (has_args)
             writeln(fmtr, "const S_%d* args = (const S_%d*)(frame->arguments);",
                 struct_idx, struct_idx);
 
         uint32_t binding_idx = get_dense_index(self->struct_sigs, size(domain->tasks) + case_idx);
         const bool has_binds = get_dense(self->struct_sigs, binding_idx).length > 0;
         if (has_binds)
-            writeln(fmtr, "const S_%d* binds = (const S_%d*)(frame->bindings);",
+            writeln(fmtr, "const S_%d* binds = (const S_%d*)(frame->bindings) + frame->binding_index;",
                 binding_idx, binding_idx);
 
         newline(fmtr);
@@ -1380,7 +2984,10 @@ static void generate_expansion(Codegen* self, ast::Case* case_, uint32_t case_id
         writeln(fmtr, "plnnr_coroutine_begin(frame, expand_label);");
         newline(fmtr);
 
-        writeln(fmtr, "while (p%d_next(state, frame, db)) {", case_idx);
+        if (find_attribute(task, Attribute_Parallel))
+            writeln(fmtr, "while (speculated_next(state, frame, db, p%d_next)) {", case_idx);
+        else
+            writeln(fmtr, "while (p%d_next(state, frame, db)) {", case_idx);
 
         // generate task list expansion
         {
@@ -1391,9 +2998,14 @@ static void generate_expansion(Codegen* self, ast::Case* case_, uint32_t case_id
                 writeln(fmtr, "frame->status = Expansion_Frame::Status_Expanded;");
                 writeln(fmtr, "plnnr_coroutine_yield(frame, expand_label, %d);", yield_id++);
             }
-            else if (has_binds)
+            else
             {
-                writeln(fmtr, "binds = binds + frame->binding_index;");
+                // precondition may have grown the expansion blob.
+                if (has_args && task_list_reads(case_, true))
+                    writeln(fmtr, "args = (const S_%d*)(frame->arguments);", struct_idx);
+
+                if (has_binds && task_list_reads(case_, false))
+                    writeln(fmtr, "binds = (const S_%d*)(frame->bindings) + frame->binding_index;", binding_idx);
             }
 
             for (uint32_t item_idx = 0; item_idx < size(case_->task_list); ++item_idx)
@@ -1486,7 +3098,7 @@ static void generate_expansion(Codegen* self, ast::Case* case_, uint32_t case_id
 
 static void generate_empty_expansion(Codegen* /*self*/, ast::Task* task, Formatter& fmtr)
 {
-    writeln(fmtr, "static bool %n_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)", task->name);
+    writeln(fmtr, "static bool %n_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)", task->name);
     writeln(fmtr, "{");
     {
         Indent_Scope s(fmtr);
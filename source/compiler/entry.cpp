@@ -122,6 +122,8 @@ bool plnnrc::compile(const Compiler_Config* config, const char* input_buffer)
             break;
         }
 
+        optimize_preconditions(&tree);
+
         generate_header(&codegen, config->header_guard, config->header_writer);
         generate_source(&codegen, config->header_file_name, config->source_writer);
 
@@ -392,6 +392,8 @@ ast::Task* plnnrc::parse_task(Parser* self)
     ast::Task* task = create_task(self->tree, tok.value, tok.loc);
     Children_Builder<ast::Param> param_builder(self, &task->params);
     plnnrc_check_return(parse_params(self, param_builder));
+    Children_Builder<ast::Attribute> attrs_builder(self, &task->attrs);
+    plnnrc_check_return(parse_attributes(self, attrs_builder));
     plnnrc_check_return(parse_task_body(self, task));
     return task;
 }
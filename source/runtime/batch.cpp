@@ -0,0 +1,489 @@
+//
+// Copyright (c) 2015 Alexander Shafranov shafranov@gmail.com
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software. If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+
+#include <string.h> // memset
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+#include "derplanner/runtime/planning.h"
+#include "derplanner/runtime/domain.h"
+#include "derplanner/runtime/batch.h"
+
+using namespace plnnr;
+
+namespace {
+
+/// Threading primitives.
+
+#if defined(_WIN32)
+
+typedef CRITICAL_SECTION Mutex;
+typedef CONDITION_VARIABLE Condition;
+typedef HANDLE Thread;
+
+void init_mutex(Mutex* mutex) { InitializeCriticalSection(mutex); }
+void destroy_mutex(Mutex* mutex) { DeleteCriticalSection(mutex); }
+void lock(Mutex* mutex) { EnterCriticalSection(mutex); }
+void unlock(Mutex* mutex) { LeaveCriticalSection(mutex); }
+
+void init_condition(Condition* cond) { InitializeConditionVariable(cond); }
+void destroy_condition(Condition*) {}
+void wait(Condition* cond, Mutex* mutex) { SleepConditionVariableCS(cond, mutex, INFINITE); }
+void notify_all(Condition* cond) { WakeAllConditionVariable(cond); }
+
+#else
+
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t Condition;
+typedef pthread_t Thread;
+
+void init_mutex(Mutex* mutex) { pthread_mutex_init(mutex, 0); }
+void destroy_mutex(Mutex* mutex) { pthread_mutex_destroy(mutex); }
+void lock(Mutex* mutex) { pthread_mutex_lock(mutex); }
+void unlock(Mutex* mutex) { pthread_mutex_unlock(mutex); }
+
+void init_condition(Condition* cond) { pthread_cond_init(cond, 0); }
+void destroy_condition(Condition* cond) { pthread_cond_destroy(cond); }
+void wait(Condition* cond, Mutex* mutex) { pthread_cond_wait(cond, mutex); }
+void notify_all(Condition* cond) { pthread_cond_broadcast(cond); }
+
+#endif
+
+// runs the job with the given index.
+typedef void Batch_Run(void* context, uint32_t job_index);
+
+}
+
+struct plnnr::Batch_Worker
+{
+    Batch_Planner*  planner;
+    // guards the deque, taken by the owner and by the stealing workers.
+    Mutex           lock;
+    // deque of job indices [head, tail), the owner pops from the tail, other workers steal from the head.
+    uint32_t*       jobs;
+    uint32_t        head;
+    uint32_t        tail;
+    // not started for the worker 0.
+    Thread          thread;
+};
+
+struct plnnr::Batch_Sync
+{
+    Mutex           lock;
+    // signaled when a batch is started or the pool is stopped.
+    Condition       started;
+    // signaled when the last worker thread is done with the batch.
+    Condition       finished;
+    // incremented for each batch.
+    uint32_t        generation;
+    // number of worker threads still working on the current batch.
+    uint32_t        num_busy;
+    // true when the worker threads should exit.
+    bool            quit;
+    // runs the jobs of the current batch.
+    Batch_Run*      run;
+    // `run` context.
+    void*           context;
+};
+
+namespace {
+
+bool pop(Batch_Worker* worker, uint32_t* job_index)
+{
+    bool result = false;
+    lock(&worker->lock);
+
+    if (worker->tail > worker->head)
+    {
+        *job_index = worker->jobs[--worker->tail];
+        result = true;
+    }
+
+    unlock(&worker->lock);
+    return result;
+}
+
+bool steal(Batch_Worker* victim, uint32_t* job_index)
+{
+    bool result = false;
+    lock(&victim->lock);
+
+    if (victim->tail > victim->head)
+    {
+        *job_index = victim->jobs[victim->head++];
+        result = true;
+    }
+
+    unlock(&victim->lock);
+    return result;
+}
+
+void run_find_plan_job(void* context, uint32_t job_index)
+{
+    Find_Plan_Job* job = static_cast<Find_Plan_Job*>(context) + job_index;
+    find_plan_init(job->state, job->domain, job->root_task);
+
+    Find_Plan_Status status = find_plan_step(job->state, job->db);
+    while (status == Find_Plan_In_Progress)
+        status = find_plan_step(job->state, job->db);
+
+    job->status = status;
+}
+
+// runs the jobs until all deques are empty, jobs are never added during the batch, so the batch is done at this point.
+void work(Batch_Worker* worker)
+{
+    Batch_Planner* planner = worker->planner;
+    const uint32_t num_workers = planner->num_workers;
+    const uint32_t worker_index = (uint32_t)(worker - planner->workers);
+    Batch_Run* run = planner->sync->run;
+    void* context = planner->sync->context;
+
+    for (;;)
+    {
+        uint32_t job_index = 0;
+        bool found = pop(worker, &job_index);
+
+        for (uint32_t i = 1; i < num_workers && !found; ++i)
+            found = steal(&planner->workers[(worker_index + i) % num_workers], &job_index);
+
+        if (!found)
+            return;
+
+        run(context, job_index);
+    }
+}
+
+void worker_main(Batch_Worker* worker)
+{
+    Batch_Sync* sync = worker->planner->sync;
+    uint32_t generation = 0;
+
+    lock(&sync->lock);
+
+    for (;;)
+    {
+        while (!sync->quit && sync->generation == generation)
+            wait(&sync->started, &sync->lock);
+
+        if (sync->quit)
+            break;
+
+        generation = sync->generation;
+
+        unlock(&sync->lock);
+        work(worker);
+        lock(&sync->lock);
+
+        if (--sync->num_busy == 0)
+            notify_all(&sync->finished);
+    }
+
+    unlock(&sync->lock);
+}
+
+#if defined(_WIN32)
+
+DWORD WINAPI worker_thread(LPVOID arg)
+{
+    worker_main(static_cast<Batch_Worker*>(arg));
+    return 0;
+}
+
+void start(Batch_Worker* worker) { worker->thread = CreateThread(0, 0, worker_thread, worker, 0, 0); }
+void join(Batch_Worker* worker) { WaitForSingleObject(worker->thread, INFINITE); CloseHandle(worker->thread); }
+
+#else
+
+void* worker_thread(void* arg)
+{
+    worker_main(static_cast<Batch_Worker*>(arg));
+    return 0;
+}
+
+void start(Batch_Worker* worker) { pthread_create(&worker->thread, 0, worker_thread, worker); }
+void join(Batch_Worker* worker) { pthread_join(worker->thread, 0); }
+
+#endif
+
+}
+
+void plnnr::init(Batch_Planner* self, Memory* mem, uint32_t num_workers)
+{
+    plnnr_assert(num_workers > 0);
+    memset(self, 0, sizeof(Batch_Planner));
+
+    self->num_workers = num_workers;
+    self->memory = mem;
+
+    self->sync = allocate<Batch_Sync>(mem, 1);
+    memset(self->sync, 0, sizeof(Batch_Sync));
+    init_mutex(&self->sync->lock);
+    init_condition(&self->sync->started);
+    init_condition(&self->sync->finished);
+
+    self->workers = allocate<Batch_Worker>(mem, num_workers);
+    memset(self->workers, 0, sizeof(Batch_Worker) * num_workers);
+
+    for (uint32_t i = 0; i < num_workers; ++i)
+    {
+        self->workers[i].planner = self;
+        init_mutex(&self->workers[i].lock);
+    }
+
+    // the thread calling `find_plans` is the worker 0.
+    for (uint32_t i = 1; i < num_workers; ++i)
+        start(&self->workers[i]);
+}
+
+void plnnr::destroy(Batch_Planner* self)
+{
+    Batch_Sync* sync = self->sync;
+
+    lock(&sync->lock);
+    sync->quit = true;
+    notify_all(&sync->started);
+    unlock(&sync->lock);
+
+    for (uint32_t i = 1; i < self->num_workers; ++i)
+        join(&self->workers[i]);
+
+    for (uint32_t i = 0; i < self->num_workers; ++i)
+        destroy_mutex(&self->workers[i].lock);
+
+    destroy_mutex(&sync->lock);
+    destroy_condition(&sync->started);
+    destroy_condition(&sync->finished);
+
+    Memory* mem = self->memory;
+    mem->deallocate(self->job_indices);
+    mem->deallocate(self->workers);
+    mem->deallocate(sync);
+    memset(self, 0, sizeof(Batch_Planner));
+}
+
+namespace {
+
+// runs `num_jobs` jobs on the workers, returns when all jobs are done.
+void run_batch(Batch_Planner* self, Batch_Run* run, void* context, uint32_t num_jobs)
+{
+    if (num_jobs > self->max_jobs)
+    {
+        self->memory->deallocate(self->job_indices);
+        self->job_indices = allocate<uint32_t>(self->memory, num_jobs);
+        self->max_jobs = num_jobs;
+    }
+
+    // jobs are dealt round-robin, each deque gets a contiguous range of `job_indices`.
+    const uint32_t num_workers = self->num_workers;
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < num_workers; ++i)
+    {
+        Batch_Worker* worker = &self->workers[i];
+        worker->jobs = self->job_indices + offset;
+        worker->head = 0;
+        worker->tail = 0;
+
+        for (uint32_t job_index = i; job_index < num_jobs; job_index += num_workers)
+            worker->jobs[worker->tail++] = job_index;
+
+        offset += worker->tail;
+    }
+
+    Batch_Sync* sync = self->sync;
+
+    lock(&sync->lock);
+    sync->run = run;
+    sync->context = context;
+    sync->num_busy = num_workers - 1;
+    ++sync->generation;
+    notify_all(&sync->started);
+    unlock(&sync->lock);
+
+    work(&self->workers[0]);
+
+    lock(&sync->lock);
+    while (sync->num_busy > 0)
+        wait(&sync->finished, &sync->lock);
+    unlock(&sync->lock);
+}
+
+// cases of a single task evaluated at once.
+struct Speculation_Batch
+{
+    Speculation*            speculation;
+    const Domain_Info*      domain;
+    const Fact_Database*    db;
+    // global index of the first case in the window.
+    uint32_t                first_global_case;
+};
+
+void run_speculation_slot(void* context, uint32_t slot_index)
+{
+    Speculation_Batch* batch = static_cast<Speculation_Batch*>(context);
+    Speculation_Slot* slot = batch->speculation->slots + slot_index;
+    const uint32_t global_case_index = batch->first_global_case + slot_index;
+    const Task_Info& info = batch->domain->task_info;
+
+    // collecting preconditions allocate from the expansion blob, they are evaluated when the case is expanded.
+    if (info.collects_bindings[global_case_index])
+    {
+        slot->result = Speculation_None;
+        return;
+    }
+
+    Case_Precondition* precond = info.case_preconds[global_case_index];
+    slot->result = precond(&slot->state, &slot->frame, batch->db) ? Speculation_Found : Speculation_Empty;
+}
+
+// evaluates preconditions of the cases [frame->case_index, frame->case_index + num_cases) of the task `task_id`.
+void speculate(Planning_State* state, const Domain_Info* domain, uint32_t task_id, const Expansion_Frame* frame, const Fact_Database* db, uint32_t num_cases)
+{
+    Speculation* speculation = state->speculation;
+    const Task_Info& info = domain->task_info;
+    const uint32_t first_global_case = info.first_case[task_id - info.num_primitive] + frame->case_index;
+
+    for (uint32_t slot_index = 0; slot_index < num_cases; ++slot_index)
+    {
+        Speculation_Slot* slot = speculation->slots + slot_index;
+        const uint32_t global_case_index = first_global_case + slot_index;
+
+        // the slot state differs from `state` only in the expansion blob, which is the slot data.
+        memcpy(&slot->state, state, sizeof(Planning_State));
+        uint8_t* data = speculation->slot_data + speculation->slot_data_size * slot_index;
+        slot->state.expansion_blob.base = data;
+        slot->state.expansion_blob.top = data;
+        slot->state.expansion_blob.max_size = speculation->slot_data_size;
+        slot->state.growth = false;
+        slot->state.speculation = 0;
+
+        memset(&slot->frame, 0, sizeof(Expansion_Frame));
+        slot->frame.case_index = frame->case_index + slot_index;
+        slot->frame.arguments = frame->arguments;
+        allocate_precond_handles(&slot->state, &slot->frame, info.num_case_handles[global_case_index]);
+        allocate_precond_bindings(&slot->state, &slot->frame, &info.bindings[global_case_index]);
+    }
+
+    Speculation_Batch batch = { speculation, domain, db, first_global_case };
+    run_batch(speculation->pool, run_speculation_slot, &batch, num_cases);
+
+    for (uint32_t slot_index = 0; slot_index < num_cases; ++slot_index)
+        state->precond_iterations += speculation->slots[slot_index].state.precond_iterations - state->precond_iterations;
+
+    speculation->frame = frame;
+    speculation->task_type = task_id;
+    speculation->first_case = frame->case_index;
+    speculation->num_cases = num_cases;
+}
+
+void free_speculation(Planning_State* self)
+{
+    Speculation* speculation = self->speculation;
+    if (!speculation)
+        return;
+
+    Memory* mem = self->memory;
+    mem->deallocate(speculation->slot_data);
+    mem->deallocate(speculation->slots);
+    mem->deallocate(speculation);
+    self->speculation = 0;
+}
+
+void apply_speculation(Planning_State* state, const Domain_Info* domain, uint32_t task_id, Expansion_Frame* frame, const Fact_Database* db)
+{
+    Speculation* speculation = state->speculation;
+    const uint32_t case_index = frame->case_index;
+
+    const bool evaluated = speculation->frame == frame && speculation->task_type == task_id &&
+        case_index >= speculation->first_case && case_index < speculation->first_case + speculation->num_cases;
+
+    if (!evaluated)
+    {
+        const uint32_t num_task_cases = domain->task_info.num_cases[task_id - domain->task_info.num_primitive];
+        const uint32_t num_cases = (num_task_cases - case_index < speculation->max_cases) ? num_task_cases - case_index : speculation->max_cases;
+
+        // a single case is evaluated when expanded.
+        if (num_cases < 2)
+            return;
+
+        speculate(state, domain, task_id, frame, db, num_cases);
+    }
+
+    const Speculation_Slot* slot = speculation->slots + (case_index - speculation->first_case);
+    if (slot->result == Speculation_Found)
+    {
+        const uint32_t global_case_index = domain->task_info.first_case[task_id - domain->task_info.num_primitive] + case_index;
+
+        if (frame->num_handles)
+            memcpy(frame->handles, slot->frame.handles, sizeof(Fact_Handle) * frame->num_handles);
+
+        if (frame->bindings)
+            memcpy(frame->bindings, slot->frame.bindings, domain->task_info.bindings[global_case_index].size);
+
+        frame->precond_label = slot->frame.precond_label;
+        frame->num_bindings = slot->frame.num_bindings;
+        frame->binding_index = slot->frame.binding_index;
+    }
+
+    frame->speculation = (uint16_t)(slot->result);
+}
+
+}
+
+void plnnr::find_plans(Batch_Planner* self, Find_Plan_Job* jobs, uint32_t num_jobs)
+{
+    run_batch(self, run_find_plan_job, jobs, num_jobs);
+}
+
+void plnnr::set_speculation(Planning_State* self, const Domain_Info* domain, Batch_Planner* pool, uint32_t max_cases)
+{
+    free_speculation(self);
+
+    if (!pool || max_cases < 2)
+        return;
+
+    // slots fit the handles & bindings of any case of the `:parallel` tasks.
+    const Task_Info& info = domain->task_info;
+    uint32_t slot_data_size = 0;
+    for (uint32_t compound_id = 0; compound_id < info.num_compound; ++compound_id)
+    {
+        const uint32_t cost = info.frame_costs[info.num_primitive + compound_id];
+        if (info.parallel[compound_id] && cost > slot_data_size)
+            slot_data_size = cost;
+    }
+
+    Memory* mem = self->memory;
+    Speculation* speculation = allocate<Speculation>(mem, 1);
+    memset(speculation, 0, sizeof(Speculation));
+    speculation->pool = pool;
+    speculation->apply = apply_speculation;
+    speculation->max_cases = max_cases;
+    speculation->slots = allocate<Speculation_Slot>(mem, max_cases);
+    memset(speculation->slots, 0, sizeof(Speculation_Slot) * max_cases);
+    speculation->slot_data_size = (uint32_t)(align(slot_data_size, plnnr::default_alignment));
+    speculation->slot_data = allocate<uint8_t>(mem, speculation->slot_data_size * max_cases + 1, plnnr::default_alignment);
+    self->speculation = speculation;
+}
@@ -19,6 +19,8 @@
 //
 
 #include <string.h> // memset, strlen
+#include <math.h> // logf
+#include <algorithm> // std::sort
 #include "derplanner/runtime/database.h"
 
 using namespace plnnr;
@@ -35,6 +37,304 @@ static size_t get_blob_size(const Fact_Type* format, uint32_t max_entries)
     return size;
 }
 
+// number of separately stored planes of the column, vec3 columns in `Vec3_Layout_Planes` have a plane per component.
+static uint32_t get_num_planes(const Fact_Table* self, uint8_t column)
+{
+    return (self->vec3_layout == Vec3_Layout_Planes && self->format.types[column] == Type_Vec3) ? 3 : 1;
+}
+
+static uint32_t get_num_buckets(uint32_t max_entries)
+{
+    uint32_t num_buckets = 1;
+    while (num_buckets < max_entries)
+    {
+        num_buckets <<= 1;
+    }
+
+    return num_buckets;
+}
+
+static uint32_t hash_entry(const Fact_Table* self, const Fact_Index_Format* format, uint32_t entry_index)
+{
+    uint32_t hash = 0;
+
+    for (uint8_t i = 0; i < format->num_columns; ++i)
+    {
+        const uint8_t column = format->columns[i];
+
+        switch (self->format.types[column])
+        {
+        #define PLNNR_TYPE(TYPE_TAG, TYPE_NAME)                                     \
+        case Type_##TYPE_TAG:                                                       \
+            hash = hash_##TYPE_TAG(hash, as_##TYPE_TAG(self, entry_index, column)); \
+            break;                                                                  \
+
+        #include "derplanner/runtime/type_tags.inl"
+        #undef PLNNR_TYPE
+        default:
+            plnnr_assert(false);
+            break;
+        }
+    }
+
+    return hash;
+}
+
+static uint32_t hash_column_value(const Fact_Table* self, uint32_t column, uint32_t entry_index)
+{
+    switch (self->format.types[column])
+    {
+    #define PLNNR_TYPE(TYPE_TAG, TYPE_NAME)                                 \
+    case Type_##TYPE_TAG:                                                   \
+        return hash_##TYPE_TAG(0, as_##TYPE_TAG(self, entry_index, column)); \
+
+    #include "derplanner/runtime/type_tags.inl"
+    #undef PLNNR_TYPE
+    default:
+        plnnr_assert(false);
+        return 0;
+    }
+}
+
+static void insert_entry(Fact_Index* index, uint32_t entry_index, uint32_t hash)
+{
+    const uint32_t bucket = hash & (index->num_buckets - 1);
+
+    index->hashes[entry_index] = hash;
+    index->next[entry_index] = Fact_Index_End;
+
+    if (index->heads[bucket] == Fact_Index_End)
+    {
+        index->heads[bucket] = entry_index;
+    }
+    else
+    {
+        index->next[index->tails[bucket]] = entry_index;
+    }
+
+    index->tails[bucket] = entry_index;
+}
+
+// links `entry_index` into its bucket chain, keeping the chain in ascending entry order.
+static void link_entry(Fact_Index* index, uint32_t entry_index, uint32_t hash)
+{
+    const uint32_t bucket = hash & (index->num_buckets - 1);
+    index->hashes[entry_index] = hash;
+
+    uint32_t prev = Fact_Index_End;
+    uint32_t curr = index->heads[bucket];
+
+    while (curr != Fact_Index_End && curr < entry_index)
+    {
+        prev = curr;
+        curr = index->next[curr];
+    }
+
+    index->next[entry_index] = curr;
+
+    if (prev == Fact_Index_End)
+    {
+        index->heads[bucket] = entry_index;
+    }
+    else
+    {
+        index->next[prev] = entry_index;
+    }
+
+    if (curr == Fact_Index_End)
+    {
+        index->tails[bucket] = entry_index;
+    }
+}
+
+// unlinks `entry_index` from its bucket chain. `next` of the unlinked entry is kept intact,
+// so iteration which is currently at `entry_index` continues with the rest of the chain.
+static void unlink_entry(Fact_Index* index, uint32_t entry_index)
+{
+    const uint32_t bucket = index->hashes[entry_index] & (index->num_buckets - 1);
+
+    uint32_t prev = Fact_Index_End;
+    uint32_t curr = index->heads[bucket];
+
+    while (curr != entry_index)
+    {
+        plnnr_assert(curr != Fact_Index_End);
+        prev = curr;
+        curr = index->next[curr];
+    }
+
+    if (prev == Fact_Index_End)
+    {
+        index->heads[bucket] = index->next[entry_index];
+    }
+    else
+    {
+        index->next[prev] = index->next[entry_index];
+    }
+
+    if (index->tails[bucket] == entry_index)
+    {
+        index->tails[bucket] = prev;
+    }
+}
+
+// resets bucket chains and indexes all table entries, except the removed ones.
+static void reindex(Fact_Table* self, Fact_Index* index)
+{
+    memset(index->heads, 0xff, sizeof(uint32_t) * index->num_buckets);
+
+    for (uint32_t entry_index = 0; entry_index < self->num_entries; ++entry_index)
+    {
+        if (self->num_removed > 0 && self->removed[entry_index])
+        {
+            continue;
+        }
+
+        insert_entry(index, entry_index, hash_entry(self, &index->format, entry_index));
+    }
+}
+
+// returns true if the index is built on `column`.
+static bool has_column(const Fact_Index_Format* format, uint32_t column)
+{
+    for (uint8_t i = 0; i < format->num_columns; ++i)
+    {
+        if (format->columns[i] == column)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// (re)allocates index storage for `max_entries` and indexes all table entries.
+static void build_index(Fact_Table* self, Fact_Index* index, uint32_t max_entries)
+{
+    Memory* mem = self->memory;
+
+    if (index->blob)
+    {
+        mem->deallocate(index->blob);
+    }
+
+    const uint32_t num_buckets = get_num_buckets(max_entries);
+    const size_t size = plnnr_alignof(uint32_t) + sizeof(uint32_t) * (2 * num_buckets + 2 * max_entries);
+
+    void* blob = mem->allocate(size);
+    uint32_t* data = plnnr::align<uint32_t>(blob);
+
+    index->blob = blob;
+    index->num_buckets = num_buckets;
+    index->heads = data;
+    index->tails = index->heads + num_buckets;
+    index->next = index->tails + num_buckets;
+    index->hashes = index->next + max_entries;
+
+    reindex(self, index);
+}
+
+// ordering of `Fact_Ordered_Index` values: NaNs are placed after all other values.
+template <typename T>
+static inline bool ordered_less(const T& a, const T& b)
+{
+    return a < b || (is_ordered_value(a) && !is_ordered_value(b));
+}
+
+template <typename T>
+struct Ordered_Entry_Less
+{
+    const T* column;
+
+    bool operator()(uint32_t a, uint32_t b) const
+    {
+        if (ordered_less(column[a], column[b])) { return true; }
+        if (ordered_less(column[b], column[a])) { return false; }
+        return a < b;
+    }
+};
+
+template <typename T>
+static void sort_ordered(const T* column, uint32_t* entries, uint32_t num_entries)
+{
+    for (uint32_t i = 0; i < num_entries; ++i)
+    {
+        entries[i] = i;
+    }
+
+    Ordered_Entry_Less<T> less = { column };
+    std::sort(entries, entries + num_entries, less);
+}
+
+// inserts `entry_index` after all entries with equal values, so the equal values are kept in entry order.
+template <typename T>
+static void insert_ordered(const T* column, uint32_t* entries, uint32_t num_entries, uint32_t entry_index)
+{
+    const T value = column[entry_index];
+
+    uint32_t lo = 0;
+    uint32_t hi = num_entries;
+    while (lo < hi)
+    {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        if (ordered_less(value, column[entries[mid]])) { hi = mid; } else { lo = mid + 1; }
+    }
+
+    memmove(entries + lo + 1, entries + lo, sizeof(uint32_t) * (num_entries - lo));
+    entries[lo] = entry_index;
+}
+
+// returns the position of `entry_index` in the ordered index, which must be ordered by (value, entry).
+template <typename T>
+static uint32_t lower_bound_ordered(const T* column, const uint32_t* entries, uint32_t num_entries, uint32_t entry_index)
+{
+    Ordered_Entry_Less<T> less = { column };
+    return static_cast<uint32_t>(std::lower_bound(entries, entries + num_entries, entry_index, less) - entries);
+}
+
+// inserts `entry_index` keeping the (value, entry) order, used for entries which are not the last one.
+template <typename T>
+static void link_ordered(const T* column, uint32_t* entries, uint32_t num_entries, uint32_t entry_index)
+{
+    const uint32_t pos = lower_bound_ordered(column, entries, num_entries, entry_index);
+    memmove(entries + pos + 1, entries + pos, sizeof(uint32_t) * (num_entries - pos));
+    entries[pos] = entry_index;
+}
+
+// erases `entry_index`, the column must still hold the value `entry_index` was ordered by.
+template <typename T>
+static void unlink_ordered(const T* column, uint32_t* entries, uint32_t num_entries, uint32_t entry_index)
+{
+    const uint32_t pos = lower_bound_ordered(column, entries, num_entries, entry_index);
+    plnnr_assert(pos < num_entries && entries[pos] == entry_index);
+    memmove(entries + pos, entries + pos + 1, sizeof(uint32_t) * (num_entries - pos - 1));
+}
+
+#define PLNNR_ORDERED_DISPATCH(TABLE, COLUMN, FUNC, ...)                                                \
+    switch ((TABLE)->format.types[COLUMN])                                                              \
+    {                                                                                                   \
+    case Type_Int8:  FUNC(static_cast<const int8_t*>((TABLE)->columns[COLUMN]), __VA_ARGS__); break;    \
+    case Type_Int32: FUNC(static_cast<const int32_t*>((TABLE)->columns[COLUMN]), __VA_ARGS__); break;   \
+    case Type_Int64: FUNC(static_cast<const int64_t*>((TABLE)->columns[COLUMN]), __VA_ARGS__); break;   \
+    case Type_Float: FUNC(static_cast<const float*>((TABLE)->columns[COLUMN]), __VA_ARGS__); break;     \
+    default: plnnr_assert(false); break;                                                                \
+    }                                                                                                   \
+
+// (re)allocates ordered index storage for `max_entries` and orders all table entries.
+static void build_ordered_index(Fact_Table* self, Fact_Ordered_Index* index, uint32_t max_entries)
+{
+    Memory* mem = self->memory;
+
+    if (index->entries)
+    {
+        mem->deallocate(index->entries);
+    }
+
+    index->entries = allocate<uint32_t>(mem, max_entries > 0 ? max_entries : 1);
+
+    PLNNR_ORDERED_DISPATCH(self, index->column, sort_ordered, index->entries, self->num_entries);
+}
+
 void plnnr::init(Fact_Table* self, Memory* mem, const Fact_Type* format, uint32_t max_entries)
 {
     memset(self, 0, sizeof(Fact_Table));
@@ -65,7 +365,27 @@ void plnnr::init(Fact_Table* self, Memory* mem, const Fact_Type* format, uint32_
 void plnnr::destroy(Fact_Table* self)
 {
     Memory* mem = self->memory;
-    mem->deallocate(self->blob);
+
+    for (uint32_t i = 0; i < self->num_indexes; ++i)
+    {
+        mem->deallocate(self->indexes[i].blob);
+    }
+
+    for (uint32_t i = 0; i < self->num_ordered_indexes; ++i)
+    {
+        mem->deallocate(self->ordered_indexes[i].entries);
+    }
+
+    if (self->removed)
+    {
+        mem->deallocate(self->removed);
+    }
+
+    if (self->blob)
+    {
+        mem->deallocate(self->blob);
+    }
+
     memset(self, 0, sizeof(Fact_Table));
 }
 
@@ -91,95 +411,1014 @@ void plnnr::set_max_entries(Fact_Table* self, uint32_t max_entries)
         uint8_t* new_column = static_cast<uint8_t*>(plnnr::align(bytes, param_align));
         bytes = new_column + max_entries * get_type_size(param_type);
         const uint8_t* old_column = (const uint8_t*)(self->columns[i]);
-        memcpy(new_column, old_column, self->num_entries * get_type_size(param_type));
+        const uint32_t num_planes = get_num_planes(self, i);
+        const size_t plane_size = get_type_size(param_type) / num_planes;
+
+        for (uint32_t p = 0; p < num_planes; ++p)
+        {
+            memcpy(new_column + p * max_entries * plane_size, old_column + p * self->max_entries * plane_size, self->num_entries * plane_size);
+        }
+
         self->columns[i] = new_column;
     }
 
     self->max_entries = max_entries;
 
-    mem->deallocate(old_blob);
+    if (old_blob)
+    {
+        mem->deallocate(old_blob);
+    }
+
+    if (self->removed)
+    {
+        uint8_t* old_removed = self->removed;
+        self->removed = allocate<uint8_t>(mem, max_entries > 0 ? max_entries : 1);
+        memset(self->removed, 0, max_entries);
+        memcpy(self->removed, old_removed, self->num_entries);
+        mem->deallocate(old_removed);
+    }
+
+    for (uint32_t i = 0; i < self->num_indexes; ++i)
+    {
+        build_index(self, self->indexes + i, max_entries);
+    }
+
+    for (uint32_t i = 0; i < self->num_ordered_indexes; ++i)
+    {
+        build_ordered_index(self, self->ordered_indexes + i, max_entries);
+    }
 }
 
-void plnnr::init(Fact_Database* self, Memory* mem, const Database_Format* format)
+// reserves space for `count` entries at the end of the table, returns index of the first one.
+static uint32_t push_entries(Fact_Table* self, uint32_t count)
 {
-    memset(self, 0, sizeof(Fact_Database));
+    const uint32_t first_entry = self->num_entries;
 
-    self->num_tables = format->num_tables;
-    self->max_tables = format->num_tables;
-    self->hash_seed = format->hash_seed;
+    if (!self->blob)
+    {
+        reserve_snapshot(self, first_entry + count);
+    }
+    else if (first_entry + count > self->max_entries && self->growth)
+    {
+        reserve(self, first_entry + count);
+    }
 
-    const uint32_t max_tables = format->num_tables;
-    // hashes
-    size_t size = plnnr_alignof(uint32_t) + sizeof(uint32_t) * max_tables;
-    // names
-    size = align(size, plnnr_alignof(void*));
-    size += sizeof(void*) * max_tables;
-    // tables
-    size = align(size, plnnr_alignof(Fact_Table));
-    size += sizeof(Fact_Table) * max_tables;
+    plnnr_assert(first_entry + count <= self->max_entries);
+    self->num_entries += count;
 
-    void* blob = mem->allocate(size);
-    self->blob = blob;
-    uint8_t* bytes = static_cast<uint8_t*>(blob);
+    if (self->num_entries > self->high_water_mark)
+    {
+        self->high_water_mark = self->num_entries;
+    }
 
-    self->hashes = plnnr::align<uint32_t>(bytes);
-    bytes += sizeof(uint32_t) * max_tables;
-    self->names = plnnr::align<const char*>(bytes);
-    bytes += sizeof(void*) * max_tables;
-    self->tables = plnnr::align<Fact_Table>(bytes);
+    return first_entry;
+}
 
-    for (uint32_t i = 0; i < format->num_tables; ++i)
+// indexes entries appended by `add_entries`.
+static void index_entries(Fact_Table* self, uint32_t first_entry, uint32_t count)
+{
+    for (uint32_t i = 0; i < self->num_indexes; ++i)
     {
-        uint32_t size_hint = format->size_hints[i];
-        uint32_t max_entries = ( size_hint > 0 ) ? size_hint : 128;
-        self->hashes[i] = format->hashes[i];
-        self->names[i] = format->names[i];
-        init(self->tables + i, mem, format->types + i, max_entries);
+        Fact_Index* index = self->indexes + i;
+
+        for (uint32_t entry_index = first_entry; entry_index < first_entry + count; ++entry_index)
+        {
+            insert_entry(index, entry_index, hash_entry(self, &index->format, entry_index));
+        }
     }
 
-    self->memory = mem;
+    // a single sort is cheaper than inserting the new entries one by one.
+    for (uint32_t i = 0; i < self->num_ordered_indexes; ++i)
+    {
+        Fact_Ordered_Index* index = self->ordered_indexes + i;
+        PLNNR_ORDERED_DISPATCH(self, index->column, sort_ordered, index->entries, self->num_entries);
+    }
 }
 
-void plnnr::destroy(Fact_Database* self)
+void plnnr::add_entries(Fact_Table* self, uint32_t count, const void* const* columns)
 {
+    if (count == 0)
+    {
+        return;
+    }
+
+    const uint32_t first_entry = push_entries(self, count);
+
+    for (uint8_t i = 0; i < self->format.num_params; ++i)
+    {
+        const size_t size = get_type_size(self->format.types[i]);
+        uint8_t* column = static_cast<uint8_t*>(self->columns[i]);
+        const uint32_t num_planes = get_num_planes(self, i);
+
+        if (num_planes == 1)
+        {
+            memcpy(column + first_entry * size, columns[i], count * size);
+            continue;
+        }
+
+        const size_t plane_size = size / num_planes;
+        for (uint32_t p = 0; p < num_planes; ++p)
+        {
+            uint8_t* dst = column + (p * self->max_entries + first_entry) * plane_size;
+            const uint8_t* src = static_cast<const uint8_t*>(columns[i]) + p * plane_size;
+
+            for (uint32_t j = 0; j < count; ++j, dst += plane_size, src += size)
+            {
+                memcpy(dst, src, plane_size);
+            }
+        }
+    }
+
+    index_entries(self, first_entry, count);
+    update_stats(self, first_entry, count);
+}
+
+void plnnr::add_entries(Fact_Table* self, uint32_t count, const void* rows, const Param_Layout* layout, size_t stride)
+{
+    plnnr_assert(layout->num_params == self->format.num_params);
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    const uint32_t first_entry = push_entries(self, count);
+
+    for (uint8_t i = 0; i < self->format.num_params; ++i)
+    {
+        plnnr_assert(layout->types[i] == self->format.types[i]);
+        const uint32_t num_planes = get_num_planes(self, i);
+        const size_t plane_size = get_type_size(self->format.types[i]) / num_planes;
+
+        for (uint32_t p = 0; p < num_planes; ++p)
+        {
+            uint8_t* column = static_cast<uint8_t*>(self->columns[i]) + (p * self->max_entries + first_entry) * plane_size;
+            const uint8_t* src = static_cast<const uint8_t*>(rows) + layout->offsets[i] + p * plane_size;
+
+            for (uint32_t j = 0; j < count; ++j, column += plane_size, src += stride)
+            {
+                memcpy(column, src, plane_size);
+            }
+        }
+    }
+
+    index_entries(self, first_entry, count);
+    update_stats(self, first_entry, count);
+}
+
+void plnnr::set_growth(Fact_Table* self, Fact_Table_Growth* growth)
+{
+    self->growth = growth;
+}
+
+uint32_t plnnr::growth_double(const Fact_Table* self, uint32_t required_entries)
+{
+    uint32_t max_entries = self->max_entries > 0 ? self->max_entries : 1;
+
+    while (max_entries < required_entries)
+    {
+        max_entries *= 2;
+    }
+
+    return max_entries;
+}
+
+void plnnr::set_vec3_layout(Fact_Table* self, Vec3_Layout layout)
+{
+    if (self->vec3_layout == layout)
+    {
+        return;
+    }
+
+    copy_snapshot_columns(self);
+
     Memory* mem = self->memory;
+    Vec3* values = self->num_entries > 0 ? allocate<Vec3>(mem, self->num_entries) : 0;
+    const Vec3_Layout old_layout = self->vec3_layout;
 
-    for (uint32_t i = 0; i < self->num_tables; ++i)
+    // values are read in the old layout and written back in the new one.
+    for (uint8_t i = 0; i < self->format.num_params; ++i)
     {
-        Fact_Table* table = self->tables + i;
-        destroy(table);
+        if (self->format.types[i] != Type_Vec3)
+        {
+            continue;
+        }
+
+        self->vec3_layout = old_layout;
+        for (uint32_t entry_index = 0; entry_index < self->num_entries; ++entry_index)
+        {
+            values[entry_index] = load_value<Vec3>(self, i, entry_index);
+        }
+
+        self->vec3_layout = layout;
+        for (uint32_t entry_index = 0; entry_index < self->num_entries; ++entry_index)
+        {
+            store_value(self, i, entry_index, values[entry_index]);
+        }
     }
 
-    mem->deallocate(self->blob);
-    memset(self, 0, sizeof(Fact_Database));
+    self->vec3_layout = layout;
+
+    if (values)
+    {
+        mem->deallocate(values);
+    }
 }
 
-const Fact_Table* plnnr::find_table(const Fact_Database* self, const char* fact_name)
+void plnnr::reserve(Fact_Table* self, uint32_t num_entries)
 {
-    const uint32_t seed = self->hash_seed;
-    const uint32_t hash = murmur2_32(fact_name, (uint32_t)strlen(fact_name), seed);
-    const uint32_t* db_hashes = self->hashes;
-    const uint32_t num_hashes = self->num_tables;
-    const Fact_Table* db_tables = self->tables;
+    if (num_entries <= self->max_entries)
+    {
+        return;
+    }
 
-    for (uint32_t i = 0; i < num_hashes; ++i)
-        if (hash == db_hashes[i])
-            return &db_tables[i];
+    plnnr_assert(self->growth);
+    const uint32_t max_entries = self->growth(self, num_entries);
+    plnnr_assert(max_entries >= num_entries);
+    set_max_entries(self, max_entries);
+}
 
-    return 0;
+uint32_t plnnr::add_index(Fact_Table* self, const Fact_Index_Format* format)
+{
+    plnnr_assert(self->num_indexes < Max_Fact_Indexes);
+    plnnr_assert(format->num_columns > 0 && format->num_columns <= self->format.num_params);
+
+    const uint32_t result = self->num_indexes++;
+    Fact_Index* index = self->indexes + result;
+    memset(index, 0, sizeof(Fact_Index));
+    index->format = *format;
+
+    build_index(self, index, self->max_entries);
+
+    return result;
 }
 
-Fact_Table* plnnr::find_table(Fact_Database* self, const char* fact_name)
+uint32_t plnnr::add_ordered_index(Fact_Table* self, uint8_t column)
 {
-    const uint32_t seed = self->hash_seed;
-    const uint32_t hash = murmur2_32(fact_name, (uint32_t)strlen(fact_name), seed);
-    const uint32_t* db_hashes = self->hashes;
-    const uint32_t num_hashes = self->num_tables;
-    Fact_Table* db_tables = self->tables;
+    plnnr_assert(self->num_ordered_indexes < Max_Fact_Indexes);
+    plnnr_assert(column < self->format.num_params);
 
-    for (uint32_t i = 0; i < num_hashes; ++i)
-        if (hash == db_hashes[i])
-            return &db_tables[i];
+    const uint32_t result = self->num_ordered_indexes++;
+    Fact_Ordered_Index* index = self->ordered_indexes + result;
+    memset(index, 0, sizeof(Fact_Ordered_Index));
+    index->column = column;
 
-    return 0;
+    build_ordered_index(self, index, self->max_entries);
+
+    return result;
+}
+
+void plnnr::update_indexes(Fact_Table* self, uint32_t entry_index)
+{
+    plnnr_assert(entry_index < self->num_entries);
+
+    for (uint32_t i = 0; i < self->num_indexes; ++i)
+    {
+        Fact_Index* index = self->indexes + i;
+        insert_entry(index, entry_index, hash_entry(self, &index->format, entry_index));
+    }
+
+    // entries are appended, so all entries except the new one are already ordered.
+    for (uint32_t i = 0; i < self->num_ordered_indexes; ++i)
+    {
+        Fact_Ordered_Index* index = self->ordered_indexes + i;
+        PLNNR_ORDERED_DISPATCH(self, index->column, insert_ordered, index->entries, entry_index, entry_index);
+    }
+}
+
+void plnnr::unlink_indexes(Fact_Table* self, uint32_t entry_index, uint32_t param_index)
+{
+    plnnr_assert(entry_index < self->num_entries);
+
+    for (uint32_t i = 0; i < self->num_indexes; ++i)
+    {
+        Fact_Index* index = self->indexes + i;
+        if (has_column(&index->format, param_index))
+        {
+            unlink_entry(index, entry_index);
+        }
+    }
+
+    for (uint32_t i = 0; i < self->num_ordered_indexes; ++i)
+    {
+        Fact_Ordered_Index* index = self->ordered_indexes + i;
+        if (index->column == param_index)
+        {
+            PLNNR_ORDERED_DISPATCH(self, index->column, unlink_ordered, index->entries, self->num_entries, entry_index);
+        }
+    }
+}
+
+void plnnr::link_indexes(Fact_Table* self, uint32_t entry_index, uint32_t param_index)
+{
+    plnnr_assert(entry_index < self->num_entries);
+
+    for (uint32_t i = 0; i < self->num_indexes; ++i)
+    {
+        Fact_Index* index = self->indexes + i;
+        if (has_column(&index->format, param_index))
+        {
+            link_entry(index, entry_index, hash_entry(self, &index->format, entry_index));
+        }
+    }
+
+    // the entry was unlinked, so the ordered index holds one entry less.
+    for (uint32_t i = 0; i < self->num_ordered_indexes; ++i)
+    {
+        Fact_Ordered_Index* index = self->ordered_indexes + i;
+        if (index->column == param_index)
+        {
+            PLNNR_ORDERED_DISPATCH(self, index->column, link_ordered, index->entries, self->num_entries - 1, entry_index);
+        }
+    }
+}
+
+static void copy_entry(Fact_Table* self, uint32_t dst_index, uint32_t src_index)
+{
+    for (uint8_t i = 0; i < self->format.num_params; ++i)
+    {
+        const uint32_t num_planes = get_num_planes(self, i);
+        const size_t plane_size = get_type_size(self->format.types[i]) / num_planes;
+
+        for (uint32_t p = 0; p < num_planes; ++p)
+        {
+            uint8_t* plane = static_cast<uint8_t*>(self->columns[i]) + p * self->max_entries * plane_size;
+            memcpy(plane + dst_index * plane_size, plane + src_index * plane_size, plane_size);
+        }
+    }
+}
+
+void plnnr::remove_entry(Fact_Table* self, uint32_t entry_index)
+{
+    plnnr_assert(entry_index < self->num_entries);
+    copy_snapshot_columns(self);
+
+    const uint32_t last_index = self->num_entries - 1;
+    const bool entry_removed = is_removed(self, entry_index);
+    const bool last_removed = is_removed(self, last_index);
+
+    // removed entries are already unlinked from the bucket chains.
+    for (uint32_t i = 0; i < self->num_indexes; ++i)
+    {
+        Fact_Index* index = self->indexes + i;
+
+        if (!entry_removed)
+        {
+            unlink_entry(index, entry_index);
+        }
+
+        if (last_index != entry_index && !last_removed)
+        {
+            unlink_entry(index, last_index);
+        }
+    }
+
+    // removed entries are kept in the ordered indexes.
+    for (uint32_t i = 0; i < self->num_ordered_indexes; ++i)
+    {
+        Fact_Ordered_Index* index = self->ordered_indexes + i;
+        PLNNR_ORDERED_DISPATCH(self, index->column, unlink_ordered, index->entries, self->num_entries, entry_index);
+
+        if (last_index != entry_index)
+        {
+            PLNNR_ORDERED_DISPATCH(self, index->column, unlink_ordered, index->entries, self->num_entries - 1, last_index);
+        }
+    }
+
+    if (entry_removed)
+    {
+        --self->num_removed;
+    }
+
+    if (last_index != entry_index)
+    {
+        copy_entry(self, entry_index, last_index);
+
+        if (self->removed)
+        {
+            self->removed[entry_index] = self->removed[last_index];
+        }
+
+        for (uint32_t i = 0; i < self->num_indexes; ++i)
+        {
+            Fact_Index* index = self->indexes + i;
+
+            if (!last_removed)
+            {
+                link_entry(index, entry_index, index->hashes[last_index]);
+            }
+        }
+
+        for (uint32_t i = 0; i < self->num_ordered_indexes; ++i)
+        {
+            Fact_Ordered_Index* index = self->ordered_indexes + i;
+            PLNNR_ORDERED_DISPATCH(self, index->column, link_ordered, index->entries, self->num_entries - 2, entry_index);
+        }
+    }
+
+    if (self->removed)
+    {
+        self->removed[last_index] = 0;
+    }
+
+    self->num_entries = last_index;
+}
+
+void plnnr::remove_entry_stable(Fact_Table* self, uint32_t entry_index)
+{
+    plnnr_assert(entry_index < self->num_entries);
+
+    if (!self->removed)
+    {
+        const uint32_t max_entries = self->max_entries > 0 ? self->max_entries : 1;
+        self->removed = allocate<uint8_t>(self->memory, max_entries);
+        memset(self->removed, 0, max_entries);
+    }
+
+    if (self->removed[entry_index])
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < self->num_indexes; ++i)
+    {
+        unlink_entry(self->indexes + i, entry_index);
+    }
+
+    self->removed[entry_index] = 1;
+    ++self->num_removed;
+}
+
+void plnnr::compact(Fact_Table* self)
+{
+    if (self->num_removed == 0)
+    {
+        return;
+    }
+
+    copy_snapshot_columns(self);
+
+    uint32_t num_live = 0;
+
+    for (uint32_t entry_index = 0; entry_index < self->num_entries; ++entry_index)
+    {
+        if (self->removed[entry_index])
+        {
+            continue;
+        }
+
+        if (num_live != entry_index)
+        {
+            copy_entry(self, num_live, entry_index);
+        }
+
+        ++num_live;
+    }
+
+    memset(self->removed, 0, self->num_entries);
+    self->num_entries = num_live;
+    self->num_removed = 0;
+
+    for (uint32_t i = 0; i < self->num_indexes; ++i)
+    {
+        reindex(self, self->indexes + i);
+    }
+
+    for (uint32_t i = 0; i < self->num_ordered_indexes; ++i)
+    {
+        Fact_Ordered_Index* index = self->ordered_indexes + i;
+        PLNNR_ORDERED_DISPATCH(self, index->column, sort_ordered, index->entries, self->num_entries);
+    }
+}
+
+void plnnr::clear(Fact_Table* self)
+{
+    if (self->removed)
+    {
+        memset(self->removed, 0, self->num_entries);
+    }
+
+    self->num_entries = 0;
+    self->num_removed = 0;
+
+    // the table keeps the snapshot capacity in its own storage.
+    copy_snapshot_columns(self);
+
+    for (uint32_t i = 0; i < self->num_indexes; ++i)
+    {
+        Fact_Index* index = self->indexes + i;
+        memset(index->heads, 0xff, sizeof(uint32_t) * index->num_buckets);
+    }
+
+    memset(self->distinct_sketch, 0, sizeof(self->distinct_sketch));
+}
+
+void plnnr::set_stats(Fact_Table* self, bool enabled)
+{
+    memset(self->distinct_sketch, 0, sizeof(self->distinct_sketch));
+    self->stats = enabled;
+    update_stats(self, 0, self->num_entries);
+}
+
+void plnnr::update_stats(Fact_Table* self, uint32_t entry_index, uint32_t count)
+{
+    plnnr_assert(entry_index + count <= self->num_entries);
+
+    if (!self->stats)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < self->format.num_params; ++i)
+    {
+        uint64_t* sketch = self->distinct_sketch[i];
+
+        for (uint32_t entry = entry_index; entry < entry_index + count; ++entry)
+        {
+            const uint32_t bit = hash_column_value(self, i, entry) & (Distinct_Sketch_Words * 64 - 1);
+            sketch[bit >> 6] |= uint64_t(1) << (bit & 63);
+        }
+    }
+}
+
+uint32_t plnnr::estimate_distinct(const Fact_Table* self, uint32_t column)
+{
+    plnnr_assert(column < self->format.num_params);
+    const uint32_t num_live = self->num_entries - self->num_removed;
+    const uint32_t num_bits = Distinct_Sketch_Words * 64;
+
+    uint32_t num_zeros = 0;
+    for (uint32_t i = 0; i < num_bits; ++i)
+    {
+        if ((self->distinct_sketch[column][i >> 6] & (uint64_t(1) << (i & 63))) == 0)
+        {
+            ++num_zeros;
+        }
+    }
+
+    // saturated sketch, the column is (almost) unique.
+    if (num_zeros == 0)
+    {
+        return num_live;
+    }
+
+    // linear counting estimate.
+    const float estimate = float(num_bits) * logf(float(num_bits) / float(num_zeros));
+    const uint32_t result = uint32_t(estimate + 0.5f);
+
+    if (result > num_live)
+    {
+        return num_live;
+    }
+
+    return (result > 0 || num_live == 0) ? result : 1;
+}
+
+// estimated number of `table` entries with the `bound_columns` equal to a key.
+static float estimate_rows(const Fact_Table* table, uint32_t bound_columns)
+{
+    float rows = float(table->num_entries - table->num_removed);
+
+    for (uint8_t i = 0; i < table->format.num_params; ++i)
+    {
+        if (bound_columns & (1u << i))
+        {
+            const uint32_t distinct = estimate_distinct(table, i);
+            rows /= float(distinct > 0 ? distinct : 1);
+        }
+    }
+
+    return rows;
+}
+
+uint32_t plnnr::estimate_rows(const Fact_Database* self, const uint32_t table_index, const uint32_t bound_columns)
+{
+    plnnr_assert(table_index < self->num_tables);
+    float rows = ::estimate_rows(self->tables + table_index, bound_columns);
+
+    if (self->base)
+    {
+        rows += ::estimate_rows(self->base->tables + table_index, bound_columns);
+    }
+
+    return uint32_t(ceilf(rows));
+}
+
+// allocates database blob for `num_tables` tables and builds name hash lookup.
+static void init_blob(Fact_Database* self, Memory* mem, uint32_t num_tables, uint32_t hash_seed, const uint32_t* hashes, const char* const* names)
+{
+    memset(self, 0, sizeof(Fact_Database));
+
+    self->num_tables = num_tables;
+    self->max_tables = num_tables;
+    self->hash_seed = hash_seed;
+
+    const uint32_t max_tables = num_tables;
+    // at most half of the lookup slots are used.
+    const uint32_t num_lookup_slots = get_num_buckets(2 * max_tables);
+    // hashes
+    size_t size = plnnr_alignof(uint32_t) + sizeof(uint32_t) * max_tables;
+    // lookup
+    size += sizeof(uint32_t) * num_lookup_slots;
+    // names
+    size = align(size, plnnr_alignof(void*));
+    size += sizeof(void*) * max_tables;
+    // tables
+    size = align(size, plnnr_alignof(Fact_Table));
+    size += sizeof(Fact_Table) * max_tables;
+
+    void* blob = mem->allocate(size);
+    self->blob = blob;
+    uint8_t* bytes = static_cast<uint8_t*>(blob);
+
+    self->hashes = plnnr::align<uint32_t>(bytes);
+    bytes += sizeof(uint32_t) * max_tables;
+    self->lookup = reinterpret_cast<uint32_t*>(bytes);
+    self->lookup_mask = num_lookup_slots - 1;
+    bytes += sizeof(uint32_t) * num_lookup_slots;
+    self->names = plnnr::align<const char*>(bytes);
+    bytes += sizeof(void*) * max_tables;
+    self->tables = plnnr::align<Fact_Table>(bytes);
+
+    memset(self->lookup, 0xff, sizeof(uint32_t) * num_lookup_slots);
+
+    for (uint32_t i = 0; i < num_tables; ++i)
+    {
+        self->hashes[i] = hashes[i];
+        self->names[i] = names[i];
+
+        uint32_t slot = hashes[i] & self->lookup_mask;
+        while (self->lookup[slot] != Fact_Index_End)
+        {
+            slot = (slot + 1) & self->lookup_mask;
+        }
+
+        self->lookup[slot] = i;
+    }
+
+    self->memory = mem;
+}
+
+// adds indexes declared in `format` for the table `table_index`.
+static void add_indexes(Fact_Table* table, const Database_Format* format, uint32_t table_index)
+{
+    if (format->num_indexes == 0)
+    {
+        return;
+    }
+
+    const Fact_Index_Format* index_formats = format->indexes + format->first_index[table_index];
+    for (uint32_t j = 0; j < format->num_indexes[table_index]; ++j)
+    {
+        const Fact_Index_Format* index_format = index_formats + j;
+
+        if (index_format->kind == Fact_Index_Ordered)
+            add_ordered_index(table, index_format->columns[0]);
+        else
+            add_index(table, index_format);
+    }
+}
+
+void plnnr::init(Fact_Database* self, Memory* mem, const Database_Format* format)
+{
+    init_blob(self, mem, format->num_tables, format->hash_seed, format->hashes, format->names);
+
+    for (uint32_t i = 0; i < format->num_tables; ++i)
+    {
+        uint32_t size_hint = format->size_hints[i];
+        uint32_t max_entries = ( size_hint > 0 ) ? size_hint : 128;
+        init(self->tables + i, mem, format->types + i, max_entries);
+        add_indexes(self->tables + i, format, i);
+        set_stats(self->tables + i, format->stats && format->stats[i]);
+    }
+}
+
+void plnnr::init_overlay(Fact_Database* self, Memory* mem, const Fact_Database* base, uint32_t max_entries)
+{
+    plnnr_assert(base->base == 0);
+
+    init_blob(self, mem, base->num_tables, base->hash_seed, base->hashes, base->names);
+    self->base = base;
+
+    for (uint32_t i = 0; i < base->num_tables; ++i)
+    {
+        const Fact_Table* base_table = base->tables + i;
+        Fact_Table* table = self->tables + i;
+        init(table, mem, &base_table->format, max_entries);
+
+        // same indexes as in the base table, so generated code can use the same index numbers.
+        for (uint32_t j = 0; j < base_table->num_indexes; ++j)
+        {
+            add_index(table, &base_table->indexes[j].format);
+        }
+
+        for (uint32_t j = 0; j < base_table->num_ordered_indexes; ++j)
+        {
+            add_ordered_index(table, base_table->ordered_indexes[j].column);
+        }
+
+        set_stats(table, base_table->stats);
+    }
+}
+
+void plnnr::set_growth(Fact_Database* self, Fact_Table_Growth* growth)
+{
+    for (uint32_t i = 0; i < self->num_tables; ++i)
+    {
+        set_growth(self->tables + i, growth);
+    }
+}
+
+void plnnr::set_vec3_layout(Fact_Database* self, Vec3_Layout layout)
+{
+    for (uint32_t i = 0; i < self->num_tables; ++i)
+    {
+        set_vec3_layout(self->tables + i, layout);
+    }
+}
+
+void plnnr::destroy(Fact_Database* self)
+{
+    Memory* mem = self->memory;
+
+    for (uint32_t i = 0; i < self->num_tables; ++i)
+    {
+        Fact_Table* table = self->tables + i;
+        destroy(table);
+    }
+
+    mem->deallocate(self->blob);
+    memset(self, 0, sizeof(Fact_Database));
+}
+
+// returns index of the table with the name hash equal to `hash`, or `Fact_Index_End` if there's no such table.
+static uint32_t lookup_table(const Fact_Database* self, uint32_t hash)
+{
+    if (!self->lookup)
+    {
+        return Fact_Index_End;
+    }
+
+    const uint32_t* lookup = self->lookup;
+    const uint32_t mask = self->lookup_mask;
+
+    for (uint32_t slot = hash & mask; lookup[slot] != Fact_Index_End; slot = (slot + 1) & mask)
+    {
+        if (self->hashes[lookup[slot]] == hash)
+        {
+            return lookup[slot];
+        }
+    }
+
+    return Fact_Index_End;
+}
+
+const Fact_Table* plnnr::find_table(const Fact_Database* self, const char* fact_name)
+{
+    const uint32_t hash = murmur2_32(fact_name, (uint32_t)strlen(fact_name), self->hash_seed);
+    const uint32_t table_index = lookup_table(self, hash);
+    return (table_index != Fact_Index_End) ? self->tables + table_index : 0;
+}
+
+Fact_Table* plnnr::find_table(Fact_Database* self, const char* fact_name)
+{
+    return find_table(self, fact_name, (uint32_t)strlen(fact_name));
+}
+
+Fact_Table* plnnr::find_table(Fact_Database* self, const char* fact_name, uint32_t length)
+{
+    const uint32_t hash = murmur2_32(fact_name, length, self->hash_seed);
+    const uint32_t table_index = lookup_table(self, hash);
+    return (table_index != Fact_Index_End) ? self->tables + table_index : 0;
+}
+
+static uint32_t get_num_live_entries(const Fact_Table* table)
+{
+    return table->num_entries - table->num_removed;
+}
+
+// returns snapshot size and fills table records, if `tables` is not null.
+static size_t layout_snapshot(const Fact_Database* self, Snapshot_Table* tables)
+{
+    size_t size = sizeof(Snapshot_Header) + sizeof(Snapshot_Table) * self->num_tables;
+
+    for (uint32_t i = 0; i < self->num_tables; ++i)
+    {
+        const Fact_Table* table = self->tables + i;
+        uint32_t num_entries = get_num_live_entries(table);
+
+        if (self->base)
+        {
+            num_entries += get_num_live_entries(self->base->tables + i);
+        }
+
+        if (tables)
+        {
+            Snapshot_Table* record = tables + i;
+            memset(record, 0, sizeof(Snapshot_Table));
+            record->hash = self->hashes[i];
+            record->num_entries = num_entries;
+            record->num_params = table->format.num_params;
+        }
+
+        for (uint8_t j = 0; j < table->format.num_params; ++j)
+        {
+            size = align(size, Snapshot_Alignment);
+
+            if (tables)
+            {
+                tables[i].types[j] = static_cast<uint8_t>(table->format.types[j]);
+                tables[i].offsets[j] = size;
+            }
+
+            size += num_entries * get_type_size(table->format.types[j]);
+        }
+    }
+
+    return size;
+}
+
+// copies live entries of the `column` to `dst`, returns pointer past the last copied value.
+// snapshots always store vec3 columns interleaved.
+static uint8_t* save_column(const Fact_Table* table, uint8_t column, uint8_t* dst)
+{
+    const size_t size = get_type_size(table->format.types[column]);
+    const uint8_t* src = static_cast<const uint8_t*>(table->columns[column]);
+
+    if (get_num_planes(table, column) > 1)
+    {
+        for (uint32_t entry_index = 0; entry_index < table->num_entries; ++entry_index)
+        {
+            if (!is_removed(table, entry_index))
+            {
+                const Vec3 value = as_Vec3(table, entry_index, column);
+                memcpy(dst, &value, size);
+                dst += size;
+            }
+        }
+
+        return dst;
+    }
+
+    if (table->num_removed == 0)
+    {
+        memcpy(dst, src, table->num_entries * size);
+        return dst + table->num_entries * size;
+    }
+
+    for (uint32_t entry_index = 0; entry_index < table->num_entries; ++entry_index)
+    {
+        if (!table->removed[entry_index])
+        {
+            memcpy(dst, src + entry_index * size, size);
+            dst += size;
+        }
+    }
+
+    return dst;
+}
+
+size_t plnnr::get_snapshot_size(const Fact_Database* self)
+{
+    return layout_snapshot(self, 0);
+}
+
+size_t plnnr::save_snapshot(const Fact_Database* self, void* buffer, size_t buffer_size)
+{
+    plnnr_assert((reinterpret_cast<uintptr_t>(buffer) & (Snapshot_Alignment - 1)) == 0);
+
+    const size_t size = get_snapshot_size(self);
+    if (size > buffer_size)
+    {
+        return 0;
+    }
+
+    uint8_t* bytes = static_cast<uint8_t*>(buffer);
+    memset(bytes, 0, size);
+
+    Snapshot_Header* header = reinterpret_cast<Snapshot_Header*>(bytes);
+    header->magic = Snapshot_Magic;
+    header->version = Snapshot_Version;
+    header->hash_seed = self->hash_seed;
+    header->num_tables = self->num_tables;
+    header->size = size;
+
+    Snapshot_Table* records = reinterpret_cast<Snapshot_Table*>(header + 1);
+    layout_snapshot(self, records);
+
+    for (uint32_t i = 0; i < self->num_tables; ++i)
+    {
+        const Fact_Table* table = self->tables + i;
+
+        for (uint8_t j = 0; j < table->format.num_params; ++j)
+        {
+            uint8_t* dst = bytes + records[i].offsets[j];
+
+            // base entries go first, the same order as the overlay iteration.
+            if (self->base)
+            {
+                dst = save_column(self->base->tables + i, j, dst);
+            }
+
+            save_column(table, j, dst);
+        }
+    }
+
+    return size;
+}
+
+static const Snapshot_Table* find_snapshot_table(const Snapshot_Header* header, uint32_t hash)
+{
+    const Snapshot_Table* records = reinterpret_cast<const Snapshot_Table*>(header + 1);
+
+    for (uint32_t i = 0; i < header->num_tables; ++i)
+    {
+        if (records[i].hash == hash)
+        {
+            return records + i;
+        }
+    }
+
+    return 0;
+}
+
+static bool is_valid_snapshot_table(const Snapshot_Table* record, const Fact_Type* format, size_t size)
+{
+    if (record->num_params != format->num_params)
+    {
+        return false;
+    }
+
+    for (uint8_t j = 0; j < format->num_params; ++j)
+    {
+        if (record->types[j] != format->types[j])
+        {
+            return false;
+        }
+
+        const uint64_t column_size = uint64_t(record->num_entries) * get_type_size(format->types[j]);
+        if ((record->offsets[j] & (Snapshot_Alignment - 1)) != 0 || record->offsets[j] > size || column_size > size - record->offsets[j])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool plnnr::load_snapshot(Fact_Database* self, Memory* mem, const Database_Format* format, const void* data, size_t size)
+{
+    if ((reinterpret_cast<uintptr_t>(data) & (Snapshot_Alignment - 1)) != 0 || size < sizeof(Snapshot_Header))
+    {
+        return false;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    const Snapshot_Header* header = static_cast<const Snapshot_Header*>(data);
+
+    if (header->magic != Snapshot_Magic || header->version != Snapshot_Version || header->size > size || header->hash_seed != format->hash_seed)
+    {
+        return false;
+    }
+
+    if (sizeof(Snapshot_Header) + uint64_t(header->num_tables) * sizeof(Snapshot_Table) > header->size)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < format->num_tables; ++i)
+    {
+        const Snapshot_Table* record = find_snapshot_table(header, format->hashes[i]);
+
+        if (!record || !is_valid_snapshot_table(record, format->types + i, static_cast<size_t>(header->size)))
+        {
+            return false;
+        }
+    }
+
+    init_blob(self, mem, format->num_tables, format->hash_seed, format->hashes, format->names);
+
+    for (uint32_t i = 0; i < format->num_tables; ++i)
+    {
+        const Snapshot_Table* record = find_snapshot_table(header, format->hashes[i]);
+        Fact_Table* table = self->tables + i;
+
+        memset(table, 0, sizeof(Fact_Table));
+        table->format = format->types[i];
+        table->num_entries = record->num_entries;
+        table->max_entries = record->num_entries;
+        table->high_water_mark = record->num_entries;
+        table->memory = mem;
+
+        for (uint8_t j = 0; j < table->format.num_params; ++j)
+        {
+            // columns are copied to the allocated blob before the table is modified (see `copy_snapshot_columns`).
+            table->columns[j] = const_cast<uint8_t*>(bytes + record->offsets[j]);
+        }
+
+        add_indexes(table, format, i);
+        set_stats(table, format->stats && format->stats[i]);
+    }
+
+    return true;
 }
@@ -0,0 +1,474 @@
+//
+// Copyright (c) 2015 Alexander Shafranov shafranov@gmail.com
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software. If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+
+#include <string.h> // memset, memcpy, memchr
+#include <stdlib.h> // strtod
+#include "derplanner/runtime/database.h"
+#include "derplanner/runtime/domain.h"
+#include "derplanner/runtime/loader.h"
+
+using namespace plnnr;
+
+static uint32_t get_num_slots(uint32_t num_values)
+{
+    uint32_t num_slots = 1;
+    while (num_slots < 2 * num_values)
+    {
+        num_slots <<= 1;
+    }
+
+    return num_slots;
+}
+
+void plnnr::init(Fact_Loader* self, Memory* mem, Fact_Database* db, const Symbol_Table* symbols, uint32_t batch_size)
+{
+    plnnr_assert(batch_size > 0);
+    memset(self, 0, sizeof(Fact_Loader));
+
+    self->db = db;
+    self->symbols = symbols;
+    self->batch_size = batch_size;
+    self->memory = mem;
+
+    self->batches = allocate<Fact_Loader_Batch>(mem, db->num_tables > 0 ? db->num_tables : 1);
+    memset(self->batches, 0, sizeof(Fact_Loader_Batch) * db->num_tables);
+
+    if (symbols && symbols->num_symbols > 0)
+    {
+        const uint32_t num_slots = get_num_slots(symbols->num_symbols);
+        self->symbol_lookup = allocate<uint32_t>(mem, num_slots);
+        self->symbol_lookup_mask = num_slots - 1;
+        memset(self->symbol_lookup, 0xff, sizeof(uint32_t) * num_slots);
+
+        for (uint32_t i = 0; i < symbols->num_symbols; ++i)
+        {
+            uint32_t slot = symbols->hashes[i] & self->symbol_lookup_mask;
+            while (self->symbol_lookup[slot] != Fact_Index_End)
+            {
+                slot = (slot + 1) & self->symbol_lookup_mask;
+            }
+
+            self->symbol_lookup[slot] = i;
+        }
+    }
+}
+
+void plnnr::destroy(Fact_Loader* self)
+{
+    Memory* mem = self->memory;
+
+    for (uint32_t i = 0; i < self->db->num_tables; ++i)
+    {
+        if (self->batches[i].rows)
+        {
+            mem->deallocate(self->batches[i].rows);
+        }
+    }
+
+    mem->deallocate(self->batches);
+
+    if (self->symbol_lookup)
+    {
+        mem->deallocate(self->symbol_lookup);
+    }
+
+    memset(self, 0, sizeof(Fact_Loader));
+}
+
+void plnnr::set_resolve(Fact_Loader* self, Fact_Loader_Resolve* resolve, void* user_data)
+{
+    self->resolve = resolve;
+    self->user_data = user_data;
+}
+
+static bool flush_batch(Fact_Loader* self, uint32_t table_index)
+{
+    Fact_Loader_Batch* batch = self->batches + table_index;
+    Fact_Table* table = self->db->tables + table_index;
+
+    if (batch->count == 0)
+    {
+        return true;
+    }
+
+    if (!table->growth && table->num_entries + batch->count > table->max_entries)
+    {
+        self->error = Fact_Loader_Table_Full;
+        return false;
+    }
+
+    add_entries(table, batch->count, batch->rows, &batch->layout, batch->stride);
+    batch->count = 0;
+    return true;
+}
+
+static Fact_Loader_Batch* get_batch(Fact_Loader* self, uint32_t table_index)
+{
+    Fact_Loader_Batch* batch = self->batches + table_index;
+
+    if (!batch->rows)
+    {
+        Fact_Table* table = self->db->tables + table_index;
+        batch->layout.num_params = table->format.num_params;
+        batch->layout.types = table->format.types;
+        batch->layout.offsets = batch->offsets;
+        compute_offsets_and_size(&batch->layout);
+
+        const size_t alignment = batch->layout.num_params > 0 ? batch->layout.alignment : 1;
+        batch->stride = align(batch->layout.size > 0 ? batch->layout.size : 1, alignment);
+        batch->rows = allocate<uint8_t>(self->memory, batch->stride * self->batch_size, plnnr::default_alignment);
+    }
+
+    return batch;
+}
+
+/// Line parsing.
+
+namespace
+{
+    struct Cursor
+    {
+        const char* c;
+        const char* end;
+    };
+
+    inline bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+    inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+    inline bool is_name_start(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':'; }
+    inline bool is_name_body(char c) { return is_name_start(c) || is_digit(c) || c == '!'; }
+
+    inline void skip_spaces(Cursor& cur)
+    {
+        while (cur.c < cur.end && is_space(*cur.c)) { ++cur.c; }
+    }
+
+    inline bool eat(Cursor& cur, char c)
+    {
+        skip_spaces(cur);
+
+        if (cur.c < cur.end && *cur.c == c)
+        {
+            ++cur.c;
+            return true;
+        }
+
+        return false;
+    }
+
+    inline uint32_t parse_name(Cursor& cur)
+    {
+        skip_spaces(cur);
+        const char* start = cur.c;
+
+        if (cur.c < cur.end && is_name_start(*cur.c))
+        {
+            ++cur.c;
+            while (cur.c < cur.end && is_name_body(*cur.c)) { ++cur.c; }
+        }
+
+        return static_cast<uint32_t>(cur.c - start);
+    }
+
+    // parses integer literal, returns false if the argument isn't an integer.
+    inline bool parse_integer(Cursor& cur, int64_t& value)
+    {
+        const char* c = cur.c;
+        bool negative = false;
+
+        if (c < cur.end && (*c == '-' || *c == '+'))
+        {
+            negative = (*c == '-');
+            ++c;
+        }
+
+        if (c == cur.end || !is_digit(*c))
+        {
+            return false;
+        }
+
+        uint64_t result = 0;
+        while (c < cur.end && is_digit(*c))
+        {
+            result = result * 10 + static_cast<uint64_t>(*c - '0');
+            ++c;
+        }
+
+        if (c < cur.end && (*c == '.' || *c == 'e' || *c == 'E'))
+        {
+            return false;
+        }
+
+        value = negative ? -static_cast<int64_t>(result) : static_cast<int64_t>(result);
+        cur.c = c;
+        return true;
+    }
+
+    // parses number literal, the line is terminated by a character which is not a part of a number.
+    inline bool parse_float(Cursor& cur, float& value)
+    {
+        char* num_end = 0;
+        const double result = strtod(cur.c, &num_end);
+
+        if (num_end == cur.c || num_end > cur.end)
+        {
+            return false;
+        }
+
+        value = static_cast<float>(result);
+        cur.c = num_end;
+        return true;
+    }
+}
+
+static bool resolve_symbol(Fact_Loader* self, const char* name, uint32_t length, uint64_t& id)
+{
+    if (self->symbol_lookup && name[0] == ':')
+    {
+        const Symbol_Table* symbols = self->symbols;
+        const uint32_t hash = murmur2_32(name, length, symbols->hash_seed);
+        const uint32_t mask = self->symbol_lookup_mask;
+
+        for (uint32_t slot = hash & mask; self->symbol_lookup[slot] != Fact_Index_End; slot = (slot + 1) & mask)
+        {
+            const uint32_t symbol_index = self->symbol_lookup[slot];
+            if (symbols->hashes[symbol_index] == hash && strncmp(symbols->values[symbol_index], name, length) == 0 && symbols->values[symbol_index][length] == 0)
+            {
+                id = symbol_index;
+                return true;
+            }
+        }
+    }
+
+    return self->resolve && self->resolve(self->user_data, name, length, &id);
+}
+
+static bool parse_arg(Fact_Loader* self, Cursor& cur, Type type, uint8_t* dst)
+{
+    skip_spaces(cur);
+
+    if (type == Type_Float)
+    {
+        float value = 0.0f;
+        if (!parse_float(cur, value))
+        {
+            self->error = Fact_Loader_Type_Mismatch;
+            return false;
+        }
+
+        memcpy(dst, &value, sizeof(value));
+        return true;
+    }
+
+    int64_t value = 0;
+    if (!parse_integer(cur, value))
+    {
+        const char* name = cur.c;
+        const uint32_t length = parse_name(cur);
+        uint64_t id = 0;
+
+        if (length == 0 || (type != Type_Id32 && type != Type_Id64))
+        {
+            self->error = Fact_Loader_Type_Mismatch;
+            return false;
+        }
+
+        if (!resolve_symbol(self, name, length, id))
+        {
+            self->error = Fact_Loader_Unknown_Symbol;
+            return false;
+        }
+
+        value = static_cast<int64_t>(id);
+    }
+
+    switch (type)
+    {
+    case Type_Id32:  { Id32 v = static_cast<Id32>(value);       memcpy(dst, &v, sizeof(v)); return true; }
+    case Type_Id64:  { Id64 v = static_cast<Id64>(value);       memcpy(dst, &v, sizeof(v)); return true; }
+    case Type_Int8:  { int8_t v = static_cast<int8_t>(value);   memcpy(dst, &v, sizeof(v)); return true; }
+    case Type_Int32: { int32_t v = static_cast<int32_t>(value); memcpy(dst, &v, sizeof(v)); return true; }
+    case Type_Int64: { int64_t v = value;                       memcpy(dst, &v, sizeof(v)); return true; }
+    default:
+        break;
+    }
+
+    self->error = Fact_Loader_Type_Mismatch;
+    return false;
+}
+
+// parses a single line (`end` points to a line terminator) and appends the fact to the table batch.
+static bool parse_line(Fact_Loader* self, const char* begin, const char* end)
+{
+    ++self->line_number;
+
+    Cursor cur = { begin, end };
+    skip_spaces(cur);
+
+    if (cur.c == cur.end || *cur.c == '#' || (*cur.c == '/' && cur.c + 1 < cur.end && cur.c[1] == '/'))
+    {
+        return true;
+    }
+
+    const char* name = cur.c;
+    const uint32_t name_length = parse_name(cur);
+
+    if (name_length == 0 || !eat(cur, '('))
+    {
+        self->error = Fact_Loader_Syntax_Error;
+        return false;
+    }
+
+    Fact_Table* table = find_table(self->db, name, name_length);
+    if (!table)
+    {
+        self->error = Fact_Loader_Unknown_Fact;
+        return false;
+    }
+
+    const uint32_t table_index = static_cast<uint32_t>(table - self->db->tables);
+    Fact_Loader_Batch* batch = get_batch(self, table_index);
+    uint8_t* row = batch->rows + batch->count * batch->stride;
+    const uint8_t num_params = table->format.num_params;
+
+    for (uint8_t i = 0; i < num_params; ++i)
+    {
+        if (i > 0 && !eat(cur, ','))
+        {
+            self->error = eat(cur, ')') ? Fact_Loader_Arity_Mismatch : Fact_Loader_Syntax_Error;
+            return false;
+        }
+
+        if (!parse_arg(self, cur, table->format.types[i], row + batch->offsets[i]))
+        {
+            return false;
+        }
+    }
+
+    if (!eat(cur, ')'))
+    {
+        self->error = eat(cur, ',') ? Fact_Loader_Arity_Mismatch : Fact_Loader_Syntax_Error;
+        return false;
+    }
+
+    skip_spaces(cur);
+    if (cur.c != cur.end)
+    {
+        self->error = Fact_Loader_Syntax_Error;
+        return false;
+    }
+
+    if (++batch->count == self->batch_size)
+    {
+        return flush_batch(self, table_index);
+    }
+
+    return true;
+}
+
+bool plnnr::load_facts(Fact_Loader* self, const char* text, size_t length)
+{
+    if (self->error != Fact_Loader_Ok)
+    {
+        return false;
+    }
+
+    const char* c = text;
+    const char* end = text + length;
+
+    while (c < end)
+    {
+        const char* line_end = static_cast<const char*>(memchr(c, '\n', end - c));
+
+        if (!line_end)
+        {
+            // keep the incomplete line until the next chunk.
+            const size_t tail_length = end - c;
+            if (self->line_length + tail_length > Max_Fact_Line_Length)
+            {
+                self->error = Fact_Loader_Line_Too_Long;
+                return false;
+            }
+
+            memcpy(self->line + self->line_length, c, tail_length);
+            self->line_length += static_cast<uint32_t>(tail_length);
+            return true;
+        }
+
+        if (self->line_length > 0)
+        {
+            const size_t head_length = line_end - c;
+            if (self->line_length + head_length > Max_Fact_Line_Length)
+            {
+                self->error = Fact_Loader_Line_Too_Long;
+                return false;
+            }
+
+            memcpy(self->line + self->line_length, c, head_length);
+            self->line_length += static_cast<uint32_t>(head_length);
+            self->line[self->line_length] = 0;
+
+            const uint32_t line_length = self->line_length;
+            self->line_length = 0;
+
+            if (!parse_line(self, self->line, self->line + line_length))
+            {
+                return false;
+            }
+        }
+        else if (!parse_line(self, c, line_end))
+        {
+            return false;
+        }
+
+        c = line_end + 1;
+    }
+
+    return true;
+}
+
+bool plnnr::flush(Fact_Loader* self)
+{
+    if (self->error != Fact_Loader_Ok)
+    {
+        return false;
+    }
+
+    if (self->line_length > 0)
+    {
+        self->line[self->line_length] = 0;
+        const uint32_t line_length = self->line_length;
+        self->line_length = 0;
+
+        if (!parse_line(self, self->line, self->line + line_length))
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < self->db->num_tables; ++i)
+    {
+        if (!flush_batch(self, i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
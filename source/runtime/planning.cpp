@@ -19,6 +19,14 @@
 //
 
 #include <string.h> // memset
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h> // QueryPerformanceCounter
+#else
+    #include <time.h> // clock_gettime
+#endif
 #include "derplanner/runtime/domain.h"
 #include "derplanner/runtime/database.h"
 #include "derplanner/runtime/planning.h"
@@ -65,17 +73,270 @@ void plnnr::destroy(Planning_State* self)
     mem->deallocate(self->task_stack.frames);
     mem->deallocate(self->expansion_blob.base);
     mem->deallocate(self->task_blob.base);
+
+    if (self->speculation)
+    {
+        mem->deallocate(self->speculation->slot_data);
+        mem->deallocate(self->speculation->slots);
+        mem->deallocate(self->speculation);
+    }
+
     memset(self, 0, sizeof(Planning_State));
 }
 
+void plnnr::set_growth(Planning_State* self, bool enabled, uint32_t max_depth, uint32_t max_plan_length)
+{
+    self->growth = enabled;
+    self->max_growth_depth = max_depth;
+    self->max_growth_plan_length = max_plan_length;
+}
+
+template <typename T>
+static void grow_stack(Memory* mem, Stack<T>* stack)
+{
+    const uint32_t new_max_size = stack->max_size * 2;
+    T* frames = allocate<T>(mem, new_max_size);
+    memcpy(frames, stack->frames, sizeof(T) * stack->size);
+    mem->deallocate(stack->frames);
+    stack->frames = frames;
+    stack->max_size = new_max_size;
+}
+
+// moves the blob data to a block with at least `min_free` bytes free, returns the old block which is left to the caller to deallocate.
+static uint8_t* grow_blob(Memory* mem, Blob* blob, uint32_t min_free)
+{
+    const uint32_t used = (uint32_t)(blob->top - blob->base);
+    uint32_t new_max_size = blob->max_size * 2;
+    if (new_max_size < used + min_free)
+        new_max_size = used + min_free;
+
+    uint8_t* old_base = blob->base;
+    uint8_t* new_base = allocate<uint8_t>(mem, new_max_size, plnnr::default_alignment);
+    memcpy(new_base, old_base, used);
+
+    blob->max_size = new_max_size;
+    blob->base = new_base;
+    blob->top = new_base + used;
+
+    return old_base;
+}
+
+// offsets are preserved, both blocks have the same alignment.
+static void* rebase(void* ptr, const uint8_t* old_base, uint8_t* new_base)
+{
+    if (!ptr)
+        return 0;
+
+    return new_base + ((uint8_t*)(ptr) - old_base);
+}
+
+static void grow_expansion_blob(Planning_State* self, uint32_t min_free)
+{
+    uint8_t* old_base = grow_blob(self->memory, &self->expansion_blob, min_free);
+    uint8_t* new_base = self->expansion_blob.base;
+
+    for (uint32_t i = 0; i < self->expansion_stack.size; ++i)
+    {
+        Expansion_Frame* frame = &self->expansion_stack.frames[i];
+        frame->arguments = rebase(frame->arguments, old_base, new_base);
+        frame->handles = (Fact_Handle*)(rebase(frame->handles, old_base, new_base));
+        frame->bindings = rebase(frame->bindings, old_base, new_base);
+    }
+
+    self->memory->deallocate(old_base);
+}
+
+static void grow_task_blob(Planning_State* self, uint32_t min_free)
+{
+    uint8_t* old_base = grow_blob(self->memory, &self->task_blob, min_free);
+    uint8_t* new_base = self->task_blob.base;
+
+    for (uint32_t i = 0; i < self->task_stack.size; ++i)
+    {
+        Task_Frame* frame = &self->task_stack.frames[i];
+        frame->arguments = rebase(frame->arguments, old_base, new_base);
+    }
+
+    self->memory->deallocate(old_base);
+}
+
+void plnnr::reserve_expansion_data(Planning_State* self, uint32_t size)
+{
+    Blob* blob = &self->expansion_blob;
+    if (self->growth && (uint32_t)(blob->top - blob->base) + size > blob->max_size)
+        grow_expansion_blob(self, size);
+}
+
+// a single step pushes at most one frame on either stack, so the space for it is reserved before the step.
+static void reserve_step_space(Planning_State* self)
+{
+    if (self->expansion_stack.size >= self->expansion_stack.max_size)
+    {
+        grow_stack(self->memory, &self->expansion_stack);
+        self->max_depth = self->expansion_stack.max_size - 1;
+    }
+
+    if (self->task_stack.size >= self->task_stack.max_size)
+    {
+        grow_stack(self->memory, &self->task_stack);
+        self->max_plan_length = self->task_stack.max_size - 1;
+    }
+
+    reserve_expansion_data(self, self->expansion_reserve);
+
+    Blob* blob = &self->task_blob;
+    if ((uint32_t)(blob->top - blob->base) + self->task_reserve > blob->max_size)
+        grow_task_blob(self, self->task_reserve);
+}
+
+// the most data allocated by `begin_compound`/`next_case` and `begin_task` for any task in the domain.
+static void compute_step_reserve(Planning_State* self, const Domain_Info* domain)
+{
+    const Task_Info& info = domain->task_info;
+    self->expansion_reserve = 0;
+    self->task_reserve = 0;
+
+    for (uint32_t task_id = 0; task_id < info.num_tasks; ++task_id)
+    {
+        uint32_t& reserve = (task_id < info.num_primitive) ? self->task_reserve : self->expansion_reserve;
+        reserve = (info.frame_costs[task_id] > reserve) ? info.frame_costs[task_id] : reserve;
+    }
+}
+
+// the most bytes bindings collected by the case precondition may take on top of its frame, for the current table sizes.
+static uint64_t get_collect_cost(const Domain_Info* domain, const Fact_Database* db, uint32_t global_case_index)
+{
+    const Task_Info& info = domain->task_info;
+    if (!info.collects_bindings[global_case_index])
+        return 0;
+
+    // each collected binding is a row of the joined tables, saturated as the product quickly gets out of range.
+    const uint64_t max_bindings = 0xffffffff;
+    uint64_t num_bindings = 1;
+    for (uint32_t i = info.first_collect_fact[global_case_index]; i < info.first_collect_fact[global_case_index + 1]; ++i)
+    {
+        const char* name = domain->database_req.names[info.collect_facts[i]];
+        const Fact_Table* table = find_table(db, name);
+        uint64_t num_entries = table ? table->num_entries : 0;
+
+        // overlay scans visit the base table entries too.
+        if (db->base)
+        {
+            const Fact_Table* base_table = find_table(db->base, name);
+            num_entries += base_table ? base_table->num_entries : 0;
+        }
+
+        num_entries = (num_entries > 0) ? num_entries : 1;
+        num_bindings = (num_bindings * num_entries < max_bindings) ? num_bindings * num_entries : max_bindings;
+    }
+
+    // bindings themselves plus the `remove_duplicates` hash set, which is at most four slots per binding.
+    return num_bindings * layout_cost(&info.bindings[global_case_index]) + (num_bindings * 4 + 1) * sizeof(uint32_t);
+}
+
+bool plnnr::compute_config(Planning_State_Config* config, const Domain_Info* domain, const Fact_Database* db, uint32_t max_depth, uint32_t max_plan_length)
+{
+    const Task_Info& info = domain->task_info;
+    uint64_t expansion_cost = 0;
+    uint64_t task_cost = 0;
+
+    for (uint32_t task_id = 0; task_id < info.num_tasks; ++task_id)
+    {
+        const uint64_t frame_cost = info.frame_costs[task_id];
+
+        if (task_id < info.num_primitive)
+        {
+            task_cost = (frame_cost > task_cost) ? frame_cost : task_cost;
+            continue;
+        }
+
+        const uint32_t compound_id = task_id - info.num_primitive;
+        for (uint32_t case_idx = 0; case_idx < info.num_cases[compound_id]; ++case_idx)
+        {
+            const uint64_t cost = frame_cost + get_collect_cost(domain, db, info.first_case[compound_id] + case_idx);
+            expansion_cost = (cost > expansion_cost) ? cost : expansion_cost;
+        }
+    }
+
+    // stacks keep one extra frame for the overflow check, sizes are checked before multiplying as the collect cost is only saturated.
+    const uint64_t max_size = 0xffffffff;
+    const uint64_t num_expansions = (uint64_t)(max_depth) + 1;
+    const uint64_t num_tasks = (uint64_t)(max_plan_length) + 1;
+
+    if (expansion_cost > max_size / num_expansions || task_cost > max_size / num_tasks)
+        return false;
+
+    config->max_depth = max_depth;
+    config->max_plan_length = max_plan_length;
+    config->max_bound_tables = domain->database_req.num_tables;
+    config->expansion_data_size = (uint32_t)(expansion_cost * num_expansions);
+    config->plan_data_size = (uint32_t)(task_cost * num_tasks);
+    return true;
+}
+
+// true if `table` starts with the hash & ordered indexes required for the domain table `table_index`,
+// generated probes refer to the indexes by their position in the domain declaration.
+static bool has_required_indexes(const Fact_Table* table, const Database_Format* req, uint32_t table_index)
+{
+    if (req->num_indexes == 0)
+        return true;
+
+    const Fact_Index_Format* formats = req->indexes + req->first_index[table_index];
+    uint32_t num_hash = 0;
+    uint32_t num_ordered = 0;
+
+    for (uint32_t j = 0; j < req->num_indexes[table_index]; ++j)
+    {
+        const Fact_Index_Format* format = formats + j;
+
+        if (format->kind == Fact_Index_Ordered)
+        {
+            if (num_ordered >= table->num_ordered_indexes || table->ordered_indexes[num_ordered].column != format->columns[0])
+                return false;
+
+            ++num_ordered;
+            continue;
+        }
+
+        if (num_hash >= table->num_indexes)
+            return false;
+
+        const Fact_Index_Format* actual = &table->indexes[num_hash].format;
+        if (actual->num_columns != format->num_columns || memcmp(actual->columns, format->columns, format->num_columns) != 0)
+            return false;
+
+        ++num_hash;
+    }
+
+    return true;
+}
+
 bool plnnr::bind(Planning_State* self, const Domain_Info* domain, const Fact_Database* db)
 {
     const Database_Format& req = domain->database_req;
 
+    // database has the same tables in the same order.
+    if (db->num_tables == req.num_tables && db->hash_seed == req.hash_seed &&
+        (req.num_tables == 0 || memcmp(db->hashes, req.hashes, sizeof(uint32_t) * req.num_tables) == 0))
+    {
+        for (uint32_t i = 0; i < req.num_tables; ++i)
+        {
+            if (!has_required_indexes(db->tables + i, &req, i))
+                return false;
+
+            self->table_indices[i] = i;
+        }
+
+        self->identity_binding = true;
+        return true;
+    }
+
+    self->identity_binding = false;
+
     for (uint32_t i = 0; i < req.num_tables; ++i)
     {
         const Fact_Table* table = find_table(db, req.names[i]);
-        if (!table)
+        if (!table || !has_required_indexes(table, &req, i))
             return false;
 
         uint32_t idx = (uint32_t)(table - db->tables);
@@ -127,7 +388,12 @@ void plnnr::find_plan_init(Planning_State* self, const Domain_Info* domain)
     plnnr_assert(domain->task_info.num_compound > 0);
 
     // the root task is the first compound task in domain.
-    uint32_t root_id = domain->task_info.num_primitive;
+    find_plan_init(self, domain, domain->task_info.num_primitive);
+}
+
+void plnnr::find_plan_init(Planning_State* self, const Domain_Info* domain, uint32_t root_id)
+{
+    plnnr_assert(root_id >= domain->task_info.num_primitive && root_id < domain->task_info.num_tasks);
     // this find_plan variant doesn't support root tasks with arguments.
     plnnr_assert(domain->task_info.parameters[root_id].num_params == 0);
 
@@ -137,12 +403,28 @@ void plnnr::find_plan_init(Planning_State* self, const Domain_Info* domain)
     self->expansion_blob.top = self->expansion_blob.base;
     self->task_blob.top = self->task_blob.base;
 
+    if (self->speculation)
+        self->speculation->num_cases = 0;
+
+    if (self->growth)
+    {
+        compute_step_reserve(self, domain);
+        reserve_step_space(self);
+    }
+
     // put the root task on stack.
     begin_compound(self, domain, root_id);
 }
 
-Find_Plan_Status plnnr::find_plan_step(Planning_State* self, Fact_Database* db)
+Find_Plan_Status plnnr::find_plan_step(Planning_State* self, const Fact_Database* db)
 {
+    if (self->growth)
+        reserve_step_space(self);
+
+    // speculation results are valid during a single step.
+    if (self->speculation)
+        self->speculation->num_cases = 0;
+
     Expansion_Frame* frame = top(&self->expansion_stack);
 
     if (frame->expand(self, frame, db))
@@ -160,12 +442,16 @@ Find_Plan_Status plnnr::find_plan_step(Planning_State* self, Fact_Database* db)
                 return Find_Plan_Succeeded;
         }
 
+        // with growth enabled the stacks grow before the next step, up to the growth limits.
+        const uint32_t max_depth = self->growth ? self->max_growth_depth : self->max_depth;
+        const uint32_t max_plan_length = self->growth ? self->max_growth_plan_length : self->max_plan_length;
+
         // check if the maximum expansion depth reached.
-        if (size(&self->expansion_stack) > self->max_depth)
+        if (size(&self->expansion_stack) > max_depth)
             return Find_Plan_Max_Depth_Exceeded;
 
         // check if the maximum plan length reached.
-        if (size(&self->task_stack) > self->max_plan_length)
+        if (size(&self->task_stack) > max_plan_length)
             return Find_Plan_Max_Plan_Length_Exceeded;
 
         return Find_Plan_In_Progress;
@@ -182,7 +468,50 @@ Find_Plan_Status plnnr::find_plan_step(Planning_State* self, Fact_Database* db)
     return Find_Plan_In_Progress;
 }
 
-Find_Plan_Status plnnr::find_plan(Planning_State* self, Fact_Database* db, const Domain_Info* domain)
+// monotonic wall-clock time in nanoseconds.
+static uint64_t get_time_ns()
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000ull + (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000ull / frequency.QuadPart;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)(ts.tv_sec) * 1000000000ull + (uint64_t)(ts.tv_nsec);
+#endif
+}
+
+Find_Plan_Status plnnr::find_plan_run(Planning_State* self, const Fact_Database* db, const Find_Plan_Budget* budget)
+{
+    const uint64_t start_time = budget->max_nanoseconds ? get_time_ns() : 0;
+    const uint32_t start_iterations = self->precond_iterations;
+
+    for (uint32_t num_steps = 0; ;)
+    {
+        if (budget->cancel && *budget->cancel)
+            return Find_Plan_Cancelled;
+
+        Find_Plan_Status status = find_plan_step(self, db);
+        if (status != Find_Plan_In_Progress)
+            return status;
+
+        ++num_steps;
+
+        if (budget->max_steps && num_steps >= budget->max_steps)
+            return Find_Plan_In_Progress;
+
+        if (budget->max_precond_iterations && self->precond_iterations - start_iterations >= budget->max_precond_iterations)
+            return Find_Plan_In_Progress;
+
+        if (budget->max_nanoseconds && get_time_ns() - start_time >= budget->max_nanoseconds)
+            return Find_Plan_In_Progress;
+    }
+}
+
+Find_Plan_Status plnnr::find_plan(Planning_State* self, const Fact_Database* db, const Domain_Info* domain)
 {
     find_plan_init(self, domain);
 
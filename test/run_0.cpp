@@ -14,7 +14,9 @@ using namespace plnnr;
 #pragma warning(disable: 4189) // local variable is initialized but not referenced
 #endif
 
-static bool r_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
+static bool r_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
 
 static Compound_Task_Expand* s_task_expands[] = {
   r_case_0,
@@ -64,10 +66,52 @@ static uint32_t s_size_hints[] = {
   0,
 };
 
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+  0, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  0, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 0, { 0, }, Fact_Index_Hash }
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+};
+
 static uint32_t s_num_case_handles[] = {
   2, 
 };
 
+static uint32_t s_frame_costs[2];
+
+static bool s_collects_bindings[] = {
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0
+};
+
+static uint32_t s_collect_facts[] = {
+  0
+};
+
+static bool s_parallel[] = {
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+};
+
 static uint32_t s_fact_name_hashes[] = {
   2456313694, 
   2260187636, 
@@ -87,8 +131,8 @@ static uint32_t s_symbol_hashes[] = {
 };
 
 static Domain_Info s_domain_info = {
-  { 2, 1, 1, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands },
-  { 2, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names },
+  { 2, 1, 1, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 2, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
   { 0, 0, s_symbol_hashes, s_symbol_values }
 };
 
@@ -101,41 +145,100 @@ void run_0_init_domain_info()
   for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
     compute_offsets_and_size(&s_bindings[i]);
   }
+
+  compute_frame_costs(&s_domain_info);
 }
 
 const Domain_Info* run_0_get_domain_info() { return &s_domain_info; }
 
+namespace {
+
 struct S_1 {
   int32_t _0;
   int32_t _1;
 };
 
-static bool p0_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
   S_1* binds = (S_1*)(frame->bindings);
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
-  for (handles[0] = first(db, tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next(db, handles[0])) { // a
-    binds->_0 = int32_t(as_Int32(db, handles[0], 0));
-    for (handles[1] = first(db, tbl(state, 1)); is_valid(db, handles[1]); handles[1] = next(db, handles[1])) { // b
-      binds->_1 = int32_t(as_Int32(db, handles[1], 0));
-      plnnr_coroutine_yield(frame, precond_label, 1);
+  for (handles[0] = first(db, Binding::tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next_table(db, handles[0])) { // a
+    const Fact_Table* table_0;
+    const uint8_t* removed_0;
+    uint32_t rows_0;
+    uint32_t row_0;
+    const int32_t* c0_0;
+    table_0 = get_table(db, handles[0]);
+    removed_0 = get_removed(table_0);
+    rows_0 = table_0->num_entries;
+    row_0 = handles[0].entry;
+    c0_0 = get_column<int32_t>(table_0, 0);
+
+    for (; row_0 < rows_0; ++row_0) {
+      if (removed_0 && removed_0[row_0]) {
+        continue;
+      }
+
+      binds->_0 = int32_t(load_row(c0_0, row_0));
+      for (handles[1] = first(db, Binding::tbl(state, 1)); is_valid(db, handles[1]); handles[1] = next_table(db, handles[1])) { // b
+        const Fact_Table* table_1;
+        const uint8_t* removed_1;
+        uint32_t rows_1;
+        uint32_t row_1;
+        const int32_t* c1_0;
+        table_1 = get_table(db, handles[1]);
+        removed_1 = get_removed(table_1);
+        rows_1 = table_1->num_entries;
+        row_1 = handles[1].entry;
+        c1_0 = get_column<int32_t>(table_1, 0);
+
+        for (; row_1 < rows_1; ++row_1) {
+          if (removed_1 && removed_1[row_1]) {
+            continue;
+          }
+
+          binds->_1 = int32_t(load_row(c1_0, row_1));
+          handles[0].entry = row_0;
+          handles[1].entry = row_1;
+          plnnr_coroutine_yield(frame, precond_label, 1);
+          table_0 = get_table(db, handles[0]);
+          removed_0 = get_removed(table_0);
+          rows_0 = table_0->num_entries;
+          row_0 = handles[0].entry;
+          c0_0 = get_column<int32_t>(table_0, 0);
+          table_1 = get_table(db, handles[1]);
+          removed_1 = get_removed(table_1);
+          rows_1 = table_1->num_entries;
+          row_1 = handles[1].entry;
+          c1_0 = get_column<int32_t>(table_1, 0);
+        }
+      }
     }
   }
 
   plnnr_coroutine_end();
 }
 
-static bool r_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool r_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
-  const S_1* binds = (const S_1*)(frame->bindings);
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
 
   plnnr_coroutine_begin(frame, expand_label);
 
   while (p0_next(state, frame, db)) {
-    binds = binds + frame->binding_index;
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
     begin_task(state, &s_domain_info, 0); // t!
     set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_0));
     set_task_arg(state, &s_task_parameters[0], 1, int32_t(binds->_1));
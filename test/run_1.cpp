@@ -14,8 +14,11 @@ using namespace plnnr;
 #pragma warning(disable: 4189) // local variable is initialized but not referenced
 #endif
 
-static bool r_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
-static bool t_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
+static bool r_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool t_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p1_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
 
 static Compound_Task_Expand* s_task_expands[] = {
   r_case_0,
@@ -72,11 +75,57 @@ static uint32_t s_size_hints[] = {
   0,
 };
 
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+  0, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  0, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 0, { 0, }, Fact_Index_Hash }
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+};
+
 static uint32_t s_num_case_handles[] = {
   1, 
   1, 
 };
 
+static uint32_t s_frame_costs[4];
+
+static bool s_collects_bindings[] = {
+  false, 
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0, 
+  0
+};
+
+static uint32_t s_collect_facts[] = {
+  0
+};
+
+static bool s_parallel[] = {
+  false, 
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+  p1_next,
+};
+
 static uint32_t s_fact_name_hashes[] = {
   2456313694, 
   2260187636, 
@@ -98,8 +147,8 @@ static uint32_t s_symbol_hashes[] = {
 };
 
 static Domain_Info s_domain_info = {
-  { 4, 2, 2, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands },
-  { 2, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names },
+  { 4, 2, 2, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 2, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
   { 0, 0, s_symbol_hashes, s_symbol_values }
 };
 
@@ -112,55 +161,99 @@ void run_1_init_domain_info()
   for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
     compute_offsets_and_size(&s_bindings[i]);
   }
+
+  compute_frame_costs(&s_domain_info);
 }
 
 const Domain_Info* run_1_get_domain_info() { return &s_domain_info; }
 
+namespace {
+
 struct S_1 {
   Id32 _0;
 };
 
-static bool p0_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
   S_1* binds = (S_1*)(frame->bindings);
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
-  for (handles[0] = first(db, tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next(db, handles[0])) { // a
-    binds->_0 = Id32(as_Id32(db, handles[0], 0));
-    plnnr_coroutine_yield(frame, precond_label, 1);
+  for (handles[0] = first(db, Binding::tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next_table(db, handles[0])) { // a
+    const Fact_Table* table_0;
+    const uint8_t* removed_0;
+    uint32_t rows_0;
+    uint32_t row_0;
+    const Id32* c0_0;
+    table_0 = get_table(db, handles[0]);
+    removed_0 = get_removed(table_0);
+    rows_0 = table_0->num_entries;
+    row_0 = handles[0].entry;
+    c0_0 = get_column<Id32>(table_0, 0);
+
+    for (; row_0 < rows_0; ++row_0) {
+      if (removed_0 && removed_0[row_0]) {
+        continue;
+      }
+
+      binds->_0 = Id32(load_row(c0_0, row_0));
+      handles[0].entry = row_0;
+      plnnr_coroutine_yield(frame, precond_label, 1);
+      table_0 = get_table(db, handles[0]);
+      removed_0 = get_removed(table_0);
+      rows_0 = table_0->num_entries;
+      row_0 = handles[0].entry;
+      c0_0 = get_column<Id32>(table_0, 0);
+    }
   }
 
   plnnr_coroutine_end();
 }
 
-static bool p1_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p1_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
   const S_1* args = (const S_1*)(frame->arguments);
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
-  for (handles[0] = first(db, tbl(state, 1)); is_valid(db, handles[0]); handles[0] = next(db, handles[0])) { // b
+  for (handles[0] = first_equal(db, Binding::tbl(state, 1), 0, Id32(args->_0)); is_valid(db, handles[0]); handles[0] = next_equal(db, handles[0], 0, Id32(args->_0))) { // b
     if (args->_0 != Id32(as_Id32(db, handles[0], 0))) {
       continue;
     }
 
     plnnr_coroutine_yield(frame, precond_label, 1);
+    break;
   }
 
   plnnr_coroutine_end();
 }
 
-static bool r_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p1_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p1_body<Identity_Binding>(state, frame, db) : p1_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool r_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
-  const S_1* binds = (const S_1*)(frame->bindings);
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
 
   plnnr_coroutine_begin(frame, expand_label);
 
   while (p0_next(state, frame, db)) {
-    binds = binds + frame->binding_index;
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
     begin_task(state, &s_domain_info, 0); // p1!
     set_task_arg(state, &s_task_parameters[0], 0, Id32(binds->_0));
     plnnr_coroutine_yield(frame, expand_label, 1);
@@ -175,13 +268,14 @@ static bool r_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Databas
   plnnr_coroutine_end();
 }
 
-static bool t_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool t_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   const S_1* args = (const S_1*)(frame->arguments);
 
   plnnr_coroutine_begin(frame, expand_label);
 
   while (p1_next(state, frame, db)) {
+    args = (const S_1*)(frame->arguments);
     begin_task(state, &s_domain_info, 1); // p2!
     set_task_arg(state, &s_task_parameters[1], 0, Id32(args->_0));
     frame->status = Expansion_Frame::Status_Expanded;
@@ -9,6 +9,14 @@
 #define PLNNR_DOMAIN_API
 #endif
 
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_1_Fact_Id
+{
+  run_1_fact_a = 0,
+  run_1_fact_b = 1,
+  run_1_num_facts = 2
+};
+
 extern "C" PLNNR_DOMAIN_API void run_1_init_domain_info();
 extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_1_get_domain_info();
 
@@ -14,8 +14,11 @@ using namespace plnnr;
 #pragma warning(disable: 4189) // local variable is initialized but not referenced
 #endif
 
-static bool r_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
-static bool t_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
+static bool r_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool t_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p1_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
 
 static Compound_Task_Expand* s_task_expands[] = {
   r_case_0,
@@ -74,11 +77,63 @@ static uint32_t s_size_hints[] = {
   0,
 };
 
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+  0, 
+  0, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  0, 
+  0, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 0, { 0, }, Fact_Index_Hash }
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+  false, 
+};
+
 static uint32_t s_num_case_handles[] = {
   0, 
   4, 
 };
 
+static uint32_t s_frame_costs[3];
+
+static bool s_collects_bindings[] = {
+  false, 
+  true, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0, 
+  4
+};
+
+static uint32_t s_collect_facts[] = {
+  0, // values1
+  2, // check
+  1, // values2
+  2, // check
+};
+
+static bool s_parallel[] = {
+  false, 
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+  p1_next,
+};
+
 static uint32_t s_fact_name_hashes[] = {
   317428990, 
   4196792681, 
@@ -100,8 +155,8 @@ static uint32_t s_symbol_hashes[] = {
 };
 
 static Domain_Info s_domain_info = {
-  { 3, 1, 2, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands },
-  { 3, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names },
+  { 3, 1, 2, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 3, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
   { 0, 0, s_symbol_hashes, s_symbol_values }
 };
 
@@ -114,10 +169,14 @@ void run_11_init_domain_info()
   for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
     compute_offsets_and_size(&s_bindings[i]);
   }
+
+  compute_frame_costs(&s_domain_info);
 }
 
 const Domain_Info* run_11_get_domain_info() { return &s_domain_info; }
 
+namespace {
+
 struct S_1 {
   int8_t _0;
 };
@@ -126,10 +185,14 @@ struct S_2 {
   int32_t _0;
 };
 
-static bool p0_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
   plnnr_coroutine_yield(frame, precond_label, 1);
@@ -137,6 +200,12 @@ static bool p0_next(Planning_State* state, Expansion_Frame* frame, Fact_Database
   plnnr_coroutine_end();
 }
 
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+namespace {
 struct Compare_p1 {
   const S_1* args;
   Compare_p1(const S_1* args) :args(args) {}
@@ -146,28 +215,51 @@ struct Compare_p1 {
   }
 
   inline bool operator()(const S_2& a, const S_2& b) const {
-    return key(&a) < key(&b);
+    return key(&b) < key(&a);
   }
 };
+}
 
-static bool p1_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+template <typename Binding>
+static bool p1_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
   const S_1* args = (const S_1*)(frame->arguments);
   S_2* binds = (S_2*)(frame->bindings);
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
   frame->num_bindings = 0;
-  for (handles[0] = first(db, tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next(db, handles[0])) { // values1
-    binds->_0 = int32_t(as_Int32(db, handles[0], 0));
-    for (handles[1] = first(db, tbl(state, 2)); is_valid(db, handles[1]); handles[1] = next(db, handles[1])) { // check
-      if (binds->_0 != int32_t(as_Int32(db, handles[1], 0))) {
+  for (handles[0] = first(db, Binding::tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next_table(db, handles[0])) { // values1
+    const Fact_Table* table_0;
+    const uint8_t* removed_0;
+    uint32_t rows_0;
+    uint32_t row_0;
+    const int32_t* c0_0;
+    table_0 = get_table(db, handles[0]);
+    removed_0 = get_removed(table_0);
+    rows_0 = table_0->num_entries;
+    row_0 = handles[0].entry;
+    c0_0 = get_column<int32_t>(table_0, 0);
+
+    for (; row_0 < rows_0; ++row_0) {
+      if (removed_0 && removed_0[row_0]) {
         continue;
       }
 
-      binds = (S_2*)(allocate_precond_bindings(state, &s_bindings[1]));
-      ++frame->num_bindings;
+      binds->_0 = int32_t(load_row(c0_0, row_0));
+      for (handles[1] = first_equal(db, Binding::tbl(state, 2), 0, int32_t(binds->_0)); is_valid(db, handles[1]); handles[1] = next_equal(db, handles[1], 0, int32_t(binds->_0))) { // check
+        if (binds->_0 != int32_t(as_Int32(db, handles[1], 0))) {
+          continue;
+        }
+
+        binds = (S_2*)(allocate_precond_bindings(state, &s_bindings[1]));
+        handles = frame->handles;
+        args = (const S_1*)(frame->arguments);
+        *binds = *(binds - 1);
+        ++frame->num_bindings;
+      }
     }
   }
 
@@ -175,23 +267,46 @@ static bool p1_next(Planning_State* state, Expansion_Frame* frame, Fact_Database
     revert(&state->expansion_blob, binds);
   }
 
-  std::sort(binds - frame->num_bindings, binds, Compare_p1(args));
+  binds = (S_2*)(frame->bindings);
+  std::make_heap(binds, binds + frame->num_bindings, Compare_p1(args));
 
-  for (frame->binding_index = 0; frame->binding_index < frame->num_bindings; ++frame->binding_index) {
+  for (frame->binding_index = frame->num_bindings; frame->binding_index > 0; ) {
+    std::pop_heap(binds, binds + frame->binding_index, Compare_p1(args));
+    --frame->binding_index;
     plnnr_coroutine_yield(frame, precond_label, 1);
   }
 
   revert(&state->expansion_blob, binds + 1);
   frame->num_bindings = 0;
-  for (handles[2] = first(db, tbl(state, 1)); is_valid(db, handles[2]); handles[2] = next(db, handles[2])) { // values2
-    binds->_0 = int32_t(as_Int32(db, handles[2], 0));
-    for (handles[3] = first(db, tbl(state, 2)); is_valid(db, handles[3]); handles[3] = next(db, handles[3])) { // check
-      if (binds->_0 != int32_t(as_Int32(db, handles[3], 0))) {
+  for (handles[2] = first(db, Binding::tbl(state, 1)); is_valid(db, handles[2]); handles[2] = next_table(db, handles[2])) { // values2
+    const Fact_Table* table_2;
+    const uint8_t* removed_2;
+    uint32_t rows_2;
+    uint32_t row_2;
+    const int32_t* c2_0;
+    table_2 = get_table(db, handles[2]);
+    removed_2 = get_removed(table_2);
+    rows_2 = table_2->num_entries;
+    row_2 = handles[2].entry;
+    c2_0 = get_column<int32_t>(table_2, 0);
+
+    for (; row_2 < rows_2; ++row_2) {
+      if (removed_2 && removed_2[row_2]) {
         continue;
       }
 
-      binds = (S_2*)(allocate_precond_bindings(state, &s_bindings[1]));
-      ++frame->num_bindings;
+      binds->_0 = int32_t(load_row(c2_0, row_2));
+      for (handles[3] = first_equal(db, Binding::tbl(state, 2), 0, int32_t(binds->_0)); is_valid(db, handles[3]); handles[3] = next_equal(db, handles[3], 0, int32_t(binds->_0))) { // check
+        if (binds->_0 != int32_t(as_Int32(db, handles[3], 0))) {
+          continue;
+        }
+
+        binds = (S_2*)(allocate_precond_bindings(state, &s_bindings[1]));
+        handles = frame->handles;
+        args = (const S_1*)(frame->arguments);
+        *binds = *(binds - 1);
+        ++frame->num_bindings;
+      }
     }
   }
 
@@ -199,9 +314,12 @@ static bool p1_next(Planning_State* state, Expansion_Frame* frame, Fact_Database
     revert(&state->expansion_blob, binds);
   }
 
-  std::sort(binds - frame->num_bindings, binds, Compare_p1(args));
+  binds = (S_2*)(frame->bindings);
+  std::make_heap(binds, binds + frame->num_bindings, Compare_p1(args));
 
-  for (frame->binding_index = 0; frame->binding_index < frame->num_bindings; ++frame->binding_index) {
+  for (frame->binding_index = frame->num_bindings; frame->binding_index > 0; ) {
+    std::pop_heap(binds, binds + frame->binding_index, Compare_p1(args));
+    --frame->binding_index;
     plnnr_coroutine_yield(frame, precond_label, 2);
   }
 
@@ -209,7 +327,12 @@ static bool p1_next(Planning_State* state, Expansion_Frame* frame, Fact_Database
   plnnr_coroutine_end();
 }
 
-static bool r_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p1_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p1_body<Identity_Binding>(state, frame, db) : p1_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool r_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
 
   plnnr_coroutine_begin(frame, expand_label);
@@ -225,15 +348,15 @@ static bool r_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Databas
   plnnr_coroutine_end();
 }
 
-static bool t_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool t_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   const S_1* args = (const S_1*)(frame->arguments);
-  const S_2* binds = (const S_2*)(frame->bindings);
+  const S_2* binds = (const S_2*)(frame->bindings) + frame->binding_index;
 
   plnnr_coroutine_begin(frame, expand_label);
 
   while (p1_next(state, frame, db)) {
-    binds = binds + frame->binding_index;
+    binds = (const S_2*)(frame->bindings) + frame->binding_index;
     begin_task(state, &s_domain_info, 0); // p!
     set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_0));
     plnnr_coroutine_yield(frame, expand_label, 1);
@@ -9,6 +9,15 @@
 #define PLNNR_DOMAIN_API
 #endif
 
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_11_Fact_Id
+{
+  run_11_fact_values1 = 0,
+  run_11_fact_values2 = 1,
+  run_11_fact_check = 2,
+  run_11_num_facts = 3
+};
+
 extern "C" PLNNR_DOMAIN_API void run_11_init_domain_info();
 extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_11_get_domain_info();
 
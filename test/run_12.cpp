@@ -14,9 +14,13 @@ using namespace plnnr;
 #pragma warning(disable: 4189) // local variable is initialized but not referenced
 #endif
 
-static bool t_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
-static bool s_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
-static bool r_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
+static bool t_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool s_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool r_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p1_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p2_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
 
 static Compound_Task_Expand* s_task_expands[] = {
   t_case_0,
@@ -80,12 +84,59 @@ static uint32_t s_size_hints[] = {
   0,
 };
 
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 0, { 0, }, Fact_Index_Hash }
+};
+
+static bool s_fact_stats[] = {
+  false, 
+};
+
 static uint32_t s_num_case_handles[] = {
   0, 
   1, 
   1, 
 };
 
+static uint32_t s_frame_costs[4];
+
+static bool s_collects_bindings[] = {
+  false, 
+  false, 
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0, 
+  0, 
+  0
+};
+
+static uint32_t s_collect_facts[] = {
+  0
+};
+
+static bool s_parallel[] = {
+  false, 
+  false, 
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+  p1_next,
+  p2_next,
+};
+
 static uint32_t s_fact_name_hashes[] = {
   2456313694, 
 };
@@ -106,8 +157,8 @@ static uint32_t s_symbol_hashes[] = {
 };
 
 static Domain_Info s_domain_info = {
-  { 4, 1, 3, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands },
-  { 1, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names },
+  { 4, 1, 3, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 1, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
   { 0, 0, s_symbol_hashes, s_symbol_values }
 };
 
@@ -120,10 +171,14 @@ void run_12_init_domain_info()
   for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
     compute_offsets_and_size(&s_bindings[i]);
   }
+
+  compute_frame_costs(&s_domain_info);
 }
 
 const Domain_Info* run_12_get_domain_info() { return &s_domain_info; }
 
+namespace {
+
 struct S_1 {
   int8_t _0;
 };
@@ -139,10 +194,14 @@ struct S_3 {
   int8_t _1;
 };
 
-static bool p0_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
   plnnr_coroutine_yield(frame, precond_label, 1);
@@ -150,16 +209,23 @@ static bool p0_next(Planning_State* state, Expansion_Frame* frame, Fact_Database
   plnnr_coroutine_end();
 }
 
-static bool p1_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p1_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
   const S_1* args = (const S_1*)(frame->arguments);
   S_2* binds = (S_2*)(frame->bindings);
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
   (binds->_0 = args->_0); {
-    for (handles[0] = first(db, tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next(db, handles[0])) { // a
+    for (handles[0] = first_equal(db, Binding::tbl(state, 0), 1, int8_t(binds->_0)); is_valid(db, handles[0]); handles[0] = next_equal(db, handles[0], 1, int8_t(binds->_0))) { // a
       binds->_1 = int8_t(as_Int8(db, handles[0], 0));
       if (binds->_0 != int8_t(as_Int8(db, handles[0], 1))) {
         continue;
@@ -174,15 +240,22 @@ static bool p1_next(Planning_State* state, Expansion_Frame* frame, Fact_Database
   plnnr_coroutine_end();
 }
 
-static bool p2_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p1_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p1_body<Identity_Binding>(state, frame, db) : p1_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p2_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
   const S_1* args = (const S_1*)(frame->arguments);
   S_3* binds = (S_3*)(frame->bindings);
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
-  for (handles[0] = first(db, tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next(db, handles[0])) { // a
+  for (handles[0] = first_equal(db, Binding::tbl(state, 0), 1, int8_t(0)); is_valid(db, handles[0]); handles[0] = next_equal(db, handles[0], 1, int8_t(0))) { // a
     binds->_0 = int8_t(as_Int8(db, handles[0], 0));
     if (int8_t(0) != as_Int8(db, handles[0], 1)) {
       continue;
@@ -196,7 +269,12 @@ static bool p2_next(Planning_State* state, Expansion_Frame* frame, Fact_Database
   plnnr_coroutine_end();
 }
 
-static bool t_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p2_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p2_body<Identity_Binding>(state, frame, db) : p2_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool t_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
 
   plnnr_coroutine_begin(frame, expand_label);
@@ -216,15 +294,15 @@ static bool t_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Databas
   plnnr_coroutine_end();
 }
 
-static bool s_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool s_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   const S_1* args = (const S_1*)(frame->arguments);
-  const S_2* binds = (const S_2*)(frame->bindings);
+  const S_2* binds = (const S_2*)(frame->bindings) + frame->binding_index;
 
   plnnr_coroutine_begin(frame, expand_label);
 
   while (p1_next(state, frame, db)) {
-    binds = binds + frame->binding_index;
+    binds = (const S_2*)(frame->bindings) + frame->binding_index;
     begin_task(state, &s_domain_info, 0); // p!
     set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_2));
     plnnr_coroutine_yield(frame, expand_label, 1);
@@ -240,15 +318,14 @@ static bool s_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Databas
   plnnr_coroutine_end();
 }
 
-static bool r_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool r_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   const S_1* args = (const S_1*)(frame->arguments);
-  const S_3* binds = (const S_3*)(frame->bindings);
+  const S_3* binds = (const S_3*)(frame->bindings) + frame->binding_index;
 
   plnnr_coroutine_begin(frame, expand_label);
 
   while (p2_next(state, frame, db)) {
-    binds = binds + frame->binding_index;
     begin_task(state, &s_domain_info, 0); // p!
     set_task_arg(state, &s_task_parameters[0], 0, int32_t(0));
     frame->status = Expansion_Frame::Status_Expanded;
@@ -9,6 +9,13 @@
 #define PLNNR_DOMAIN_API
 #endif
 
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_12_Fact_Id
+{
+  run_12_fact_a = 0,
+  run_12_num_facts = 1
+};
+
 extern "C" PLNNR_DOMAIN_API void run_12_init_domain_info();
 extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_12_get_domain_info();
 
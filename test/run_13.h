@@ -9,6 +9,14 @@
 #define PLNNR_DOMAIN_API
 #endif
 
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_13_Fact_Id
+{
+  run_13_fact_a = 0,
+  run_13_fact_b = 1,
+  run_13_num_facts = 2
+};
+
 extern "C" PLNNR_DOMAIN_API void run_13_init_domain_info();
 extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_13_get_domain_info();
 
@@ -0,0 +1,310 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#include "derplanner/runtime/domain.h"
+#include "run_14.h"
+
+using namespace plnnr;
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4100) // unreferenced formal parameter
+#pragma warning(disable: 4189) // local variable is initialized but not referenced
+#endif
+
+static bool r_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool t_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p1_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static Compound_Task_Expand* s_task_expands[] = {
+  r_case_0,
+  t_case_0,
+};
+
+static const char* s_fact_names[] = {
+  "a",
+  "b",
+ };
+
+static const char* s_task_names[] = {
+  "p!",
+  "q!",
+  "r",
+  "t",
+ };
+
+static Fact_Type s_fact_types[] = {
+  { 2, {Type_Int32, Type_Int32, } },
+  { 3, {Type_Int32, Type_Int8, Type_Int32, } },
+};
+
+static Type s_layout_types[] = {
+  Type_Int32,
+  Type_Int32,
+  Type_Int32,
+  Type_Int32,
+  Type_Int8,
+};
+
+static size_t s_layout_offsets[5];
+
+static Param_Layout s_task_parameters[] = {
+  { 2, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 1, 0, 0, s_layout_types + 2, s_layout_offsets + 2 },
+  { 0, 0, 0, 0, 0 },
+  { 1, 0, 0, s_layout_types + 2, s_layout_offsets + 2 },
+};
+
+static Param_Layout s_bindings[] = {
+  { 2, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 2, 0, 0, s_layout_types + 3, s_layout_offsets + 3 },
+};
+
+static uint32_t s_num_cases[] = {
+  1, 
+  1, 
+};
+
+static uint32_t s_first_case[] = {
+  0, 
+  1, 
+};
+
+static uint32_t s_size_hints[] = {
+  0,
+  0,
+};
+
+static uint32_t s_num_fact_indexes[] = {
+  1, 
+  2, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  1, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 1, {0, }, Fact_Index_Hash }, // a
+  { 2, {0, 1, }, Fact_Index_Hash }, // b
+  { 1, {2, }, Fact_Index_Hash }, // b
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+};
+
+static uint32_t s_num_case_handles[] = {
+  2, 
+  1, 
+};
+
+static uint32_t s_frame_costs[4];
+
+static bool s_collects_bindings[] = {
+  false, 
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0, 
+  0
+};
+
+static uint32_t s_collect_facts[] = {
+  0
+};
+
+static bool s_parallel[] = {
+  false, 
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+  p1_next,
+};
+
+static uint32_t s_fact_name_hashes[] = {
+  2456313694, 
+  2260187636, 
+};
+
+static uint32_t s_task_name_hashes[] = {
+  1274055463, 
+  4047964875, 
+  744399309, 
+  2418444476, 
+};
+
+static const char* s_symbol_values[] = {
+  0
+ };
+
+static uint32_t s_symbol_hashes[] = {
+  0
+};
+
+static Domain_Info s_domain_info = {
+  { 4, 2, 2, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 2, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
+  { 0, 0, s_symbol_hashes, s_symbol_values }
+};
+
+void run_14_init_domain_info()
+{
+  for (size_t i = 0; i < plnnr_static_array_size(s_task_parameters); ++i) {
+    compute_offsets_and_size(&s_task_parameters[i]);
+  }
+
+  for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
+    compute_offsets_and_size(&s_bindings[i]);
+  }
+
+  compute_frame_costs(&s_domain_info);
+}
+
+const Domain_Info* run_14_get_domain_info() { return &s_domain_info; }
+
+namespace {
+
+struct S_1 {
+  int32_t _0;
+};
+
+struct S_2 {
+  int32_t _0;
+  int32_t _1;
+};
+
+struct S_3 {
+  int32_t _0;
+  int8_t _1;
+};
+
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_2* binds = (S_2*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first(db, Binding::tbl(state, 0), 0, hash_Int32(0, int32_t(1))); is_valid(db, handles[0]); handles[0] = next(db, handles[0], 0)) { // a
+    if (int32_t(1) != as_Int32(db, handles[0], 0)) {
+      continue;
+    }
+
+    binds->_0 = int32_t(as_Int32(db, handles[0], 1));
+    for (handles[1] = first(db, Binding::tbl(state, 1), 0, hash_Int8(hash_Int32(0, int32_t(binds->_0)), int8_t(1))); is_valid(db, handles[1]); handles[1] = next(db, handles[1], 0)) { // b
+      if (binds->_0 != int32_t(as_Int32(db, handles[1], 0))) {
+        continue;
+      }
+
+      if (int8_t(1) != as_Int8(db, handles[1], 1)) {
+        continue;
+      }
+
+      binds->_1 = int32_t(as_Int32(db, handles[1], 2));
+      plnnr_coroutine_yield(frame, precond_label, 1);
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p1_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  const S_1* args = (const S_1*)(frame->arguments);
+  S_3* binds = (S_3*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first(db, Binding::tbl(state, 1), 1, hash_Int32(0, int32_t(args->_0))); is_valid(db, handles[0]); handles[0] = next(db, handles[0], 1)) { // b
+    binds->_0 = int32_t(as_Int32(db, handles[0], 0));
+    binds->_1 = int8_t(as_Int8(db, handles[0], 1));
+    if (args->_0 != int32_t(as_Int32(db, handles[0], 2))) {
+      continue;
+    }
+
+    plnnr_coroutine_yield(frame, precond_label, 1);
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p1_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p1_body<Identity_Binding>(state, frame, db) : p1_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool r_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_2* binds = (const S_2*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p0_next(state, frame, db)) {
+    binds = (const S_2*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_0));
+    set_task_arg(state, &s_task_parameters[0], 1, int32_t(binds->_1));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    begin_compound(state, &s_domain_info, 3); // t
+    set_compound_arg(state, &s_task_parameters[3], 0, int32_t(binds->_1));
+    plnnr_coroutine_yield(frame, expand_label, 2);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 3);
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool t_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* args = (const S_1*)(frame->arguments);
+  const S_3* binds = (const S_3*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p1_next(state, frame, db)) {
+    binds = (const S_3*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 1); // q!
+    set_task_arg(state, &s_task_parameters[1], 0, int32_t(binds->_0));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+  }
+
+  plnnr_coroutine_end();
+}
+
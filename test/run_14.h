@@ -0,0 +1,23 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_14_H_
+#define run_14_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_14_Fact_Id
+{
+  run_14_fact_a = 0,
+  run_14_fact_b = 1,
+  run_14_num_facts = 2
+};
+
+extern "C" PLNNR_DOMAIN_API void run_14_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_14_get_domain_info();
+
+#endif
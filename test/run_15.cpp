@@ -0,0 +1,443 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#include "derplanner/runtime/domain.h"
+#include "run_15.h"
+
+using namespace plnnr;
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4100) // unreferenced formal parameter
+#pragma warning(disable: 4189) // local variable is initialized but not referenced
+#endif
+
+static bool r_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool t1_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool t2_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool t3_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p1_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p2_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p3_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static Compound_Task_Expand* s_task_expands[] = {
+  r_case_0,
+  t1_case_0,
+  t2_case_0,
+  t3_case_0,
+};
+
+static const char* s_fact_names[] = {
+  "a",
+  "b",
+ };
+
+static const char* s_task_names[] = {
+  "p!",
+  "q!",
+  "s!",
+  "r",
+  "t1",
+  "t2",
+  "t3",
+ };
+
+static Fact_Type s_fact_types[] = {
+  { 3, {Type_Int32, Type_Int8, Type_Float, } },
+  { 1, {Type_Int64, } },
+};
+
+static Type s_layout_types[] = {
+  Type_Int32,
+  Type_Int64,
+  Type_Int32,
+  Type_Int8,
+  Type_Float,
+  Type_Int64,
+  Type_Int32,
+  Type_Int8,
+  Type_Float,
+};
+
+static size_t s_layout_offsets[9];
+
+static Param_Layout s_task_parameters[] = {
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 0, 0, 0, 0, 0 },
+  { 0, 0, 0, 0, 0 },
+  { 0, 0, 0, 0, 0 },
+  { 0, 0, 0, 0, 0 },
+};
+
+static Param_Layout s_bindings[] = {
+  { 0, 0, 0, 0, 0 },
+  { 5, 0, 0, s_layout_types + 1, s_layout_offsets + 1 },
+  { 3, 0, 0, s_layout_types + 6, s_layout_offsets + 6 },
+  { 3, 0, 0, s_layout_types + 6, s_layout_offsets + 6 },
+};
+
+static uint32_t s_num_cases[] = {
+  1, 
+  1, 
+  1, 
+  1, 
+};
+
+static uint32_t s_first_case[] = {
+  0, 
+  1, 
+  2, 
+  3, 
+};
+
+static uint32_t s_size_hints[] = {
+  0,
+  0,
+};
+
+static uint32_t s_num_fact_indexes[] = {
+  2, 
+  0, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  2, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 1, {1, }, Fact_Index_Ordered }, // a
+  { 1, {2, }, Fact_Index_Ordered }, // a
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+};
+
+static uint32_t s_num_case_handles[] = {
+  0, 
+  3, 
+  2, 
+  2, 
+};
+
+static uint32_t s_frame_costs[7];
+
+static bool s_collects_bindings[] = {
+  false, 
+  false, 
+  false, 
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0, 
+  0, 
+  0, 
+  0
+};
+
+static uint32_t s_collect_facts[] = {
+  0
+};
+
+static bool s_parallel[] = {
+  false, 
+  false, 
+  false, 
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+  p1_next,
+  p2_next,
+  p3_next,
+};
+
+static uint32_t s_fact_name_hashes[] = {
+  2456313694, 
+  2260187636, 
+};
+
+static uint32_t s_task_name_hashes[] = {
+  1274055463, 
+  4047964875, 
+  2220538564, 
+  744399309, 
+  3253803906, 
+  3173881489, 
+  2692924587, 
+};
+
+static const char* s_symbol_values[] = {
+  0
+ };
+
+static uint32_t s_symbol_hashes[] = {
+  0
+};
+
+static Domain_Info s_domain_info = {
+  { 7, 3, 4, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 2, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
+  { 0, 0, s_symbol_hashes, s_symbol_values }
+};
+
+void run_15_init_domain_info()
+{
+  for (size_t i = 0; i < plnnr_static_array_size(s_task_parameters); ++i) {
+    compute_offsets_and_size(&s_task_parameters[i]);
+  }
+
+  for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
+    compute_offsets_and_size(&s_bindings[i]);
+  }
+
+  compute_frame_costs(&s_domain_info);
+}
+
+const Domain_Info* run_15_get_domain_info() { return &s_domain_info; }
+
+namespace {
+
+struct S_1 {
+  int64_t _0;
+  int32_t _1;
+  int8_t _2;
+  float _3;
+  int64_t _4;
+};
+
+struct S_2 {
+  int32_t _0;
+  int8_t _1;
+  float _2;
+};
+
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  plnnr_coroutine_yield(frame, precond_label, 1);
+
+  plnnr_coroutine_end();
+}
+
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p1_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_1* binds = (S_1*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first(db, Binding::tbl(state, 1)); is_valid(db, handles[0]); handles[0] = next_table(db, handles[0])) { // b
+    const Fact_Table* table_0;
+    const uint8_t* removed_0;
+    uint32_t rows_0;
+    uint32_t row_0;
+    const int64_t* c0_0;
+    table_0 = get_table(db, handles[0]);
+    removed_0 = get_removed(table_0);
+    rows_0 = table_0->num_entries;
+    row_0 = handles[0].entry;
+    c0_0 = get_column<int64_t>(table_0, 0);
+
+    for (; row_0 < rows_0; ++row_0) {
+      if (removed_0 && removed_0[row_0]) {
+        continue;
+      }
+
+      binds->_0 = int64_t(load_row(c0_0, row_0));
+      (binds->_4 = (binds->_0 + 1)); {
+        for (handles[1] = first_in_range(db, Binding::tbl(state, 0), 0, Range_Less_Equal, binds->_4); handles[2] = range_entry(db, Binding::tbl(state, 0), 0, handles[1]), is_valid(db, handles[2]); handles[1] = next_in_range(db, Binding::tbl(state, 0), 0, handles[1])) { // a
+          binds->_1 = int32_t(as_Int32(db, handles[2], 0));
+          binds->_2 = int8_t(as_Int8(db, handles[2], 1));
+          binds->_3 = float(as_Float(db, handles[2], 2));
+          if (bool((binds->_2 <= binds->_4))) {
+            handles[0].entry = row_0;
+            plnnr_coroutine_yield(frame, precond_label, 1);
+            table_0 = get_table(db, handles[0]);
+            removed_0 = get_removed(table_0);
+            rows_0 = table_0->num_entries;
+            row_0 = handles[0].entry;
+            c0_0 = get_column<int64_t>(table_0, 0);
+          }
+        }
+      }
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p1_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p1_body<Identity_Binding>(state, frame, db) : p1_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p2_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_2* binds = (S_2*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first_in_range(db, Binding::tbl(state, 0), 0, Range_Greater_Equal, 5); handles[1] = range_entry(db, Binding::tbl(state, 0), 0, handles[0]), is_valid(db, handles[1]); handles[0] = next_in_range(db, Binding::tbl(state, 0), 0, handles[0])) { // a
+    binds->_0 = int32_t(as_Int32(db, handles[1], 0));
+    binds->_1 = int8_t(as_Int8(db, handles[1], 1));
+    binds->_2 = float(as_Float(db, handles[1], 2));
+    if (bool((5 <= binds->_1))) {
+      plnnr_coroutine_yield(frame, precond_label, 1);
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p2_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p2_body<Identity_Binding>(state, frame, db) : p2_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p3_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_2* binds = (S_2*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first_in_range(db, Binding::tbl(state, 0), 1, Range_Less, 2.6); handles[1] = range_entry(db, Binding::tbl(state, 0), 1, handles[0]), is_valid(db, handles[1]); handles[0] = next_in_range(db, Binding::tbl(state, 0), 1, handles[0])) { // a
+    binds->_0 = int32_t(as_Int32(db, handles[1], 0));
+    binds->_1 = int8_t(as_Int8(db, handles[1], 1));
+    binds->_2 = float(as_Float(db, handles[1], 2));
+    if (bool((binds->_2 < 2.6))) {
+      if (bool((binds->_2 != 0.0))) {
+        plnnr_coroutine_yield(frame, precond_label, 1);
+      }
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p3_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p3_body<Identity_Binding>(state, frame, db) : p3_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool r_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p0_next(state, frame, db)) {
+    begin_compound(state, &s_domain_info, 4); // t1
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    begin_compound(state, &s_domain_info, 5); // t2
+    plnnr_coroutine_yield(frame, expand_label, 2);
+
+    begin_compound(state, &s_domain_info, 6); // t3
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 3);
+
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool t1_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p1_next(state, frame, db)) {
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_1));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool t2_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_2* binds = (const S_2*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p2_next(state, frame, db)) {
+    binds = (const S_2*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 1); // q!
+    set_task_arg(state, &s_task_parameters[1], 0, int32_t(binds->_0));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool t3_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_2* binds = (const S_2*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p3_next(state, frame, db)) {
+    binds = (const S_2*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 2); // s!
+    set_task_arg(state, &s_task_parameters[2], 0, int32_t(binds->_0));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+  }
+
+  plnnr_coroutine_end();
+}
+
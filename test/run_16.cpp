@@ -0,0 +1,266 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#include "derplanner/runtime/domain.h"
+#include "run_16.h"
+
+using namespace plnnr;
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4100) // unreferenced formal parameter
+#pragma warning(disable: 4189) // local variable is initialized but not referenced
+#endif
+
+static bool r_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static Compound_Task_Expand* s_task_expands[] = {
+  r_case_0,
+};
+
+static const char* s_fact_names[] = {
+  "me",
+  "unit",
+ };
+
+static const char* s_task_names[] = {
+  "p!",
+  "r",
+ };
+
+static Fact_Type s_fact_types[] = {
+  { 2, {Type_Vec3, Type_Vec3, } },
+  { 2, {Type_Int32, Type_Vec3, } },
+};
+
+static Type s_layout_types[] = {
+  Type_Int32,
+  Type_Vec3,
+  Type_Vec3,
+  Type_Int32,
+  Type_Vec3,
+};
+
+static size_t s_layout_offsets[5];
+
+static Param_Layout s_task_parameters[] = {
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 0, 0, 0, 0, 0 },
+};
+
+static Param_Layout s_bindings[] = {
+  { 4, 0, 0, s_layout_types + 1, s_layout_offsets + 1 },
+};
+
+static uint32_t s_num_cases[] = {
+  1, 
+};
+
+static uint32_t s_first_case[] = {
+  0, 
+};
+
+static uint32_t s_size_hints[] = {
+  0,
+  0,
+};
+
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+  0, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  0, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 0, { 0, }, Fact_Index_Hash }
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+};
+
+static uint32_t s_num_case_handles[] = {
+  3, 
+};
+
+static uint32_t s_frame_costs[2];
+
+static bool s_collects_bindings[] = {
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0
+};
+
+static uint32_t s_collect_facts[] = {
+  0
+};
+
+static bool s_parallel[] = {
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+};
+
+static uint32_t s_fact_name_hashes[] = {
+  2759711470, 
+  1365386447, 
+};
+
+static uint32_t s_task_name_hashes[] = {
+  1274055463, 
+  744399309, 
+};
+
+static const char* s_symbol_values[] = {
+  0
+ };
+
+static uint32_t s_symbol_hashes[] = {
+  0
+};
+
+static Domain_Info s_domain_info = {
+  { 2, 1, 1, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 2, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
+  { 0, 0, s_symbol_hashes, s_symbol_values }
+};
+
+void run_16_init_domain_info()
+{
+  for (size_t i = 0; i < plnnr_static_array_size(s_task_parameters); ++i) {
+    compute_offsets_and_size(&s_task_parameters[i]);
+  }
+
+  for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
+    compute_offsets_and_size(&s_bindings[i]);
+  }
+
+  compute_frame_costs(&s_domain_info);
+}
+
+const Domain_Info* run_16_get_domain_info() { return &s_domain_info; }
+
+namespace {
+
+struct S_1 {
+  Vec3 _0;
+  Vec3 _1;
+  int32_t _2;
+  Vec3 _3;
+};
+
+}
+
+namespace {
+struct Filter_p0_0 {
+  const S_1* binds;
+  Filter_p0_0(const S_1* binds) :binds(binds) {}
+
+  inline uint64_t operator()(const Fact_Table* table, uint32_t begin, uint32_t end) const {
+    const int32_t* c0 = get_column<int32_t>(table, 0);
+    const Vec3_Column c1 = get_vec3_column(table, 1);
+    uint64_t mask = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+      const bool match = bool((plnnr::dot(Vec3(plnnr::norm(Vec3((Vec3(load_row(c1, i)) - binds->_0)))), Vec3(binds->_1)) >= 0.99)) & !bool((int32_t(load_row(c0, i)) == 80));
+      mask |= uint64_t(match) << (i - begin);
+    }
+
+    return mask;
+  }
+};
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_1* binds = (S_1*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first(db, Binding::tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next_table(db, handles[0])) { // me
+    const Fact_Table* table_0;
+    const uint8_t* removed_0;
+    uint32_t rows_0;
+    uint32_t row_0;
+    Vec3_Column c0_0;
+    Vec3_Column c0_1;
+    table_0 = get_table(db, handles[0]);
+    removed_0 = get_removed(table_0);
+    rows_0 = table_0->num_entries;
+    row_0 = handles[0].entry;
+    c0_0 = get_vec3_column(table_0, 0);
+    c0_1 = get_vec3_column(table_0, 1);
+
+    for (; row_0 < rows_0; ++row_0) {
+      if (removed_0 && removed_0[row_0]) {
+        continue;
+      }
+
+      binds->_0 = Vec3(load_row(c0_0, row_0));
+      binds->_1 = Vec3(load_row(c0_1, row_0));
+      for (handles[2] = first_filtered(db, Binding::tbl(state, 1), row_mask(handles, 1), Filter_p0_0(binds)); is_valid(db, handles[2]); handles[2] = next_filtered(db, handles[2], row_mask(handles, 1), Filter_p0_0(binds))) { // unit
+        binds->_2 = int32_t(as_Int32(db, handles[2], 0));
+        binds->_3 = Vec3(as_Vec3(db, handles[2], 1));
+        if (bool((plnnr::dot(Vec3(plnnr::norm(Vec3((binds->_3 - binds->_0)))), Vec3(binds->_1)) >= 0.99))) {
+          if (!bool((binds->_2 == 80))) {
+            handles[0].entry = row_0;
+            plnnr_coroutine_yield(frame, precond_label, 1);
+            table_0 = get_table(db, handles[0]);
+            removed_0 = get_removed(table_0);
+            rows_0 = table_0->num_entries;
+            row_0 = handles[0].entry;
+            c0_0 = get_vec3_column(table_0, 0);
+            c0_1 = get_vec3_column(table_0, 1);
+          }
+        }
+      }
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool r_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p0_next(state, frame, db)) {
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_2));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+  }
+
+  plnnr_coroutine_end();
+}
+
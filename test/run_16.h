@@ -0,0 +1,23 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_16_H_
+#define run_16_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_16_Fact_Id
+{
+  run_16_fact_me = 0,
+  run_16_fact_unit = 1,
+  run_16_num_facts = 2
+};
+
+extern "C" PLNNR_DOMAIN_API void run_16_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_16_get_domain_info();
+
+#endif
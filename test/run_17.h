@@ -0,0 +1,24 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_17_H_
+#define run_17_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_17_Fact_Id
+{
+  run_17_fact_link = 0,
+  run_17_fact_target = 1,
+  run_17_fact_mark = 2,
+  run_17_num_facts = 3
+};
+
+extern "C" PLNNR_DOMAIN_API void run_17_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_17_get_domain_info();
+
+#endif
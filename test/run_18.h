@@ -0,0 +1,24 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_18_H_
+#define run_18_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_18_Fact_Id
+{
+  run_18_fact_unit = 0,
+  run_18_fact_enemy = 1,
+  run_18_fact_leader = 2,
+  run_18_num_facts = 3
+};
+
+extern "C" PLNNR_DOMAIN_API void run_18_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_18_get_domain_info();
+
+#endif
@@ -0,0 +1,22 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_19_H_
+#define run_19_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_19_Fact_Id
+{
+  run_19_fact_unit = 0,
+  run_19_num_facts = 1
+};
+
+extern "C" PLNNR_DOMAIN_API void run_19_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_19_get_domain_info();
+
+#endif
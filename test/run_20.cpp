@@ -0,0 +1,454 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#include "derplanner/runtime/domain.h"
+#include "run_20.h"
+
+using namespace plnnr;
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4100) // unreferenced formal parameter
+#pragma warning(disable: 4189) // local variable is initialized but not referenced
+#endif
+
+static bool r_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool t_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool u_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p1_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p2_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static Compound_Task_Expand* s_task_expands[] = {
+  r_case_0,
+  t_case_0,
+  u_case_0,
+};
+
+static const char* s_fact_names[] = {
+  "a",
+  "b",
+  "c",
+  "d",
+ };
+
+static const char* s_task_names[] = {
+  "p!",
+  "q!",
+  "r",
+  "t",
+  "u",
+ };
+
+static Fact_Type s_fact_types[] = {
+  { 1, {Type_Int32, } },
+  { 1, {Type_Int32, } },
+  { 1, {Type_Int32, } },
+  { 1, {Type_Int32, } },
+};
+
+static Type s_layout_types[] = {
+  Type_Int32,
+  Type_Int32,
+  Type_Int32,
+};
+
+static size_t s_layout_offsets[3];
+
+static Param_Layout s_task_parameters[] = {
+  { 2, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 1, 0, 0, s_layout_types + 2, s_layout_offsets + 2 },
+  { 0, 0, 0, 0, 0 },
+  { 0, 0, 0, 0, 0 },
+  { 0, 0, 0, 0, 0 },
+};
+
+static Param_Layout s_bindings[] = {
+  { 0, 0, 0, 0, 0 },
+  { 2, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 2, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+};
+
+static uint32_t s_num_cases[] = {
+  1, 
+  1, 
+  1, 
+};
+
+static uint32_t s_first_case[] = {
+  0, 
+  1, 
+  2, 
+};
+
+static uint32_t s_size_hints[] = {
+  0,
+  0,
+  0,
+  0,
+};
+
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+  0, 
+  0, 
+  0, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  0, 
+  0, 
+  0, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 0, { 0, }, Fact_Index_Hash }
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+  false, 
+  false, 
+};
+
+static uint32_t s_num_case_handles[] = {
+  0, 
+  7, 
+  6, 
+};
+
+static uint32_t s_frame_costs[5];
+
+static bool s_collects_bindings[] = {
+  false, 
+  false, 
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0, 
+  0, 
+  0
+};
+
+static uint32_t s_collect_facts[] = {
+  0
+};
+
+static bool s_parallel[] = {
+  false, 
+  false, 
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+  p1_next,
+  p2_next,
+};
+
+static uint32_t s_fact_name_hashes[] = {
+  2456313694, 
+  2260187636, 
+  754329161, 
+  4163039750, 
+};
+
+static uint32_t s_task_name_hashes[] = {
+  1274055463, 
+  4047964875, 
+  744399309, 
+  2418444476, 
+  1479000828, 
+};
+
+static const char* s_symbol_values[] = {
+  0
+ };
+
+static uint32_t s_symbol_hashes[] = {
+  0
+};
+
+static Domain_Info s_domain_info = {
+  { 5, 2, 3, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 4, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
+  { 0, 0, s_symbol_hashes, s_symbol_values }
+};
+
+void run_20_init_domain_info()
+{
+  for (size_t i = 0; i < plnnr_static_array_size(s_task_parameters); ++i) {
+    compute_offsets_and_size(&s_task_parameters[i]);
+  }
+
+  for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
+    compute_offsets_and_size(&s_bindings[i]);
+  }
+
+  compute_frame_costs(&s_domain_info);
+}
+
+const Domain_Info* run_20_get_domain_info() { return &s_domain_info; }
+
+namespace {
+
+struct S_1 {
+  int32_t _0;
+  int32_t _1;
+};
+
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  plnnr_coroutine_yield(frame, precond_label, 1);
+
+  plnnr_coroutine_end();
+}
+
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+namespace {
+struct Filter_p1_0 {
+  const S_1* binds;
+  Filter_p1_0(const S_1* binds) :binds(binds) {}
+
+  inline uint64_t operator()(const Fact_Table* table, uint32_t begin, uint32_t end) const {
+    const int32_t* c0 = get_column<int32_t>(table, 0);
+    uint64_t mask = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+      const bool match = bool((int32_t(load_row(c0, i)) < 3));
+      mask |= uint64_t(match) << (i - begin);
+    }
+
+    return mask;
+  }
+};
+}
+
+template <typename Binding>
+static bool p1_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_1* binds = (S_1*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  {
+    for (handles[1] = first(db, Binding::tbl(state, 0)); is_valid(db, handles[1]); handles[1] = next(db, handles[1])) { // a
+      binds->_0 = int32_t(as_Int32(db, handles[1], 0));
+      handles[0].entry = 1;
+      goto branch_0;
+      branch_0_1:;
+    }
+  }
+  {
+    for (handles[3] = first_filtered(db, Binding::tbl(state, 1), row_mask(handles, 2), Filter_p1_0(binds)); is_valid(db, handles[3]); handles[3] = next_filtered(db, handles[3], row_mask(handles, 2), Filter_p1_0(binds))) { // b
+      binds->_0 = int32_t(as_Int32(db, handles[3], 0));
+      if (bool((binds->_0 < 3))) {
+        handles[0].entry = 2;
+        goto branch_0;
+        branch_0_2:;
+      }
+    }
+  }
+  goto branch_0_end;
+  branch_0:;
+  {
+    for (handles[5] = first(db, Binding::tbl(state, 2)); is_valid(db, handles[5]); handles[5] = next(db, handles[5])) { // c
+      binds->_1 = int32_t(as_Int32(db, handles[5], 0));
+      handles[4].entry = 1;
+      goto branch_4;
+      branch_4_1:;
+    }
+  }
+  {
+    for (handles[6] = first(db, Binding::tbl(state, 3)); is_valid(db, handles[6]); handles[6] = next(db, handles[6])) { // d
+      binds->_1 = int32_t(as_Int32(db, handles[6], 0));
+      handles[4].entry = 2;
+      goto branch_4;
+      branch_4_2:;
+    }
+  }
+  goto branch_4_end;
+  branch_4:;
+  if (bool(((binds->_0 + binds->_1) != 21))) {
+    plnnr_coroutine_yield(frame, precond_label, 1);
+  }
+  if (handles[4].entry == 1) goto branch_4_1;
+  goto branch_4_2;
+  branch_4_end:;
+  if (handles[0].entry == 1) goto branch_0_1;
+  goto branch_0_2;
+  branch_0_end:;
+
+  plnnr_coroutine_end();
+}
+
+static bool p1_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p1_body<Identity_Binding>(state, frame, db) : p1_body<Mapped_Binding>(state, frame, db);
+}
+
+namespace {
+struct Filter_p2_0 {
+  const S_1* binds;
+  Filter_p2_0(const S_1* binds) :binds(binds) {}
+
+  inline uint64_t operator()(const Fact_Table* table, uint32_t begin, uint32_t end) const {
+    const int32_t* c0 = get_column<int32_t>(table, 0);
+    uint64_t mask = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+      const bool match = bool(((binds->_0 + int32_t(load_row(c0, i))) == 12));
+      mask |= uint64_t(match) << (i - begin);
+    }
+
+    return mask;
+  }
+};
+}
+
+template <typename Binding>
+static bool p2_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_1* binds = (S_1*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  {
+    for (handles[1] = first(db, Binding::tbl(state, 0)); is_valid(db, handles[1]); handles[1] = next(db, handles[1])) { // a
+      binds->_0 = int32_t(as_Int32(db, handles[1], 0));
+      handles[0].entry = 1;
+      goto branch_0;
+      branch_0_1:;
+    }
+  }
+  {
+    for (handles[2] = first(db, Binding::tbl(state, 1)); is_valid(db, handles[2]); handles[2] = next(db, handles[2])) { // b
+      binds->_0 = int32_t(as_Int32(db, handles[2], 0));
+      handles[0].entry = 2;
+      goto branch_0;
+      branch_0_2:;
+    }
+  }
+  goto branch_0_end;
+  branch_0:;
+  {
+    if (bool((binds->_0 < 2))) {
+      handles[3].entry = 1;
+      goto branch_3;
+      branch_3_1:;
+    }
+  }
+  {
+    for (handles[5] = first_filtered(db, Binding::tbl(state, 2), row_mask(handles, 4), Filter_p2_0(binds)); is_valid(db, handles[5]); handles[5] = next_filtered(db, handles[5], row_mask(handles, 4), Filter_p2_0(binds))) { // c
+      binds->_1 = int32_t(as_Int32(db, handles[5], 0));
+      if (bool(((binds->_0 + binds->_1) == 12))) {
+        handles[3].entry = 2;
+        goto branch_3;
+        branch_3_2:;
+      }
+    }
+  }
+  goto branch_3_end;
+  branch_3:;
+  plnnr_coroutine_yield(frame, precond_label, 1);
+  if (handles[3].entry == 1) goto branch_3_1;
+  goto branch_3_2;
+  branch_3_end:;
+  if (handles[0].entry == 1) goto branch_0_1;
+  goto branch_0_2;
+  branch_0_end:;
+
+  plnnr_coroutine_end();
+}
+
+static bool p2_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p2_body<Identity_Binding>(state, frame, db) : p2_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool r_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p0_next(state, frame, db)) {
+    begin_compound(state, &s_domain_info, 3); // t
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    begin_compound(state, &s_domain_info, 4); // u
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool t_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p1_next(state, frame, db)) {
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_0));
+    set_task_arg(state, &s_task_parameters[0], 1, int32_t(binds->_1));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool u_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p2_next(state, frame, db)) {
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 1); // q!
+    set_task_arg(state, &s_task_parameters[1], 0, int32_t(binds->_0));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+  }
+
+  plnnr_coroutine_end();
+}
+
@@ -0,0 +1,25 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_20_H_
+#define run_20_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_20_Fact_Id
+{
+  run_20_fact_a = 0,
+  run_20_fact_b = 1,
+  run_20_fact_c = 2,
+  run_20_fact_d = 3,
+  run_20_num_facts = 4
+};
+
+extern "C" PLNNR_DOMAIN_API void run_20_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_20_get_domain_info();
+
+#endif
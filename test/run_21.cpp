@@ -0,0 +1,319 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#include "derplanner/runtime/domain.h"
+#include "run_21.h"
+
+using namespace plnnr;
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4100) // unreferenced formal parameter
+#pragma warning(disable: 4189) // local variable is initialized but not referenced
+#endif
+
+static bool r_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool t_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p1_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static Compound_Task_Expand* s_task_expands[] = {
+  r_case_0,
+  t_case_0,
+};
+
+static const char* s_fact_names[] = {
+  "a",
+  "b",
+ };
+
+static const char* s_task_names[] = {
+  "p!",
+  "r",
+  "t",
+ };
+
+static Fact_Type s_fact_types[] = {
+  { 2, {Type_Int32, Type_Float, } },
+  { 1, {Type_Int32, } },
+};
+
+static Type s_layout_types[] = {
+  Type_Int32,
+  Type_Int32,
+  Type_Float,
+};
+
+static size_t s_layout_offsets[3];
+
+static Param_Layout s_task_parameters[] = {
+  { 2, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 0, 0, 0, 0, 0 },
+  { 1, 0, 0, s_layout_types + 2, s_layout_offsets + 2 },
+};
+
+static Param_Layout s_bindings[] = {
+  { 0, 0, 0, 0, 0 },
+  { 2, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+};
+
+static uint32_t s_num_cases[] = {
+  1, 
+  1, 
+};
+
+static uint32_t s_first_case[] = {
+  0, 
+  1, 
+};
+
+static uint32_t s_size_hints[] = {
+  0,
+  0,
+};
+
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+  0, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  0, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 0, { 0, }, Fact_Index_Hash }
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+};
+
+static uint32_t s_num_case_handles[] = {
+  0, 
+  2, 
+};
+
+static uint32_t s_frame_costs[3];
+
+static bool s_collects_bindings[] = {
+  false, 
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0, 
+  0
+};
+
+static uint32_t s_collect_facts[] = {
+  0
+};
+
+static bool s_parallel[] = {
+  false, 
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+  p1_next,
+};
+
+static uint32_t s_fact_name_hashes[] = {
+  2456313694, 
+  2260187636, 
+};
+
+static uint32_t s_task_name_hashes[] = {
+  1274055463, 
+  744399309, 
+  2418444476, 
+};
+
+static const char* s_symbol_values[] = {
+  0
+ };
+
+static uint32_t s_symbol_hashes[] = {
+  0
+};
+
+static Domain_Info s_domain_info = {
+  { 3, 1, 2, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 2, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
+  { 0, 0, s_symbol_hashes, s_symbol_values }
+};
+
+void run_21_init_domain_info()
+{
+  for (size_t i = 0; i < plnnr_static_array_size(s_task_parameters); ++i) {
+    compute_offsets_and_size(&s_task_parameters[i]);
+  }
+
+  for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
+    compute_offsets_and_size(&s_bindings[i]);
+  }
+
+  compute_frame_costs(&s_domain_info);
+}
+
+const Domain_Info* run_21_get_domain_info() { return &s_domain_info; }
+
+namespace {
+
+struct S_1 {
+  float _0;
+};
+
+struct S_2 {
+  int32_t _0;
+  int32_t _1;
+};
+
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  plnnr_coroutine_yield(frame, precond_label, 1);
+
+  plnnr_coroutine_end();
+}
+
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p1_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  const S_1* args = (const S_1*)(frame->arguments);
+  S_2* binds = (S_2*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first(db, Binding::tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next_table(db, handles[0])) { // a
+    const Fact_Table* table_0;
+    const uint8_t* removed_0;
+    uint32_t rows_0;
+    uint32_t row_0;
+    const int32_t* c0_0;
+    const float* c0_1;
+    table_0 = get_table(db, handles[0]);
+    removed_0 = get_removed(table_0);
+    rows_0 = table_0->num_entries;
+    row_0 = handles[0].entry;
+    c0_0 = get_column<int32_t>(table_0, 0);
+    c0_1 = get_column<float>(table_0, 1);
+
+    for (; row_0 < rows_0; ++row_0) {
+      if (removed_0 && removed_0[row_0]) {
+        continue;
+      }
+
+      binds->_0 = int32_t(load_row(c0_0, row_0));
+      if (args->_0 != float(load_row(c0_1, row_0))) {
+        continue;
+      }
+
+      for (handles[1] = first(db, Binding::tbl(state, 1)); is_valid(db, handles[1]); handles[1] = next_table(db, handles[1])) { // b
+        const Fact_Table* table_1;
+        const uint8_t* removed_1;
+        uint32_t rows_1;
+        uint32_t row_1;
+        const int32_t* c1_0;
+        table_1 = get_table(db, handles[1]);
+        removed_1 = get_removed(table_1);
+        rows_1 = table_1->num_entries;
+        row_1 = handles[1].entry;
+        c1_0 = get_column<int32_t>(table_1, 0);
+
+        for (; row_1 < rows_1; ++row_1) {
+          if (removed_1 && removed_1[row_1]) {
+            continue;
+          }
+
+          binds->_1 = int32_t(load_row(c1_0, row_1));
+          handles[0].entry = row_0;
+          handles[1].entry = row_1;
+          plnnr_coroutine_yield(frame, precond_label, 1);
+          table_0 = get_table(db, handles[0]);
+          removed_0 = get_removed(table_0);
+          rows_0 = table_0->num_entries;
+          row_0 = handles[0].entry;
+          c0_0 = get_column<int32_t>(table_0, 0);
+          c0_1 = get_column<float>(table_0, 1);
+          table_1 = get_table(db, handles[1]);
+          removed_1 = get_removed(table_1);
+          rows_1 = table_1->num_entries;
+          row_1 = handles[1].entry;
+          c1_0 = get_column<int32_t>(table_1, 0);
+        }
+      }
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p1_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p1_body<Identity_Binding>(state, frame, db) : p1_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool r_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p0_next(state, frame, db)) {
+    begin_compound(state, &s_domain_info, 2); // t
+    set_compound_arg(state, &s_task_parameters[2], 0, float(0.5));
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool t_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* args = (const S_1*)(frame->arguments);
+  const S_2* binds = (const S_2*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p1_next(state, frame, db)) {
+    binds = (const S_2*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_0));
+    set_task_arg(state, &s_task_parameters[0], 1, int32_t(binds->_1));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+  }
+
+  plnnr_coroutine_end();
+}
+
@@ -0,0 +1,23 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_22_H_
+#define run_22_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_22_Fact_Id
+{
+  run_22_fact_cost = 0,
+  run_22_fact_allowed = 1,
+  run_22_num_facts = 2
+};
+
+extern "C" PLNNR_DOMAIN_API void run_22_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_22_get_domain_info();
+
+#endif
@@ -0,0 +1,23 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_23_H_
+#define run_23_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_23_Fact_Id
+{
+  run_23_fact_a = 0,
+  run_23_fact_b = 1,
+  run_23_num_facts = 2
+};
+
+extern "C" PLNNR_DOMAIN_API void run_23_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_23_get_domain_info();
+
+#endif
@@ -0,0 +1,23 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_24_H_
+#define run_24_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_24_Fact_Id
+{
+  run_24_fact_edge = 0,
+  run_24_fact_mark = 1,
+  run_24_num_facts = 2
+};
+
+extern "C" PLNNR_DOMAIN_API void run_24_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_24_get_domain_info();
+
+#endif
@@ -0,0 +1,471 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#include "derplanner/runtime/domain.h"
+#include "run_25.h"
+
+using namespace plnnr;
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4100) // unreferenced formal parameter
+#pragma warning(disable: 4189) // local variable is initialized but not referenced
+#endif
+
+static bool root_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool open_links_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool unclosed_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool unblocked_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p1_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p2_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p3_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static Compound_Task_Expand* s_task_expands[] = {
+  root_case_0,
+  open_links_case_0,
+  unclosed_case_0,
+  unblocked_case_0,
+};
+
+static const char* s_fact_names[] = {
+  "link",
+  "blocked",
+  "closed",
+ };
+
+static const char* s_task_names[] = {
+  "p!",
+  "q!",
+  "r!",
+  "root",
+  "open_links",
+  "unclosed",
+  "unblocked",
+ };
+
+static Fact_Type s_fact_types[] = {
+  { 2, {Type_Int32, Type_Int32, } },
+  { 2, {Type_Int32, Type_Int32, } },
+  { 2, {Type_Int32, Type_Int32, } },
+};
+
+static Type s_layout_types[] = {
+  Type_Int32,
+  Type_Int32,
+  Type_Int32,
+};
+
+static size_t s_layout_offsets[3];
+
+static Param_Layout s_task_parameters[] = {
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 0, 0, 0, 0, 0 },
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 0, 0, 0, 0, 0 },
+};
+
+static Param_Layout s_bindings[] = {
+  { 0, 0, 0, 0, 0 },
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 2, 0, 0, s_layout_types + 1, s_layout_offsets + 1 },
+  { 2, 0, 0, s_layout_types + 1, s_layout_offsets + 1 },
+};
+
+static uint32_t s_num_cases[] = {
+  1, 
+  1, 
+  1, 
+  1, 
+};
+
+static uint32_t s_first_case[] = {
+  0, 
+  1, 
+  2, 
+  3, 
+};
+
+static uint32_t s_size_hints[] = {
+  0,
+  0,
+  0,
+};
+
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+  1, 
+  1, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  0, 
+  1, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 2, {0, 1, }, Fact_Index_Hash }, // blocked
+  { 1, {0, }, Fact_Index_Hash }, // closed
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+  false, 
+};
+
+static uint32_t s_num_case_handles[] = {
+  0, 
+  2, 
+  2, 
+  3, 
+};
+
+static uint32_t s_frame_costs[7];
+
+static bool s_collects_bindings[] = {
+  false, 
+  false, 
+  false, 
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0, 
+  0, 
+  0, 
+  0
+};
+
+static uint32_t s_collect_facts[] = {
+  0
+};
+
+static bool s_parallel[] = {
+  false, 
+  false, 
+  false, 
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+  p1_next,
+  p2_next,
+  p3_next,
+};
+
+static uint32_t s_fact_name_hashes[] = {
+  1392870040, 
+  2663244292, 
+  595637699, 
+};
+
+static uint32_t s_task_name_hashes[] = {
+  1274055463, 
+  4047964875, 
+  328636914, 
+  2484197952, 
+  2478863459, 
+  1754826607, 
+  2795899419, 
+};
+
+static const char* s_symbol_values[] = {
+  0
+ };
+
+static uint32_t s_symbol_hashes[] = {
+  0
+};
+
+static Domain_Info s_domain_info = {
+  { 7, 3, 4, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 3, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
+  { 0, 0, s_symbol_hashes, s_symbol_values }
+};
+
+void run_25_init_domain_info()
+{
+  for (size_t i = 0; i < plnnr_static_array_size(s_task_parameters); ++i) {
+    compute_offsets_and_size(&s_task_parameters[i]);
+  }
+
+  for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
+    compute_offsets_and_size(&s_bindings[i]);
+  }
+
+  compute_frame_costs(&s_domain_info);
+}
+
+const Domain_Info* run_25_get_domain_info() { return &s_domain_info; }
+
+namespace {
+
+struct S_1 {
+  int32_t _0;
+};
+
+struct S_2 {
+  int32_t _0;
+  int32_t _1;
+};
+
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  plnnr_coroutine_yield(frame, precond_label, 1);
+
+  plnnr_coroutine_end();
+}
+
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p1_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  const S_1* args = (const S_1*)(frame->arguments);
+  S_1* binds = (S_1*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first_equal(db, Binding::tbl(state, 0), 0, int32_t(args->_0)); is_valid(db, handles[0]); handles[0] = next_equal(db, handles[0], 0, int32_t(args->_0))) { // link
+    if (args->_0 != int32_t(as_Int32(db, handles[0], 0))) {
+      continue;
+    }
+
+    binds->_0 = int32_t(as_Int32(db, handles[0], 1));
+    for (handles[1] = first(db, Binding::tbl(state, 1), 0, hash_Int32(hash_Int32(0, int32_t(args->_0)), int32_t(binds->_0))); is_valid(db, handles[1]); handles[1] = next(db, handles[1], 0)) { // blocked
+      if (args->_0 != int32_t(as_Int32(db, handles[1], 0))) {
+        continue;
+      }
+
+      if (binds->_0 != int32_t(as_Int32(db, handles[1], 1))) {
+        continue;
+      }
+
+      break;
+    }
+
+    if (!is_valid(db, handles[1])) {
+      plnnr_coroutine_yield(frame, precond_label, 1);
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p1_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p1_body<Identity_Binding>(state, frame, db) : p1_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p2_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  const S_1* args = (const S_1*)(frame->arguments);
+  S_2* binds = (S_2*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first_equal(db, Binding::tbl(state, 0), 0, int32_t(args->_0)); is_valid(db, handles[0]); handles[0] = next_equal(db, handles[0], 0, int32_t(args->_0))) { // link
+    if (args->_0 != int32_t(as_Int32(db, handles[0], 0))) {
+      continue;
+    }
+
+    binds->_0 = int32_t(as_Int32(db, handles[0], 1));
+    for (handles[1] = first(db, Binding::tbl(state, 2), 0, hash_Int32(0, int32_t(binds->_0))); is_valid(db, handles[1]); handles[1] = next(db, handles[1], 0)) { // closed
+      if (binds->_0 != int32_t(as_Int32(db, handles[1], 0))) {
+        continue;
+      }
+
+      break;
+    }
+
+    if (!is_valid(db, handles[1])) {
+      plnnr_coroutine_yield(frame, precond_label, 1);
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p2_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p2_body<Identity_Binding>(state, frame, db) : p2_body<Mapped_Binding>(state, frame, db);
+}
+
+namespace {
+struct Filter_p3_0 {
+  const S_2* binds;
+  Filter_p3_0(const S_2* binds) :binds(binds) {}
+
+  inline uint64_t operator()(const Fact_Table* table, uint32_t begin, uint32_t end) const {
+    const int32_t* c0 = get_column<int32_t>(table, 0);
+    const int32_t* c1 = get_column<int32_t>(table, 1);
+    uint64_t mask = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+      const bool match = bool((int32_t(load_row(c0, i)) < int32_t(load_row(c1, i))));
+      mask |= uint64_t(match) << (i - begin);
+    }
+
+    return mask;
+  }
+};
+}
+
+template <typename Binding>
+static bool p3_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_2* binds = (S_2*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[1] = first_filtered(db, Binding::tbl(state, 1), row_mask(handles, 0), Filter_p3_0(binds)); is_valid(db, handles[1]); handles[1] = next_filtered(db, handles[1], row_mask(handles, 0), Filter_p3_0(binds))) { // blocked
+    binds->_0 = int32_t(as_Int32(db, handles[1], 0));
+    binds->_1 = int32_t(as_Int32(db, handles[1], 1));
+    for (handles[2] = first(db, Binding::tbl(state, 1), 0, hash_Int32(hash_Int32(0, int32_t(binds->_1)), int32_t(binds->_0))); is_valid(db, handles[2]); handles[2] = next(db, handles[2], 0)) { // blocked
+      if (binds->_1 != int32_t(as_Int32(db, handles[2], 0))) {
+        continue;
+      }
+
+      if (binds->_0 != int32_t(as_Int32(db, handles[2], 1))) {
+        continue;
+      }
+
+      break;
+    }
+
+    if (!is_valid(db, handles[2])) {
+      if (bool((binds->_0 < binds->_1))) {
+        plnnr_coroutine_yield(frame, precond_label, 1);
+      }
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p3_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p3_body<Identity_Binding>(state, frame, db) : p3_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool root_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p0_next(state, frame, db)) {
+    begin_compound(state, &s_domain_info, 4); // open_links
+    set_compound_arg(state, &s_task_parameters[4], 0, int32_t(1));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    begin_compound(state, &s_domain_info, 5); // unclosed
+    set_compound_arg(state, &s_task_parameters[5], 0, int32_t(1));
+    plnnr_coroutine_yield(frame, expand_label, 2);
+
+    begin_compound(state, &s_domain_info, 6); // unblocked
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 3);
+
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool open_links_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* args = (const S_1*)(frame->arguments);
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p1_next(state, frame, db)) {
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_0));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool unclosed_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* args = (const S_1*)(frame->arguments);
+  const S_2* binds = (const S_2*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p2_next(state, frame, db)) {
+    binds = (const S_2*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 1); // q!
+    set_task_arg(state, &s_task_parameters[1], 0, int32_t(binds->_0));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool unblocked_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_2* binds = (const S_2*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p3_next(state, frame, db)) {
+    binds = (const S_2*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 2); // r!
+    set_task_arg(state, &s_task_parameters[2], 0, int32_t(binds->_0));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    continue_iteration(state, frame);
+  }
+
+  if (frame->status == Expansion_Frame::Status_Was_Expanded) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 2);
+  }
+
+  plnnr_coroutine_end();
+}
+
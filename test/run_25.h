@@ -0,0 +1,24 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_25_H_
+#define run_25_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_25_Fact_Id
+{
+  run_25_fact_link = 0,
+  run_25_fact_blocked = 1,
+  run_25_fact_closed = 2,
+  run_25_num_facts = 3
+};
+
+extern "C" PLNNR_DOMAIN_API void run_25_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_25_get_domain_info();
+
+#endif
@@ -0,0 +1,447 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#include "derplanner/runtime/domain.h"
+#include "run_26.h"
+
+using namespace plnnr;
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4100) // unreferenced formal parameter
+#pragma warning(disable: 4189) // local variable is initialized but not referenced
+#endif
+
+static bool root_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool walk_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool walk_case_1(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool visit_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p1_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p2_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p3_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static Compound_Task_Expand* s_task_expands[] = {
+  root_case_0,
+  walk_case_0,
+  visit_case_0,
+};
+
+static const char* s_fact_names[] = {
+  "next",
+  "cost",
+  "ok",
+ };
+
+static const char* s_task_names[] = {
+  "p!",
+  "q!",
+  "root",
+  "walk",
+  "visit",
+ };
+
+static Fact_Type s_fact_types[] = {
+  { 2, {Type_Int32, Type_Int32, } },
+  { 3, {Type_Int32, Type_Int32, Type_Int32, } },
+  { 1, {Type_Int32, } },
+};
+
+static Type s_layout_types[] = {
+  Type_Int32,
+  Type_Int32,
+  Type_Int32,
+  Type_Int32,
+  Type_Int32,
+  Type_Int32,
+};
+
+static size_t s_layout_offsets[6];
+
+static Param_Layout s_task_parameters[] = {
+  { 2, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 1, 0, 0, s_layout_types + 2, s_layout_offsets + 2 },
+  { 0, 0, 0, 0, 0 },
+  { 1, 0, 0, s_layout_types + 2, s_layout_offsets + 2 },
+  { 1, 0, 0, s_layout_types + 2, s_layout_offsets + 2 },
+};
+
+static Param_Layout s_bindings[] = {
+  { 0, 0, 0, 0, 0 },
+  { 3, 0, 0, s_layout_types + 3, s_layout_offsets + 3 },
+  { 0, 0, 0, 0, 0 },
+  { 0, 0, 0, 0, 0 },
+};
+
+static uint32_t s_num_cases[] = {
+  1, 
+  2, 
+  1, 
+};
+
+static uint32_t s_first_case[] = {
+  0, 
+  1, 
+  3, 
+};
+
+static uint32_t s_size_hints[] = {
+  0,
+  0,
+  0,
+};
+
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+  0, 
+  0, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  0, 
+  0, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 0, { 0, }, Fact_Index_Hash }
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+  false, 
+};
+
+static uint32_t s_num_case_handles[] = {
+  0, 
+  2, 
+  0, 
+  1, 
+};
+
+static uint32_t s_frame_costs[5];
+
+static bool s_collects_bindings[] = {
+  false, 
+  true, 
+  false, 
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0, 
+  2, 
+  2, 
+  2
+};
+
+static uint32_t s_collect_facts[] = {
+  1, // cost
+  0, // next
+};
+
+static bool s_parallel[] = {
+  false, 
+  false, 
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+  p1_next,
+  p2_next,
+  p3_next,
+};
+
+static uint32_t s_fact_name_hashes[] = {
+  2852775837, 
+  955530522, 
+  1779885824, 
+};
+
+static uint32_t s_task_name_hashes[] = {
+  1274055463, 
+  4047964875, 
+  2484197952, 
+  3844704721, 
+  1340787936, 
+};
+
+static const char* s_symbol_values[] = {
+  0
+ };
+
+static uint32_t s_symbol_hashes[] = {
+  0
+};
+
+static Domain_Info s_domain_info = {
+  { 5, 2, 3, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 3, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
+  { 0, 0, s_symbol_hashes, s_symbol_values }
+};
+
+void run_26_init_domain_info()
+{
+  for (size_t i = 0; i < plnnr_static_array_size(s_task_parameters); ++i) {
+    compute_offsets_and_size(&s_task_parameters[i]);
+  }
+
+  for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
+    compute_offsets_and_size(&s_bindings[i]);
+  }
+
+  compute_frame_costs(&s_domain_info);
+}
+
+const Domain_Info* run_26_get_domain_info() { return &s_domain_info; }
+
+namespace {
+
+struct S_1 {
+  int32_t _0;
+};
+
+struct S_2 {
+  int32_t _0;
+  int32_t _1;
+  int32_t _2;
+};
+
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  plnnr_coroutine_yield(frame, precond_label, 1);
+
+  plnnr_coroutine_end();
+}
+
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+namespace {
+struct Compare_p1 {
+  const S_1* args;
+  Compare_p1(const S_1* args) :args(args) {}
+
+  inline int32_t key(const S_2* binds) const {
+    return int32_t(binds->_1);
+  }
+
+  inline bool operator()(const S_2& a, const S_2& b) const {
+    return key(&b) < key(&a);
+  }
+};
+}
+
+namespace {
+struct Distinct_p1 {
+  inline uint32_t hash(const S_2& a) const {
+    uint32_t h = 0;
+    h = hash_Int32(h, a._0);
+    h = hash_Int32(h, a._1);
+    h = hash_Int32(h, a._2);
+    return h;
+  }
+
+  inline bool equal(const S_2& a, const S_2& b) const {
+    return a._0 == b._0 && a._1 == b._1 && a._2 == b._2;
+  }
+};
+}
+
+template <typename Binding>
+static bool p1_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  const S_1* args = (const S_1*)(frame->arguments);
+  S_2* binds = (S_2*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  frame->num_bindings = 0;
+  for (handles[0] = first_equal(db, Binding::tbl(state, 1), 0, int32_t(args->_0)); is_valid(db, handles[0]); handles[0] = next_equal(db, handles[0], 0, int32_t(args->_0))) { // cost
+    if (args->_0 != int32_t(as_Int32(db, handles[0], 0))) {
+      continue;
+    }
+
+    binds->_0 = int32_t(as_Int32(db, handles[0], 1));
+    binds->_1 = int32_t(as_Int32(db, handles[0], 2));
+    for (handles[1] = first_equal(db, Binding::tbl(state, 0), 0, int32_t(args->_0)); is_valid(db, handles[1]); handles[1] = next_equal(db, handles[1], 0, int32_t(args->_0))) { // next
+      if (args->_0 != int32_t(as_Int32(db, handles[1], 0))) {
+        continue;
+      }
+
+      binds->_2 = int32_t(as_Int32(db, handles[1], 1));
+      binds = (S_2*)(allocate_precond_bindings(state, &s_bindings[1]));
+      handles = frame->handles;
+      args = (const S_1*)(frame->arguments);
+      *binds = *(binds - 1);
+      ++frame->num_bindings;
+    }
+  }
+
+  if (frame->num_bindings > 0) {
+    revert(&state->expansion_blob, binds);
+  }
+
+  remove_duplicates<S_2>(state, frame, Distinct_p1());
+  handles = frame->handles;
+  args = (const S_1*)(frame->arguments);
+  binds = (S_2*)(frame->bindings);
+  std::make_heap(binds, binds + frame->num_bindings, Compare_p1(args));
+
+  for (frame->binding_index = frame->num_bindings; frame->binding_index > 0; ) {
+    std::pop_heap(binds, binds + frame->binding_index, Compare_p1(args));
+    --frame->binding_index;
+    plnnr_coroutine_yield(frame, precond_label, 1);
+  }
+
+
+  plnnr_coroutine_end();
+}
+
+static bool p1_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p1_body<Identity_Binding>(state, frame, db) : p1_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p2_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  const S_1* args = (const S_1*)(frame->arguments);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  plnnr_coroutine_yield(frame, precond_label, 1);
+
+  plnnr_coroutine_end();
+}
+
+static bool p2_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p2_body<Identity_Binding>(state, frame, db) : p2_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p3_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  const S_1* args = (const S_1*)(frame->arguments);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first_equal(db, Binding::tbl(state, 2), 0, int32_t(args->_0)); is_valid(db, handles[0]); handles[0] = next_equal(db, handles[0], 0, int32_t(args->_0))) { // ok
+    if (args->_0 != int32_t(as_Int32(db, handles[0], 0))) {
+      continue;
+    }
+
+    plnnr_coroutine_yield(frame, precond_label, 1);
+    break;
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p3_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p3_body<Identity_Binding>(state, frame, db) : p3_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool root_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p0_next(state, frame, db)) {
+    begin_compound(state, &s_domain_info, 3); // walk
+    set_compound_arg(state, &s_task_parameters[3], 0, int32_t(1));
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool walk_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* args = (const S_1*)(frame->arguments);
+  const S_2* binds = (const S_2*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p1_next(state, frame, db)) {
+    args = (const S_1*)(frame->arguments);
+    binds = (const S_2*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(args->_0));
+    set_task_arg(state, &s_task_parameters[0], 1, int32_t(binds->_0));
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+    begin_compound(state, &s_domain_info, 4); // visit
+    set_compound_arg(state, &s_task_parameters[4], 0, int32_t(binds->_0));
+    plnnr_coroutine_yield(frame, expand_label, 2);
+
+    begin_compound(state, &s_domain_info, 3); // walk
+    set_compound_arg(state, &s_task_parameters[3], 0, int32_t(binds->_2));
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 3);
+
+  }
+
+  return expand_next_case(state, &s_domain_info, 3, frame, db, walk_case_1);
+
+  plnnr_coroutine_end();
+}
+
+static bool walk_case_1(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* args = (const S_1*)(frame->arguments);
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p2_next(state, frame, db)) {
+    args = (const S_1*)(frame->arguments);
+    begin_task(state, &s_domain_info, 1); // q!
+    set_task_arg(state, &s_task_parameters[1], 0, int32_t(args->_0));
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool visit_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* args = (const S_1*)(frame->arguments);
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p3_next(state, frame, db)) {
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 1);
+  }
+
+  plnnr_coroutine_end();
+}
+
@@ -0,0 +1,24 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_26_H_
+#define run_26_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_26_Fact_Id
+{
+  run_26_fact_next = 0,
+  run_26_fact_cost = 1,
+  run_26_fact_ok = 2,
+  run_26_num_facts = 3
+};
+
+extern "C" PLNNR_DOMAIN_API void run_26_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_26_get_domain_info();
+
+#endif
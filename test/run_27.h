@@ -0,0 +1,22 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_27_H_
+#define run_27_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_27_Fact_Id
+{
+  run_27_fact_cost = 0,
+  run_27_num_facts = 1
+};
+
+extern "C" PLNNR_DOMAIN_API void run_27_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_27_get_domain_info();
+
+#endif
@@ -0,0 +1,23 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_28_H_
+#define run_28_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_28_Fact_Id
+{
+  run_28_fact_item = 0,
+  run_28_fact_good = 1,
+  run_28_num_facts = 2
+};
+
+extern "C" PLNNR_DOMAIN_API void run_28_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_28_get_domain_info();
+
+#endif
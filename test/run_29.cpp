@@ -0,0 +1,589 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#include "derplanner/runtime/domain.h"
+#include "run_29.h"
+
+using namespace plnnr;
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4100) // unreferenced formal parameter
+#pragma warning(disable: 4189) // local variable is initialized but not referenced
+#endif
+
+static bool choose_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool choose_case_1(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool choose_case_2(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool choose_case_3(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool choose_case_4(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool check_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p1_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p2_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p3_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p4_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+static bool p5_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static Compound_Task_Expand* s_task_expands[] = {
+  choose_case_0,
+  check_case_0,
+};
+
+static const char* s_fact_names[] = {
+  "item",
+  "good",
+  "best",
+ };
+
+static const char* s_task_names[] = {
+  "p!",
+  "choose",
+  "check",
+ };
+
+static Fact_Type s_fact_types[] = {
+  { 1, {Type_Int32, } },
+  { 1, {Type_Int32, } },
+  { 1, {Type_Int32, } },
+};
+
+static Type s_layout_types[] = {
+  Type_Int32,
+};
+
+static size_t s_layout_offsets[1];
+
+static Param_Layout s_task_parameters[] = {
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 0, 0, 0, 0, 0 },
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+};
+
+static Param_Layout s_bindings[] = {
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 1, 0, 0, s_layout_types + 0, s_layout_offsets + 0 },
+  { 0, 0, 0, 0, 0 },
+  { 0, 0, 0, 0, 0 },
+};
+
+static uint32_t s_num_cases[] = {
+  5, 
+  1, 
+};
+
+static uint32_t s_first_case[] = {
+  0, 
+  5, 
+};
+
+static uint32_t s_size_hints[] = {
+  0,
+  0,
+  0,
+};
+
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+  0, 
+  0, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  0, 
+  0, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 0, { 0, }, Fact_Index_Hash }
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+  false, 
+};
+
+static uint32_t s_num_case_handles[] = {
+  1, 
+  2, 
+  2, 
+  2, 
+  0, 
+  0, 
+};
+
+static uint32_t s_frame_costs[3];
+
+static bool s_collects_bindings[] = {
+  false, 
+  false, 
+  true, 
+  false, 
+  false, 
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0, 
+  0, 
+  1, 
+  1, 
+  1, 
+  1
+};
+
+static uint32_t s_collect_facts[] = {
+  1, // good
+};
+
+static bool s_parallel[] = {
+  true, 
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+  p1_next,
+  p2_next,
+  p3_next,
+  p4_next,
+  p5_next,
+};
+
+static uint32_t s_fact_name_hashes[] = {
+  3892294984, 
+  1590259262, 
+  1017619341, 
+};
+
+static uint32_t s_task_name_hashes[] = {
+  1274055463, 
+  1499293651, 
+  3260980996, 
+};
+
+static const char* s_symbol_values[] = {
+  0
+ };
+
+static uint32_t s_symbol_hashes[] = {
+  0
+};
+
+static Domain_Info s_domain_info = {
+  { 3, 1, 2, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 3, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
+  { 0, 0, s_symbol_hashes, s_symbol_values }
+};
+
+void run_29_init_domain_info()
+{
+  for (size_t i = 0; i < plnnr_static_array_size(s_task_parameters); ++i) {
+    compute_offsets_and_size(&s_task_parameters[i]);
+  }
+
+  for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
+    compute_offsets_and_size(&s_bindings[i]);
+  }
+
+  compute_frame_costs(&s_domain_info);
+}
+
+const Domain_Info* run_29_get_domain_info() { return &s_domain_info; }
+
+namespace {
+
+struct S_1 {
+  int32_t _0;
+};
+
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_1* binds = (S_1*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first(db, Binding::tbl(state, 2)); is_valid(db, handles[0]); handles[0] = next_table(db, handles[0])) { // best
+    const Fact_Table* table_0;
+    const uint8_t* removed_0;
+    uint32_t rows_0;
+    uint32_t row_0;
+    const int32_t* c0_0;
+    table_0 = get_table(db, handles[0]);
+    removed_0 = get_removed(table_0);
+    rows_0 = table_0->num_entries;
+    row_0 = handles[0].entry;
+    c0_0 = get_column<int32_t>(table_0, 0);
+
+    for (; row_0 < rows_0; ++row_0) {
+      if (removed_0 && removed_0[row_0]) {
+        continue;
+      }
+
+      binds->_0 = int32_t(load_row(c0_0, row_0));
+      handles[0].entry = row_0;
+      plnnr_coroutine_yield(frame, precond_label, 1);
+      table_0 = get_table(db, handles[0]);
+      removed_0 = get_removed(table_0);
+      rows_0 = table_0->num_entries;
+      row_0 = handles[0].entry;
+      c0_0 = get_column<int32_t>(table_0, 0);
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+namespace {
+struct Filter_p1_0 {
+  const S_1* binds;
+  Filter_p1_0(const S_1* binds) :binds(binds) {}
+
+  inline uint64_t operator()(const Fact_Table* table, uint32_t begin, uint32_t end) const {
+    const int32_t* c0 = get_column<int32_t>(table, 0);
+    uint64_t mask = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+      const bool match = bool((int32_t(load_row(c0, i)) > 10));
+      mask |= uint64_t(match) << (i - begin);
+    }
+
+    return mask;
+  }
+};
+}
+
+template <typename Binding>
+static bool p1_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_1* binds = (S_1*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[1] = first_filtered(db, Binding::tbl(state, 0), row_mask(handles, 0), Filter_p1_0(binds)); is_valid(db, handles[1]); handles[1] = next_filtered(db, handles[1], row_mask(handles, 0), Filter_p1_0(binds))) { // item
+    binds->_0 = int32_t(as_Int32(db, handles[1], 0));
+    if (bool((binds->_0 > 10))) {
+      plnnr_coroutine_yield(frame, precond_label, 1);
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p1_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p1_body<Identity_Binding>(state, frame, db) : p1_body<Mapped_Binding>(state, frame, db);
+}
+
+namespace {
+struct Compare_p2 {
+  inline int32_t key(const S_1* binds) const {
+    return int32_t(binds->_0);
+  }
+
+  inline bool operator()(const S_1& a, const S_1& b) const {
+    return key(&b) < key(&a);
+  }
+};
+}
+
+namespace {
+struct Distinct_p2 {
+  inline uint32_t hash(const S_1& a) const {
+    uint32_t h = 0;
+    h = hash_Int32(h, a._0);
+    return h;
+  }
+
+  inline bool equal(const S_1& a, const S_1& b) const {
+    return a._0 == b._0;
+  }
+};
+}
+
+namespace {
+struct Filter_p2_0 {
+  const S_1* binds;
+  Filter_p2_0(const S_1* binds) :binds(binds) {}
+
+  inline uint64_t operator()(const Fact_Table* table, uint32_t begin, uint32_t end) const {
+    const int32_t* c0 = get_column<int32_t>(table, 0);
+    uint64_t mask = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+      const bool match = bool((int32_t(load_row(c0, i)) > 4));
+      mask |= uint64_t(match) << (i - begin);
+    }
+
+    return mask;
+  }
+};
+}
+
+template <typename Binding>
+static bool p2_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_1* binds = (S_1*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  frame->num_bindings = 0;
+  for (handles[1] = first_filtered(db, Binding::tbl(state, 1), row_mask(handles, 0), Filter_p2_0(binds)); is_valid(db, handles[1]); handles[1] = next_filtered(db, handles[1], row_mask(handles, 0), Filter_p2_0(binds))) { // good
+    binds->_0 = int32_t(as_Int32(db, handles[1], 0));
+    if (bool((binds->_0 > 4))) {
+      binds = (S_1*)(allocate_precond_bindings(state, &s_bindings[2]));
+      handles = frame->handles;
+      *binds = *(binds - 1);
+      ++frame->num_bindings;
+    }
+  }
+
+  if (frame->num_bindings > 0) {
+    revert(&state->expansion_blob, binds);
+  }
+
+  remove_duplicates<S_1>(state, frame, Distinct_p2());
+  handles = frame->handles;
+  binds = (S_1*)(frame->bindings);
+  std::make_heap(binds, binds + frame->num_bindings, Compare_p2());
+
+  for (frame->binding_index = frame->num_bindings; frame->binding_index > 0; ) {
+    std::pop_heap(binds, binds + frame->binding_index, Compare_p2());
+    --frame->binding_index;
+    plnnr_coroutine_yield(frame, precond_label, 1);
+  }
+
+
+  plnnr_coroutine_end();
+}
+
+static bool p2_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p2_body<Identity_Binding>(state, frame, db) : p2_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p3_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  S_1* binds = (S_1*)(frame->bindings);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  for (handles[0] = first(db, Binding::tbl(state, 0)); is_valid(db, handles[0]); handles[0] = next_table(db, handles[0])) { // item
+    const Fact_Table* table_0;
+    const uint8_t* removed_0;
+    uint32_t rows_0;
+    uint32_t row_0;
+    const int32_t* c0_0;
+    table_0 = get_table(db, handles[0]);
+    removed_0 = get_removed(table_0);
+    rows_0 = table_0->num_entries;
+    row_0 = handles[0].entry;
+    c0_0 = get_column<int32_t>(table_0, 0);
+
+    for (; row_0 < rows_0; ++row_0) {
+      if (removed_0 && removed_0[row_0]) {
+        continue;
+      }
+
+      binds->_0 = int32_t(load_row(c0_0, row_0));
+      for (handles[1] = first_equal(db, Binding::tbl(state, 1), 0, int32_t(binds->_0)); is_valid(db, handles[1]); handles[1] = next_equal(db, handles[1], 0, int32_t(binds->_0))) { // good
+        if (binds->_0 != int32_t(as_Int32(db, handles[1], 0))) {
+          continue;
+        }
+
+        handles[0].entry = row_0;
+        plnnr_coroutine_yield(frame, precond_label, 1);
+        table_0 = get_table(db, handles[0]);
+        removed_0 = get_removed(table_0);
+        rows_0 = table_0->num_entries;
+        row_0 = handles[0].entry;
+        c0_0 = get_column<int32_t>(table_0, 0);
+        break;
+      }
+    }
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p3_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p3_body<Identity_Binding>(state, frame, db) : p3_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p4_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  plnnr_coroutine_yield(frame, precond_label, 1);
+
+  plnnr_coroutine_end();
+}
+
+static bool p4_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p4_body<Identity_Binding>(state, frame, db) : p4_body<Mapped_Binding>(state, frame, db);
+}
+
+template <typename Binding>
+static bool p5_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  Fact_Handle* handles = frame->handles;
+  const S_1* args = (const S_1*)(frame->arguments);
+
+  ++state->precond_iterations;
+  plnnr_coroutine_begin(frame, precond_label);
+
+  if (bool((args->_0 > 3))) {
+    plnnr_coroutine_yield(frame, precond_label, 1);
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool p5_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p5_body<Identity_Binding>(state, frame, db) : p5_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool choose_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (speculated_next(state, frame, db, p0_next)) {
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_0));
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+  }
+
+  return expand_next_case(state, &s_domain_info, 1, frame, db, choose_case_1);
+
+  plnnr_coroutine_end();
+}
+
+static bool choose_case_1(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (speculated_next(state, frame, db, p1_next)) {
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_0));
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+  }
+
+  return expand_next_case(state, &s_domain_info, 1, frame, db, choose_case_2);
+
+  plnnr_coroutine_end();
+}
+
+static bool choose_case_2(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (speculated_next(state, frame, db, p2_next)) {
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(binds->_0));
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+  }
+
+  return expand_next_case(state, &s_domain_info, 1, frame, db, choose_case_3);
+
+  plnnr_coroutine_end();
+}
+
+static bool choose_case_3(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (speculated_next(state, frame, db, p3_next)) {
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
+    begin_compound(state, &s_domain_info, 2); // check
+    set_compound_arg(state, &s_task_parameters[2], 0, int32_t(binds->_0));
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+  }
+
+  return expand_next_case(state, &s_domain_info, 1, frame, db, choose_case_4);
+
+  plnnr_coroutine_end();
+}
+
+static bool choose_case_4(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (speculated_next(state, frame, db, p4_next)) {
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(0));
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+  }
+
+  plnnr_coroutine_end();
+}
+
+static bool check_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  const S_1* args = (const S_1*)(frame->arguments);
+
+  plnnr_coroutine_begin(frame, expand_label);
+
+  while (p5_next(state, frame, db)) {
+    args = (const S_1*)(frame->arguments);
+    begin_task(state, &s_domain_info, 0); // p!
+    set_task_arg(state, &s_task_parameters[0], 0, int32_t(args->_0));
+    frame->status = Expansion_Frame::Status_Expanded;
+    plnnr_coroutine_yield(frame, expand_label, 1);
+
+  }
+
+  plnnr_coroutine_end();
+}
+
@@ -0,0 +1,24 @@
+// generated by derplanner [http://www.github.com/alexshafranov/derplanner]
+#ifndef run_29_H_
+#define run_29_H_
+#pragma once
+
+#include "derplanner/runtime/types.h"
+
+#ifndef PLNNR_DOMAIN_API
+#define PLNNR_DOMAIN_API
+#endif
+
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_29_Fact_Id
+{
+  run_29_fact_item = 0,
+  run_29_fact_good = 1,
+  run_29_fact_best = 2,
+  run_29_num_facts = 3
+};
+
+extern "C" PLNNR_DOMAIN_API void run_29_init_domain_info();
+extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_29_get_domain_info();
+
+#endif
@@ -9,6 +9,15 @@
 #define PLNNR_DOMAIN_API
 #endif
 
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_3_Fact_Id
+{
+  run_3_fact_a = 0,
+  run_3_fact_b = 1,
+  run_3_fact_c = 2,
+  run_3_num_facts = 3
+};
+
 extern "C" PLNNR_DOMAIN_API void run_3_init_domain_info();
 extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_3_get_domain_info();
 
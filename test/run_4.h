@@ -9,6 +9,14 @@
 #define PLNNR_DOMAIN_API
 #endif
 
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_4_Fact_Id
+{
+  run_4_fact_a = 0,
+  run_4_fact_b = 1,
+  run_4_num_facts = 2
+};
+
 extern "C" PLNNR_DOMAIN_API void run_4_init_domain_info();
 extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_4_get_domain_info();
 
@@ -9,6 +9,13 @@
 #define PLNNR_DOMAIN_API
 #endif
 
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_6_Fact_Id
+{
+  run_6_fact_a = 0,
+  run_6_num_facts = 1
+};
+
 extern "C" PLNNR_DOMAIN_API void run_6_init_domain_info();
 extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_6_get_domain_info();
 
@@ -9,6 +9,14 @@
 #define PLNNR_DOMAIN_API
 #endif
 
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_7_Fact_Id
+{
+  run_7_fact_a = 0,
+  run_7_fact_b = 1,
+  run_7_num_facts = 2
+};
+
 extern "C" PLNNR_DOMAIN_API void run_7_init_domain_info();
 extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_7_get_domain_info();
 
@@ -9,6 +9,14 @@
 #define PLNNR_DOMAIN_API
 #endif
 
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_8_Fact_Id
+{
+  run_8_fact_me = 0,
+  run_8_fact_object = 1,
+  run_8_num_facts = 2
+};
+
 extern "C" PLNNR_DOMAIN_API void run_8_init_domain_info();
 extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_8_get_domain_info();
 
@@ -14,7 +14,9 @@ using namespace plnnr;
 #pragma warning(disable: 4189) // local variable is initialized but not referenced
 #endif
 
-static bool t_case_0(Planning_State*, Expansion_Frame*, Fact_Database*);
+static bool t_case_0(Planning_State*, Expansion_Frame*, const Fact_Database*);
+
+static bool p0_next(Planning_State*, Expansion_Frame*, const Fact_Database*);
 
 static Compound_Task_Expand* s_task_expands[] = {
   t_case_0,
@@ -65,10 +67,52 @@ static uint32_t s_size_hints[] = {
   0,
 };
 
+static uint32_t s_num_fact_indexes[] = {
+  0, 
+  0, 
+};
+
+static uint32_t s_first_fact_index[] = {
+  0, 
+  0, 
+};
+
+static Fact_Index_Format s_fact_indexes[] = {
+  { 0, { 0, }, Fact_Index_Hash }
+};
+
+static bool s_fact_stats[] = {
+  false, 
+  false, 
+};
+
 static uint32_t s_num_case_handles[] = {
   4, 
 };
 
+static uint32_t s_frame_costs[2];
+
+static bool s_collects_bindings[] = {
+  false, 
+};
+
+static uint32_t s_first_collect_fact[] = {
+  0, 
+  0
+};
+
+static uint32_t s_collect_facts[] = {
+  0
+};
+
+static bool s_parallel[] = {
+  false, 
+};
+
+static Case_Precondition* s_case_preconds[] = {
+  p0_next,
+};
+
 static uint32_t s_fact_name_hashes[] = {
   1272125303, 
   1252452820, 
@@ -88,8 +132,8 @@ static uint32_t s_symbol_hashes[] = {
 };
 
 static Domain_Info s_domain_info = {
-  { 2, 1, 1, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands },
-  { 2, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names },
+  { 2, 1, 1, s_num_cases, s_first_case, 0, s_task_name_hashes, s_task_names, s_task_parameters, s_bindings, s_num_case_handles, s_task_expands, s_frame_costs, s_collects_bindings, s_first_collect_fact, s_collect_facts, s_parallel, s_case_preconds },
+  { 2, 0, s_size_hints, s_fact_types, s_fact_name_hashes, s_fact_names, s_num_fact_indexes, s_first_fact_index, s_fact_indexes, s_fact_stats },
   { 0, 0, s_symbol_hashes, s_symbol_values }
 };
 
@@ -102,48 +146,153 @@ void run_9_init_domain_info()
   for (size_t i = 0; i < plnnr_static_array_size(s_bindings); ++i) {
     compute_offsets_and_size(&s_bindings[i]);
   }
+
+  compute_frame_costs(&s_domain_info);
 }
 
 const Domain_Info* run_9_get_domain_info() { return &s_domain_info; }
 
+namespace {
+
 struct S_1 {
   Id32 _0;
   Id32 _1;
 };
 
-static bool p0_next(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+}
+
+template <typename Binding>
+static bool p0_body(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
   Fact_Handle* handles = frame->handles;
   S_1* binds = (S_1*)(frame->bindings);
 
+  ++state->precond_iterations;
   plnnr_coroutine_begin(frame, precond_label);
 
-  for (handles[0] = first(db, tbl(state, 1)); is_valid(db, handles[0]); handles[0] = next(db, handles[0])) { // object2
-    binds->_0 = Id32(as_Id32(db, handles[0], 0));
-    for (handles[1] = first(db, tbl(state, 0)); is_valid(db, handles[1]); handles[1] = next(db, handles[1])) { // object1
-      binds->_1 = Id32(as_Id32(db, handles[1], 0));
-      plnnr_coroutine_yield(frame, precond_label, 1);
+  for (handles[0] = first(db, Binding::tbl(state, 1)); is_valid(db, handles[0]); handles[0] = next_table(db, handles[0])) { // object2
+    const Fact_Table* table_0;
+    const uint8_t* removed_0;
+    uint32_t rows_0;
+    uint32_t row_0;
+    const Id32* c0_0;
+    table_0 = get_table(db, handles[0]);
+    removed_0 = get_removed(table_0);
+    rows_0 = table_0->num_entries;
+    row_0 = handles[0].entry;
+    c0_0 = get_column<Id32>(table_0, 0);
+
+    for (; row_0 < rows_0; ++row_0) {
+      if (removed_0 && removed_0[row_0]) {
+        continue;
+      }
+
+      binds->_0 = Id32(load_row(c0_0, row_0));
+      for (handles[1] = first(db, Binding::tbl(state, 0)); is_valid(db, handles[1]); handles[1] = next_table(db, handles[1])) { // object1
+        const Fact_Table* table_1;
+        const uint8_t* removed_1;
+        uint32_t rows_1;
+        uint32_t row_1;
+        const Id32* c1_0;
+        table_1 = get_table(db, handles[1]);
+        removed_1 = get_removed(table_1);
+        rows_1 = table_1->num_entries;
+        row_1 = handles[1].entry;
+        c1_0 = get_column<Id32>(table_1, 0);
+
+        for (; row_1 < rows_1; ++row_1) {
+          if (removed_1 && removed_1[row_1]) {
+            continue;
+          }
+
+          binds->_1 = Id32(load_row(c1_0, row_1));
+          handles[0].entry = row_0;
+          handles[1].entry = row_1;
+          plnnr_coroutine_yield(frame, precond_label, 1);
+          table_0 = get_table(db, handles[0]);
+          removed_0 = get_removed(table_0);
+          rows_0 = table_0->num_entries;
+          row_0 = handles[0].entry;
+          c0_0 = get_column<Id32>(table_0, 0);
+          table_1 = get_table(db, handles[1]);
+          removed_1 = get_removed(table_1);
+          rows_1 = table_1->num_entries;
+          row_1 = handles[1].entry;
+          c1_0 = get_column<Id32>(table_1, 0);
+        }
+      }
     }
   }
-  for (handles[2] = first(db, tbl(state, 1)); is_valid(db, handles[2]); handles[2] = next(db, handles[2])) { // object2
-    binds->_0 = Id32(as_Id32(db, handles[2], 0));
-    for (handles[3] = first(db, tbl(state, 1)); is_valid(db, handles[3]); handles[3] = next(db, handles[3])) { // object2
-      binds->_1 = Id32(as_Id32(db, handles[3], 0));
-      plnnr_coroutine_yield(frame, precond_label, 2);
+  for (handles[2] = first(db, Binding::tbl(state, 1)); is_valid(db, handles[2]); handles[2] = next_table(db, handles[2])) { // object2
+    const Fact_Table* table_2;
+    const uint8_t* removed_2;
+    uint32_t rows_2;
+    uint32_t row_2;
+    const Id32* c2_0;
+    table_2 = get_table(db, handles[2]);
+    removed_2 = get_removed(table_2);
+    rows_2 = table_2->num_entries;
+    row_2 = handles[2].entry;
+    c2_0 = get_column<Id32>(table_2, 0);
+
+    for (; row_2 < rows_2; ++row_2) {
+      if (removed_2 && removed_2[row_2]) {
+        continue;
+      }
+
+      binds->_0 = Id32(load_row(c2_0, row_2));
+      for (handles[3] = first(db, Binding::tbl(state, 1)); is_valid(db, handles[3]); handles[3] = next_table(db, handles[3])) { // object2
+        const Fact_Table* table_3;
+        const uint8_t* removed_3;
+        uint32_t rows_3;
+        uint32_t row_3;
+        const Id32* c3_0;
+        table_3 = get_table(db, handles[3]);
+        removed_3 = get_removed(table_3);
+        rows_3 = table_3->num_entries;
+        row_3 = handles[3].entry;
+        c3_0 = get_column<Id32>(table_3, 0);
+
+        for (; row_3 < rows_3; ++row_3) {
+          if (removed_3 && removed_3[row_3]) {
+            continue;
+          }
+
+          binds->_1 = Id32(load_row(c3_0, row_3));
+          handles[2].entry = row_2;
+          handles[3].entry = row_3;
+          plnnr_coroutine_yield(frame, precond_label, 2);
+          table_2 = get_table(db, handles[2]);
+          removed_2 = get_removed(table_2);
+          rows_2 = table_2->num_entries;
+          row_2 = handles[2].entry;
+          c2_0 = get_column<Id32>(table_2, 0);
+          table_3 = get_table(db, handles[3]);
+          removed_3 = get_removed(table_3);
+          rows_3 = table_3->num_entries;
+          row_3 = handles[3].entry;
+          c3_0 = get_column<Id32>(table_3, 0);
+        }
+      }
     }
   }
 
   plnnr_coroutine_end();
 }
 
-static bool t_case_0(Planning_State* state, Expansion_Frame* frame, Fact_Database* db)
+static bool p0_next(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
+{
+  return state->identity_binding ? p0_body<Identity_Binding>(state, frame, db) : p0_body<Mapped_Binding>(state, frame, db);
+}
+
+static bool t_case_0(Planning_State* state, Expansion_Frame* frame, const Fact_Database* db)
 {
-  const S_1* binds = (const S_1*)(frame->bindings);
+  const S_1* binds = (const S_1*)(frame->bindings) + frame->binding_index;
 
   plnnr_coroutine_begin(frame, expand_label);
 
   while (p0_next(state, frame, db)) {
-    binds = binds + frame->binding_index;
+    binds = (const S_1*)(frame->bindings) + frame->binding_index;
     begin_task(state, &s_domain_info, 0); // p!
     set_task_arg(state, &s_task_parameters[0], 0, Id32(binds->_1));
     plnnr_coroutine_yield(frame, expand_label, 1);
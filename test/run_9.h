@@ -9,6 +9,14 @@
 #define PLNNR_DOMAIN_API
 #endif
 
+// fact table ids, match table indices of `Fact_Database` created from `database_req`.
+enum run_9_Fact_Id
+{
+  run_9_fact_object1 = 0,
+  run_9_fact_object2 = 1,
+  run_9_num_facts = 2
+};
+
 extern "C" PLNNR_DOMAIN_API void run_9_init_domain_info();
 extern "C" PLNNR_DOMAIN_API const plnnr::Domain_Info* run_9_get_domain_info();
 
@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2015 Alexander Shafranov shafranov@gmail.com
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software. If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+
+#include "unittestpp.h"
+#include "derplanner/runtime/database.h"
+#include "derplanner/runtime/planning.h"
+#include "derplanner/runtime/batch.h"
+#include "run_28.h"
+#include "run_29.h"
+
+using namespace plnnr;
+
+namespace
+{
+    enum { Num_Jobs = 64 };
+
+    // `pick` plans `p!(X)` for the first `item(X)` which is `good(X)`.
+    void init_world(Fact_Database* db, Memory* mem, const Domain_Info* domain, int32_t good)
+    {
+        init(db, mem, &domain->database_req);
+
+        for (int32_t x = 1; x < 6; ++x)
+            add_entry(db->tables + run_28_fact_item, x);
+
+        add_entry(db->tables + run_28_fact_good, good);
+    }
+
+    int32_t get_plan_arg(const Planning_State* state, const Domain_Info* domain)
+    {
+        Plan plan = get_plan(state);
+        if (plan.length != 1)
+            return -1;
+
+        return as_Int32(plan.tasks[0].arguments, get_task_param_layout(domain, plan.tasks[0].task_type), 0);
+    }
+
+    TEST(find_plans_shared_databases)
+    {
+        Memory_Default mem;
+        run_28_init_domain_info();
+        const Domain_Info* domain = run_28_get_domain_info();
+
+        Fact_Database db_2, db_4;
+        init_world(&db_2, &mem, domain, 2);
+        init_world(&db_4, &mem, domain, 4);
+
+        Planning_State_Config config;
+        CHECK(compute_config(&config, domain, &db_2, 4, 2));
+        Planning_State states[Num_Jobs];
+        Find_Plan_Job jobs[Num_Jobs];
+
+        for (uint32_t i = 0; i < Num_Jobs; ++i)
+        {
+            const Fact_Database* db = (i % 3) ? &db_2 : &db_4;
+            init(&states[i], &mem, &config);
+            bind(&states[i], domain, db);
+
+            Find_Plan_Job job = { &states[i], db, domain, domain->task_info.num_primitive, Find_Plan_Failed };
+            jobs[i] = job;
+        }
+
+        Batch_Planner planner;
+        init(&planner, &mem, 4);
+
+        // the pool is reused by the next batch.
+        for (uint32_t batch = 0; batch < 2; ++batch)
+        {
+            find_plans(&planner, jobs, Num_Jobs);
+
+            for (uint32_t i = 0; i < Num_Jobs; ++i)
+            {
+                CHECK_EQUAL(Find_Plan_Succeeded, jobs[i].status);
+                CHECK_EQUAL((i % 3) ? 2 : 4, get_plan_arg(&states[i], domain));
+                jobs[i].status = Find_Plan_Failed;
+            }
+        }
+
+        destroy(&planner);
+        destroy(&db_2);
+        destroy(&db_4);
+    }
+
+    TEST(find_plans_single_worker)
+    {
+        Memory_Default mem;
+        run_28_init_domain_info();
+        const Domain_Info* domain = run_28_get_domain_info();
+
+        Fact_Database db;
+        init_world(&db, &mem, domain, 3);
+
+        Planning_State_Config config;
+        CHECK(compute_config(&config, domain, &db, 4, 2));
+        Planning_State state;
+        init(&state, &mem, &config);
+        bind(&state, domain, &db);
+
+        Find_Plan_Job job = { &state, &db, domain, domain->task_info.num_primitive, Find_Plan_Failed };
+
+        Batch_Planner planner;
+        init(&planner, &mem, 1);
+        find_plans(&planner, &job, 1);
+        destroy(&planner);
+
+        CHECK_EQUAL(Find_Plan_Succeeded, job.status);
+        CHECK_EQUAL(3, get_plan_arg(&state, domain));
+        destroy(&db);
+    }
+
+    // `choose` plans the first `good(X)` item with `X > 3` in its 4th case, or `p!(0)` in the last one.
+    int32_t find_speculative_plan(Memory* mem, Batch_Planner* pool, uint32_t max_cases, const int32_t* good, uint32_t num_good)
+    {
+        run_29_init_domain_info();
+        const Domain_Info* domain = run_29_get_domain_info();
+
+        Fact_Database db;
+        init(&db, mem, &domain->database_req);
+
+        for (int32_t x = 1; x < 6; ++x)
+            add_entry(db.tables + run_29_fact_item, x);
+
+        for (uint32_t i = 0; i < num_good; ++i)
+            add_entry(db.tables + run_29_fact_good, good[i]);
+
+        Planning_State_Config config;
+        CHECK(compute_config(&config, domain, &db, 4, 2));
+        Planning_State state;
+        init(&state, mem, &config);
+        bind(&state, domain, &db);
+        set_speculation(&state, domain, pool, max_cases);
+
+        const int32_t result = (find_plan(&state, &db, domain) == Find_Plan_Succeeded) ? get_plan_arg(&state, domain) : -1;
+
+        destroy(&state);
+        destroy(&db);
+        return result;
+    }
+
+    TEST(find_plan_speculative_cases)
+    {
+        Memory_Default mem;
+        Batch_Planner pool;
+        init(&pool, &mem, 4);
+
+        const int32_t good[] = { 2, 4 };
+
+        // windows smaller & larger than the number of cases, 0 disables speculation.
+        const uint32_t window_sizes[] = { 0, 2, 3, 8 };
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            // `check(2)` fails, so the 4th case continues its precondition from the speculatively found first satisfier.
+            CHECK_EQUAL(4, find_speculative_plan(&mem, &pool, window_sizes[i], good, 2));
+            // all speculatively evaluated cases fail.
+            CHECK_EQUAL(0, find_speculative_plan(&mem, &pool, window_sizes[i], good, 1));
+        }
+
+        destroy(&pool);
+    }
+}
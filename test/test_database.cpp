@@ -0,0 +1,608 @@
+//
+// Copyright (c) 2015 Alexander Shafranov shafranov@gmail.com
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software. If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+
+#include "unittestpp.h"
+#include "derplanner/runtime/memory.h"
+#include "derplanner/runtime/database.h"
+#include "derplanner/runtime/domain.h"
+
+using namespace plnnr;
+
+namespace
+{
+    struct Test_Table
+    {
+        Memory_Default memory;
+        Fact_Table table;
+
+        Test_Table(uint32_t max_entries)
+        {
+            Fact_Type format;
+            format.num_params = 2;
+            format.types[0] = Type_Int32;
+            format.types[1] = Type_Int32;
+            init(&table, &memory, &format, max_entries);
+        }
+
+        ~Test_Table()
+        {
+            destroy(&table);
+        }
+    };
+
+    // collects `a1` values of the entries with `a0 == key`, probing the hash index on column 0.
+    uint32_t probe(Fact_Table* table, int32_t key, int32_t* values)
+    {
+        Fact_Database db;
+        db.num_tables = 1;
+        db.tables = table;
+
+        uint32_t count = 0;
+        for (Fact_Handle h = first(&db, 0, 0, hash_Int32(0, key)); is_valid(&db, h); h = next(&db, h, 0))
+        {
+            if (as_Int32(table, h.entry, 0) == key)
+            {
+                values[count++] = as_Int32(table, h.entry, 1);
+            }
+        }
+
+        return count;
+    }
+
+    // collects `a1` values of the entries with `a0 < bound` in the order of the ordered index on column 0.
+    uint32_t range(Fact_Table* table, int32_t bound, int32_t* values)
+    {
+        Fact_Database db;
+        db.num_tables = 1;
+        db.tables = table;
+
+        uint32_t count = 0;
+        for (Fact_Handle c = first_in_range(&db, 0, 0, Range_Less, bound); ; c = next_in_range(&db, 0, 0, c))
+        {
+            Fact_Handle h = range_entry(&db, 0, 0, c);
+            if (!is_valid(&db, h))
+            {
+                break;
+            }
+
+            values[count++] = as_Int32(table, h.entry, 1);
+        }
+
+        return count;
+    }
+
+    TEST(remove_entry_keeps_indexes)
+    {
+        Test_Table t(8);
+        Fact_Index_Format format = { 1, { 0 }, Fact_Index_Hash };
+        add_index(&t.table, &format);
+        add_ordered_index(&t.table, 0);
+
+        add_entry(&t.table, 1, 10);
+        add_entry(&t.table, 2, 20);
+        add_entry(&t.table, 1, 11);
+        add_entry(&t.table, 3, 30);
+
+        remove_entry(&t.table, 0);
+        CHECK_EQUAL(3u, t.table.num_entries);
+        CHECK_EQUAL(3, as_Int32(&t.table, 0, 0));
+
+        int32_t values[8];
+        CHECK_EQUAL(1u, probe(&t.table, 1, values));
+        CHECK_EQUAL(11, values[0]);
+        CHECK_EQUAL(1u, probe(&t.table, 3, values));
+        CHECK_EQUAL(30, values[0]);
+
+        CHECK_EQUAL(2u, range(&t.table, 3, values));
+        CHECK_EQUAL(11, values[0]);
+        CHECK_EQUAL(20, values[1]);
+    }
+
+    TEST(remove_entry_stable_during_iteration)
+    {
+        Test_Table t(8);
+        Fact_Index_Format format = { 1, { 0 }, Fact_Index_Hash };
+        add_index(&t.table, &format);
+        add_ordered_index(&t.table, 0);
+
+        add_entry(&t.table, 1, 10);
+        add_entry(&t.table, 1, 11);
+        add_entry(&t.table, 1, 12);
+        add_entry(&t.table, 2, 20);
+
+        Fact_Database db;
+        db.num_tables = 1;
+        db.tables = &t.table;
+
+        // remove the current and the following entries while iterating over the chain.
+        int32_t visited[8];
+        uint32_t num_visited = 0;
+        for (Fact_Handle h = first(&db, 0, 0, hash_Int32(0, 1)); is_valid(&db, h); h = next(&db, h, 0))
+        {
+            visited[num_visited++] = as_Int32(&t.table, h.entry, 1);
+
+            if (h.entry == 0)
+            {
+                remove_entry_stable(&t.table, 0);
+                remove_entry_stable(&t.table, 1);
+            }
+        }
+
+        CHECK_EQUAL(2u, num_visited);
+        CHECK_EQUAL(10, visited[0]);
+        CHECK_EQUAL(12, visited[1]);
+        CHECK(is_removed(&t.table, 1));
+        CHECK(!empty(&t.table));
+
+        int32_t values[8];
+        CHECK_EQUAL(1u, probe(&t.table, 1, values));
+        CHECK_EQUAL(1u, range(&t.table, 2, values));
+        CHECK_EQUAL(12, values[0]);
+
+        compact(&t.table);
+        CHECK_EQUAL(2u, t.table.num_entries);
+        CHECK_EQUAL(0u, t.table.num_removed);
+        CHECK_EQUAL(12, as_Int32(&t.table, 0, 1));
+        CHECK_EQUAL(20, as_Int32(&t.table, 1, 1));
+        CHECK_EQUAL(1u, probe(&t.table, 2, values));
+        CHECK_EQUAL(20, values[0]);
+    }
+
+    TEST(update_arg_and_find_entry)
+    {
+        Test_Table t(8);
+        Fact_Index_Format format = { 1, { 0 }, Fact_Index_Hash };
+        add_index(&t.table, &format);
+        add_ordered_index(&t.table, 0);
+
+        add_entry(&t.table, 1, 10);
+        add_entry(&t.table, 2, 20);
+        add_entry(&t.table, 3, 30);
+
+        CHECK_EQUAL(1u, find_entry(&t.table, 0, int32_t(2)));
+        CHECK_EQUAL(Fact_Index_End, find_entry(&t.table, 0, int32_t(4)));
+
+        update_arg(&t.table, find_entry(&t.table, 0, int32_t(1)), 0, int32_t(4));
+        CHECK_EQUAL(0u, find_entry(&t.table, 0, int32_t(4)));
+        CHECK_EQUAL(Fact_Index_End, find_entry(&t.table, 0, int32_t(1)));
+
+        int32_t values[8];
+        CHECK_EQUAL(3u, range(&t.table, 5, values));
+        CHECK_EQUAL(20, values[0]);
+        CHECK_EQUAL(30, values[1]);
+        CHECK_EQUAL(10, values[2]);
+
+        clear(&t.table);
+        CHECK(empty(&t.table));
+        CHECK_EQUAL(Fact_Index_End, find_entry(&t.table, 0, int32_t(2)));
+    }
+
+    TEST(growth_double)
+    {
+        Test_Table t(2);
+        Fact_Index_Format format = { 1, { 0 }, Fact_Index_Hash };
+        add_index(&t.table, &format);
+        set_growth(&t.table, growth_double);
+
+        for (int32_t i = 0; i < 5; ++i)
+        {
+            add_entry(&t.table, i, 10 * i);
+        }
+
+        CHECK_EQUAL(8u, t.table.max_entries);
+        CHECK_EQUAL(5u, t.table.high_water_mark);
+        CHECK_EQUAL(4u, find_entry(&t.table, 0, int32_t(4)));
+
+        clear(&t.table);
+        add_entry(&t.table, 1, 10);
+        CHECK_EQUAL(5u, t.table.high_water_mark);
+    }
+
+    TEST(find_table)
+    {
+        const char* names[] = { "a", "b", "c" };
+        Fact_Type types[3];
+        uint32_t size_hints[3] = { 0, 0, 0 };
+        uint32_t hashes[3];
+
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            types[i].num_params = 1;
+            types[i].types[0] = Type_Int32;
+            hashes[i] = murmur2_32(names[i], 1, 7);
+        }
+
+        Database_Format format = { 3, 7, size_hints, types, hashes, names, 0, 0, 0 };
+
+        Memory_Default memory;
+        Fact_Database db;
+        init(&db, &memory, &format);
+
+        CHECK(find_table(&db, "a") == db.tables + 0);
+        CHECK(find_table(&db, "b") == db.tables + 1);
+        CHECK(find_table(&db, "c") == db.tables + 2);
+        CHECK(find_table(&db, "d") == 0);
+    }
+
+    TEST(add_entries)
+    {
+        Test_Table t(4);
+        Fact_Index_Format format = { 1, { 0 }, Fact_Index_Hash };
+        add_index(&t.table, &format);
+        add_ordered_index(&t.table, 0);
+        set_growth(&t.table, growth_double);
+
+        add_entry(&t.table, 5, 50);
+
+        int32_t a0[] = { 3, 1, 2 };
+        int32_t a1[] = { 30, 10, 20 };
+        const void* columns[] = { a0, a1 };
+        add_entries(&t.table, 3, columns);
+
+        Type types[] = { Type_Int32, Type_Int32 };
+        size_t offsets[2];
+        Param_Layout layout = { 2, 0, 0, types, offsets };
+        compute_offsets_and_size(&layout);
+
+        int32_t rows[] = { 4, 40, 0, 0 };
+        add_entries(&t.table, 2, rows, &layout, layout.size);
+
+        CHECK_EQUAL(6u, t.table.num_entries);
+        CHECK_EQUAL(8u, t.table.max_entries);
+        CHECK_EQUAL(2u, find_entry(&t.table, 0, int32_t(1)));
+        CHECK_EQUAL(40, as_Int32(&t.table, find_entry(&t.table, 0, int32_t(4)), 1));
+
+        int32_t values[8];
+        CHECK_EQUAL(5u, range(&t.table, 5, values));
+        CHECK_EQUAL(0, values[0]);
+        CHECK_EQUAL(10, values[1]);
+        CHECK_EQUAL(20, values[2]);
+        CHECK_EQUAL(30, values[3]);
+        CHECK_EQUAL(40, values[4]);
+    }
+
+    TEST(find_equal_kernels)
+    {
+        uint8_t a8[67];
+        uint32_t a32[67];
+        uint64_t a64[67];
+
+        for (uint32_t i = 0; i < 67; ++i)
+        {
+            a8[i] = uint8_t(i);
+            a32[i] = i;
+            a64[i] = uint64_t(i) << 32;
+        }
+
+        // every position, including the scalar tail after the vector blocks.
+        for (uint32_t i = 0; i < 67; ++i)
+        {
+            CHECK_EQUAL(i, find_equal(a8, 0, 67, uint8_t(i)));
+            CHECK_EQUAL(i, find_equal(a32, 0, 67, i));
+            CHECK_EQUAL(i, find_equal(a64, 0, 67, uint64_t(i) << 32));
+        }
+
+        // values before `begin` are not matched.
+        CHECK_EQUAL(67u, find_equal(a32, 6, 67, 5u));
+        CHECK_EQUAL(40u, find_equal(a8, 0, 40, uint8_t(50)));
+        // 64-bit values equal in one half only.
+        CHECK_EQUAL(67u, find_equal(a64, 0, 67, uint64_t(3)));
+
+        const int32_t s32[5] = { 4, -1, 7, -1, 2 };
+        CHECK_EQUAL(1u, find_equal(s32, 0, 5, int32_t(-1)));
+        CHECK_EQUAL(3u, find_equal(s32, 2, 5, int32_t(-1)));
+    }
+
+    TEST(first_equal_skips_removed)
+    {
+        Test_Table t(16);
+
+        for (int32_t i = 0; i < 16; ++i)
+        {
+            add_entry(&t.table, i % 3, i);
+        }
+
+        remove_entry_stable(&t.table, 3);
+
+        Fact_Database db;
+        db.num_tables = 1;
+        db.tables = &t.table;
+
+        int32_t values[16];
+        uint32_t count = 0;
+        for (Fact_Handle h = first_equal(&db, 0, 0, int32_t(0)); is_valid(&db, h); h = next_equal(&db, h, 0, int32_t(0)))
+        {
+            values[count++] = as_Int32(&t.table, h.entry, 1);
+        }
+
+        CHECK_EQUAL(5u, count);
+        CHECK_EQUAL(0, values[0]);
+        CHECK_EQUAL(6, values[1]);
+        CHECK_EQUAL(15, values[4]);
+    }
+
+    TEST(table_stats)
+    {
+        Test_Table t(128);
+
+        for (int32_t i = 0; i < 100; ++i)
+        {
+            add_entry(&t.table, i % 4, i);
+        }
+
+        Fact_Database db;
+        db.num_tables = 1;
+        db.tables = &t.table;
+
+        // inserts don't update the sketches until the stats are enabled.
+        CHECK_EQUAL(1u, estimate_distinct(&t.table, 0));
+        CHECK_EQUAL(100u, estimate_rows(&db, 0, 1));
+
+        set_stats(&t.table, true);
+        CHECK_EQUAL(4u, estimate_distinct(&t.table, 0));
+        CHECK(estimate_distinct(&t.table, 1) >= 80 && estimate_distinct(&t.table, 1) <= 100);
+
+        CHECK_EQUAL(100u, estimate_rows(&db, 0, 0));
+        CHECK_EQUAL(25u, estimate_rows(&db, 0, 1));
+        CHECK(estimate_rows(&db, 0, 2) <= 2);
+
+        clear(&t.table);
+        CHECK_EQUAL(0u, estimate_distinct(&t.table, 0));
+        CHECK_EQUAL(0u, estimate_rows(&db, 0, 1));
+    }
+
+    TEST(overlay)
+    {
+        const char* names[] = { "a" };
+        Fact_Type types[1] = { { 2, { Type_Int32, Type_Int32 } } };
+        uint32_t size_hints[1] = { 4 };
+        uint32_t hashes[1] = { murmur2_32(names[0], 1, 0) };
+        uint32_t num_indexes[1] = { 2 };
+        uint32_t first_index[1] = { 0 };
+        Fact_Index_Format indexes[2] = { { 1, { 0 }, Fact_Index_Hash }, { 1, { 1 }, Fact_Index_Ordered } };
+
+        Database_Format format = { 1, 0, size_hints, types, hashes, names, num_indexes, first_index, indexes };
+
+        Memory_Default memory;
+        Fact_Database base;
+        init(&base, &memory, &format);
+        add_entry(base.tables, 1, 10);
+        add_entry(base.tables, 2, 20);
+
+        Fact_Database overlay;
+        init_overlay(&overlay, &memory, &base, 2);
+        Fact_Table* table = find_table(&overlay, "a");
+        CHECK(table == overlay.tables);
+        add_entry(table, 1, 5);
+        add_entry(table, 3, 30);
+
+        int32_t values[8];
+        uint32_t count = 0;
+        for (Fact_Handle h = first(&overlay, 0); is_valid(&overlay, h); h = next(&overlay, h))
+        {
+            values[count++] = as_Int32(overlay, h, 1);
+        }
+
+        CHECK_EQUAL(4u, count);
+        CHECK_EQUAL(10, values[0]);
+        CHECK_EQUAL(20, values[1]);
+        CHECK_EQUAL(5, values[2]);
+        CHECK_EQUAL(30, values[3]);
+
+        count = 0;
+        for (Fact_Handle h = first(&overlay, 0, 0, hash_Int32(0, 1)); is_valid(&overlay, h); h = next(&overlay, h, 0))
+        {
+            values[count++] = as_Int32(overlay, h, 1);
+        }
+
+        CHECK_EQUAL(2u, count);
+        CHECK_EQUAL(10, values[0]);
+        CHECK_EQUAL(5, values[1]);
+
+        count = 0;
+        for (Fact_Handle h = first_equal(&overlay, 0, 0, int32_t(1)); is_valid(&overlay, h); h = next_equal(&overlay, h, 0, int32_t(1)))
+        {
+            values[count++] = as_Int32(overlay, h, 1);
+        }
+
+        CHECK_EQUAL(2u, count);
+        CHECK_EQUAL(10, values[0]);
+        CHECK_EQUAL(5, values[1]);
+
+        // own entries are not filtered by range.
+        count = 0;
+        for (Fact_Handle c = first_in_range(&overlay, 0, 0, Range_Greater, 15); ; c = next_in_range(&overlay, 0, 0, c))
+        {
+            Fact_Handle h = range_entry(&overlay, 0, 0, c);
+            if (!is_valid(&overlay, h))
+            {
+                break;
+            }
+
+            values[count++] = as_Int32(overlay, h, 1);
+        }
+
+        CHECK_EQUAL(3u, count);
+        CHECK_EQUAL(20, values[0]);
+        CHECK_EQUAL(5, values[1]);
+        CHECK_EQUAL(30, values[2]);
+
+        // full table scan by index, as in the generated preconditions.
+        remove_entry_stable(table, 0);
+        count = 0;
+        for (Fact_Handle h = first(&overlay, 0); is_valid(&overlay, h); h = next_table(&overlay, h))
+        {
+            const Fact_Table* scanned = get_table(&overlay, h);
+            const uint8_t* removed = get_removed(scanned);
+            const int32_t* column = get_column<int32_t>(scanned, 1);
+
+            for (uint32_t row = h.entry; row < scanned->num_entries; ++row)
+            {
+                if (!removed || !removed[row])
+                    values[count++] = load_row(column, row);
+            }
+        }
+
+        CHECK_EQUAL(3u, count);
+        CHECK_EQUAL(10, values[0]);
+        CHECK_EQUAL(20, values[1]);
+        CHECK_EQUAL(30, values[2]);
+        CHECK_EQUAL(2u, base.tables[0].num_entries);
+    }
+
+    TEST(snapshot)
+    {
+        const char* names[] = { "a", "b" };
+        Fact_Type types[2] = { { 2, { Type_Int32, Type_Int32 } }, { 1, { Type_Float } } };
+        uint32_t size_hints[2] = { 4, 4 };
+        uint32_t hashes[2] = { murmur2_32(names[0], 1, 3), murmur2_32(names[1], 1, 3) };
+        uint32_t num_indexes[2] = { 1, 0 };
+        uint32_t first_index[2] = { 0, 1 };
+        Fact_Index_Format indexes[1] = { { 1, { 0 }, Fact_Index_Hash } };
+
+        Database_Format format = { 2, 3, size_hints, types, hashes, names, num_indexes, first_index, indexes };
+
+        Memory_Default memory;
+        Fact_Database db;
+        init(&db, &memory, &format);
+        add_entry(db.tables + 0, 1, 10);
+        add_entry(db.tables + 0, 2, 20);
+        add_entry(db.tables + 0, 3, 30);
+        add_entry(db.tables + 1, 0.5f);
+        remove_entry_stable(db.tables + 0, 1);
+
+        const size_t size = get_snapshot_size(&db);
+        void* buffer = memory.allocate(size, Snapshot_Alignment);
+        CHECK_EQUAL(0u, save_snapshot(&db, buffer, size - 1));
+        CHECK_EQUAL(size, save_snapshot(&db, buffer, size));
+
+        {
+            Fact_Database loaded;
+            CHECK(load_snapshot(&loaded, &memory, &format, buffer, size));
+            CHECK_EQUAL(2u, loaded.tables[0].num_entries);
+            CHECK_EQUAL(30, as_Int32(loaded.tables + 0, 1, 1));
+            CHECK_EQUAL(1u, find_entry(loaded.tables + 0, 0, int32_t(3)));
+            CHECK_EQUAL(0.5f, as_Float(loaded.tables + 1, 0, 0));
+            CHECK(loaded.tables[0].columns[0] == static_cast<uint8_t*>(buffer) + reinterpret_cast<Snapshot_Table*>(static_cast<Snapshot_Header*>(buffer) + 1)->offsets[0]);
+
+            // growing copies the columns, snapshot stays intact.
+            set_growth(&loaded, growth_double);
+            add_entry(loaded.tables + 0, 4, 40);
+            CHECK(loaded.tables[0].blob != 0);
+            CHECK_EQUAL(2u, find_entry(loaded.tables + 0, 0, int32_t(4)));
+        }
+
+        {
+            // modifications copy the columns first, the snapshot (e.g. read-only mapped) is never written.
+            void* original = memory.allocate(size, Snapshot_Alignment);
+            memcpy(original, buffer, size);
+
+            Fact_Database loaded;
+            CHECK(load_snapshot(&loaded, &memory, &format, buffer, size));
+            update_arg(loaded.tables + 0, 0, 0, int32_t(5));
+            CHECK_EQUAL(0u, find_entry(loaded.tables + 0, 0, int32_t(5)));
+            destroy(&loaded);
+
+            CHECK(load_snapshot(&loaded, &memory, &format, buffer, size));
+            remove_entry(loaded.tables + 0, 0);
+            CHECK_EQUAL(0u, find_entry(loaded.tables + 0, 0, int32_t(3)));
+            destroy(&loaded);
+
+            CHECK(load_snapshot(&loaded, &memory, &format, buffer, size));
+            remove_entry_stable(loaded.tables + 0, 0);
+            compact(loaded.tables + 0);
+            CHECK_EQUAL(1u, loaded.tables[0].num_entries);
+            CHECK_EQUAL(30, as_Int32(loaded.tables + 0, 0, 1));
+
+            // cleared table keeps the snapshot capacity without a growth policy.
+            clear(loaded.tables + 1);
+            add_entry(loaded.tables + 1, 1.5f);
+            CHECK_EQUAL(1.5f, as_Float(loaded.tables + 1, 0, 0));
+            destroy(&loaded);
+
+            // appending to a full snapshot table copies it with room for the new entries, even without a growth policy.
+            CHECK(load_snapshot(&loaded, &memory, &format, buffer, size));
+            add_entry(loaded.tables + 0, 4, 40);
+            CHECK_EQUAL(3u, loaded.tables[0].num_entries);
+            CHECK_EQUAL(2u, find_entry(loaded.tables + 0, 0, int32_t(4)));
+            CHECK_EQUAL(30, as_Int32(loaded.tables + 0, 1, 1));
+            const float more[2] = { 2.5f, 3.5f };
+            const void* more_columns[1] = { more };
+            add_entries(loaded.tables + 1, 2, more_columns);
+            CHECK_EQUAL(3u, loaded.tables[1].num_entries);
+            CHECK_EQUAL(0.5f, as_Float(loaded.tables + 1, 0, 0));
+            CHECK_EQUAL(3.5f, as_Float(loaded.tables + 1, 2, 0));
+            destroy(&loaded);
+
+            CHECK_EQUAL(0, memcmp(original, buffer, size));
+            memory.deallocate(original);
+        }
+
+        // the seed doesn't match.
+        format.hash_seed = 4;
+        Fact_Database mismatched;
+        CHECK(!load_snapshot(&mismatched, &memory, &format, buffer, size));
+
+        memory.deallocate(buffer);
+    }
+
+    TEST(vec3_planes)
+    {
+        Memory_Default memory;
+        Fact_Type format;
+        format.num_params = 2;
+        format.types[0] = Type_Int32;
+        format.types[1] = Type_Vec3;
+
+        Fact_Table table;
+        init(&table, &memory, &format, 2);
+        set_growth(&table, growth_double);
+        add_entry(&table, 1, Vec3(1.f, 2.f, 3.f));
+        add_entry(&table, 2, Vec3(4.f, 5.f, 6.f));
+
+        set_vec3_layout(&table, Vec3_Layout_Planes);
+        const float* planes = static_cast<const float*>(table.columns[1]);
+        CHECK_EQUAL(1.f, planes[0]);
+        CHECK_EQUAL(4.f, planes[1]);
+        CHECK_EQUAL(2.f, planes[table.max_entries]);
+        CHECK_EQUAL(6.f, planes[2 * table.max_entries + 1]);
+
+        // growth keeps the planes.
+        add_entry(&table, 3, Vec3(7.f, 8.f, 9.f));
+        CHECK_EQUAL(5.f, as_Vec3(&table, 1, 1).y);
+        CHECK_EQUAL(9.f, as_Vec3(&table, 2, 1).z);
+
+        const int32_t ids[2] = { 4, 5 };
+        const Vec3 positions[2] = { Vec3(10.f, 11.f, 12.f), Vec3(13.f, 14.f, 15.f) };
+        const void* columns[2] = { ids, positions };
+        add_entries(&table, 2, columns);
+        CHECK_EQUAL(14.f, as_Vec3(&table, 4, 1).y);
+
+        remove_entry(&table, 0);
+        CHECK_EQUAL(13.f, as_Vec3(&table, 0, 1).x);
+        CHECK_EQUAL(15.f, get_vec3_column(&table, 1).z[0]);
+
+        set_vec3_layout(&table, Vec3_Layout_Interleaved);
+        CHECK_EQUAL(15.f, static_cast<const Vec3*>(table.columns[1])[0].z);
+        CHECK_EQUAL(12.f, as_Vec3(&table, 3, 1).z);
+
+        destroy(&table);
+    }
+}
@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2015 Alexander Shafranov shafranov@gmail.com
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software. If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+
+#include <string.h>
+#include "unittestpp.h"
+#include "derplanner/runtime/database.h"
+#include "derplanner/runtime/loader.h"
+
+using namespace plnnr;
+
+namespace
+{
+    bool resolve_city(void*, const char* name, uint32_t length, uint64_t* id)
+    {
+        const char* cities[] = { "SPB", "LED", "MSC" };
+
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            if (strlen(cities[i]) == length && strncmp(cities[i], name, length) == 0)
+            {
+                *id = i;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    struct Test_Database
+    {
+        Memory_Default memory;
+        Fact_Database db;
+        Symbol_Table symbols;
+        const char* symbol_values[1];
+        uint32_t symbol_hashes[1];
+
+        Test_Database()
+        {
+            static const char* names[] = { "airport", "distance" };
+            static Fact_Type types[2] = { { 2, { Type_Id32, Type_Id32 } }, { 3, { Type_Id32, Type_Id32, Type_Float } } };
+            static uint32_t size_hints[2] = { 2, 2 };
+            uint32_t hashes[2] = { murmur2_32(names[0], 7, 0), murmur2_32(names[1], 8, 0) };
+
+            Database_Format format = { 2, 0, size_hints, types, hashes, names, 0, 0, 0 };
+            init(&db, &memory, &format);
+            set_growth(&db, growth_double);
+
+            symbol_values[0] = ":home";
+            symbol_hashes[0] = murmur2_32(":home", 5, 1);
+            symbols.num_symbols = 1;
+            symbols.hash_seed = 1;
+            symbols.hashes = symbol_hashes;
+            symbols.values = symbol_values;
+        }
+    };
+
+    TEST(load_facts_in_chunks)
+    {
+        Test_Database t;
+        Fact_Loader loader;
+        init(&loader, &t.memory, &t.db, &t.symbols, 2);
+        set_resolve(&loader, resolve_city, 0);
+
+        const char* text =
+            "// cities\n"
+            "airport(SPB, LED)\n"
+            "\n"
+            "distance(SPB, :home, 6.5)\r\n"
+            "airport(MSC, 7)\n"
+            "distance( LED , MSC , -2 )";
+
+        // feed text in small chunks, so lines are split.
+        const size_t length = strlen(text);
+        for (size_t offset = 0; offset < length; offset += 5)
+        {
+            CHECK(load_facts(&loader, text + offset, (length - offset < 5) ? length - offset : 5));
+        }
+
+        CHECK(flush(&loader));
+        CHECK_EQUAL(6u, loader.line_number);
+
+        Fact_Table* airport = t.db.tables + 0;
+        Fact_Table* distance = t.db.tables + 1;
+        CHECK_EQUAL(2u, airport->num_entries);
+        CHECK_EQUAL(2u, distance->num_entries);
+        CHECK_EQUAL(0u, as_Id32(airport, 0, 0));
+        CHECK_EQUAL(1u, as_Id32(airport, 0, 1));
+        CHECK_EQUAL(7u, as_Id32(airport, 1, 1));
+        CHECK_EQUAL(0u, as_Id32(distance, 0, 1));
+        CHECK_EQUAL(6.5f, as_Float(distance, 0, 2));
+        CHECK_EQUAL(-2.0f, as_Float(distance, 1, 2));
+
+        destroy(&loader);
+    }
+
+    TEST(load_facts_errors)
+    {
+        Test_Database t;
+        Fact_Loader loader;
+        init(&loader, &t.memory, &t.db, &t.symbols, 4);
+
+        CHECK(!load_facts(&loader, "airport(SPB, LED)\n", 18));
+        CHECK_EQUAL(Fact_Loader_Unknown_Symbol, loader.error);
+        destroy(&loader);
+
+        init(&loader, &t.memory, &t.db, &t.symbols, 4);
+        CHECK(!load_facts(&loader, "airport(1)\n", 11));
+        CHECK_EQUAL(Fact_Loader_Arity_Mismatch, loader.error);
+        destroy(&loader);
+
+        init(&loader, &t.memory, &t.db, &t.symbols, 4);
+        CHECK(!load_facts(&loader, "harbor(1, 2)\n", 13));
+        CHECK_EQUAL(Fact_Loader_Unknown_Fact, loader.error);
+        destroy(&loader);
+
+        init(&loader, &t.memory, &t.db, &t.symbols, 4);
+        CHECK(!load_facts(&loader, "airport(1, 2.5)\n", 16));
+        CHECK_EQUAL(Fact_Loader_Type_Mismatch, loader.error);
+        destroy(&loader);
+    }
+}
@@ -242,4 +242,26 @@ namespace
         // non logical ops are considered to be trivial conjuncts.
         check_dnf_expr("( (a | 7.0) & ((c <= d) | (c + d)) )", "Or{ And{ Var[a] LessEqual{ Var[c] Var[d] } } And{ Var[a] Plus{ Var[c] Var[d] } } And{ Literal LessEqual{ Var[c] Var[d] } } And{ Literal Plus{ Var[c] Var[d] } } }");
     }
+
+    void check_factorized_expr(const char* input, const char* expected)
+    {
+        Test_Compiler compiler;
+        init(compiler, input);
+        ast::Expr* expr = plnnrc::parse_precond(&compiler.parser);
+        expr = plnnrc::convert_to_factorized(&compiler.tree, expr);
+        std::string actual;
+        to_string(expr, actual);
+        CHECK_EQUAL(expected, actual.c_str());
+    }
+
+    TEST(factorized_conversion)
+    {
+        check_factorized_expr("( )", "Or");
+        check_factorized_expr("( a | b )", "Or{ Var[a] Var[b] }");
+        // expression is converted to nnf.
+        check_factorized_expr("( a & ~(b & c) )", "Or{ And{ Var[a] Or{ Not{ Var[b] } Not{ Var[c] } } } }");
+        // disjunctions nested in conjunctions are kept.
+        check_factorized_expr("( q1 & (r1 | r2) & q2 & (r3 | r4) & q3 )",
+                              "Or{ And{ Var[q1] Or{ Var[r1] Var[r2] } Var[q2] Or{ Var[r3] Var[r4] } Var[q3] } }");
+    }
 }
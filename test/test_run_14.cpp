@@ -0,0 +1,193 @@
+
+#include <string>
+#include <stdio.h>
+#include <stdarg.h>
+#include "run_14.h"
+#include "derplanner/runtime/database.h"
+#include "derplanner/runtime/planning.h"
+#include "unittestpp.h"
+
+#if defined(_MSC_VER)
+    #define PRIu64 "I64u"
+    #define PRIi64 "I64i"
+#else
+    #define __STDC_FORMAT_MACROS
+    #include <inttypes.h>
+#endif
+
+namespace {
+
+enum { FORMAT_BUFFER_SIZE = 1024 };
+
+void format(char* output, const char* format, ...)
+{
+    va_list arg_list;
+    va_start(arg_list, format);
+    vsnprintf(output, FORMAT_BUFFER_SIZE, format, arg_list);
+    va_end(arg_list);
+}
+
+void check_plan(const char* expected, plnnr::Planning_State& pstate, const plnnr::Domain_Info* domain)
+{
+    char buffer[FORMAT_BUFFER_SIZE];
+
+    plnnr::Plan plan = plnnr::get_plan(&pstate);
+
+    std::string actual;
+    for (uint32_t i = 0; i < plan.length; ++i)
+    {
+        plnnr::Task_Frame& task = plan.tasks[i];
+        plnnr::Param_Layout layout = plnnr::get_task_param_layout(domain, task.task_type);
+        const char* name = plnnr::get_task_name(domain, task.task_type);
+        actual += name;
+        actual += "(";
+
+        for (uint8_t p = 0; p < layout.num_params; ++p)
+        {
+            switch (layout.types[p])
+            {
+            case plnnr::Type_Id32:
+                {
+                    plnnr::Id32 v = plnnr::as_Id32(task.arguments, layout, p);
+                    format(buffer, "%u", (uint32_t)(v));
+                    actual += buffer;
+                    break;
+                }
+            case plnnr::Type_Id64:
+                {
+                    plnnr::Id64 v = plnnr::as_Id64(task.arguments, layout, p);
+                    format(buffer, "%" PRIu64, (uint64_t)(v));
+                    actual += buffer;
+                    break;
+                }
+            case plnnr::Type_Int8:
+                {
+                    int8_t v = plnnr::as_Int8(task.arguments, layout, p);
+                    format(buffer, "%d", (int8_t)(v));
+                    actual += buffer;
+                    break;
+                }
+            case plnnr::Type_Int32:
+                {
+                    int32_t v = plnnr::as_Int32(task.arguments, layout, p);
+                    format(buffer, "%d", (int32_t)(v));
+                    actual += buffer;
+                    break;
+                }
+            case plnnr::Type_Int64:
+                {
+                    int64_t v = plnnr::as_Int64(task.arguments, layout, p);
+                    format(buffer, "%" PRIi64, (int64_t)(v));
+                    actual += buffer;
+                    break;
+                }
+            case plnnr::Type_Float:
+                {
+                    float v = plnnr::as_Float(task.arguments, layout, p);
+                    format(buffer, "%f", (float)(v));
+                    actual += buffer;
+                    break;
+                }
+            case plnnr::Type_Vec3:
+                {
+                    plnnr::Vec3 v = plnnr::as_Vec3(task.arguments, layout, p);
+                    format(buffer, "vec3(%f, %f, %f)", v.x, v.y, v.z);
+                    actual += buffer;
+                    break;
+                }
+            default:
+                CHECK(false);
+            }
+
+            if (p < layout.num_params - 1)
+                actual += ", ";
+        }
+
+        actual += ")";
+
+        if (i < plan.length - 1)
+            actual += " ";
+    }
+
+    CHECK_EQUAL(expected, actual.c_str());
+}
+
+TEST(run_14)
+{
+    plnnr::Memory_Default default_mem;
+
+    run_14_init_domain_info();
+    const plnnr::Domain_Info* domain = run_14_get_domain_info();
+
+    plnnr::Fact_Database db;
+    plnnr::init(&db, &default_mem, &domain->database_req);
+
+    plnnr::Planning_State_Config config;
+    config.max_depth = 1024;
+    config.max_plan_length = 512;
+    config.max_bound_tables = domain->database_req.num_tables;
+    config.expansion_data_size = 4096;
+    config.plan_data_size = 4096;
+
+    plnnr::Planning_State pstate;
+    plnnr::init(&pstate, &default_mem, &config);
+    plnnr::bind(&pstate, domain, &db);
+
+    // `:index` hash index probes
+
+plnnr::Fact_Table* a = plnnr::find_table(&db, "a");
+plnnr::Fact_Table* b = plnnr::find_table(&db, "b");
+
+plnnr::add_entry(a, 1, 10);
+plnnr::add_entry(a, 2, 20);
+plnnr::add_entry(a, 1, 30);
+plnnr::add_entry(a, 1, 40);
+
+plnnr::add_entry(b, 10, int8_t(1), 100);
+plnnr::add_entry(b, 30, int8_t(1), 300);
+// indexes are rebuilt when the table storage grows.
+plnnr::set_max_entries(b, 512);
+plnnr::add_entry(b, 10, int8_t(2), 100);
+plnnr::add_entry(b, 40, int8_t(1), 300);
+plnnr::add_entry(b, 10, int8_t(1), 200);
+
+
+    plnnr::Find_Plan_Status status = plnnr::find_plan(&pstate, &db, domain);
+    CHECK_EQUAL(plnnr::Find_Plan_Succeeded, status);
+
+    check_plan("p!(10, 100) q!(10) q!(10) p!(10, 200) q!(10) p!(30, 300) q!(30) q!(40) p!(40, 300) q!(30) q!(40)", pstate, domain);
+
+// tables in another order are bound through the table map.
+const plnnr::Database_Format& req = domain->database_req;
+uint32_t swapped_hints[2] = { req.size_hints[1], req.size_hints[0] };
+plnnr::Fact_Type swapped_types[2] = { req.types[1], req.types[0] };
+uint32_t swapped_hashes[2] = { req.hashes[1], req.hashes[0] };
+const char* swapped_names[2] = { req.names[1], req.names[0] };
+uint32_t swapped_num_indexes[2] = { 2, 1 };
+uint32_t swapped_first_index[2] = { 0, 2 };
+plnnr::Fact_Index_Format swapped_indexes[3] = { req.indexes[1], req.indexes[2], req.indexes[0] };
+plnnr::Database_Format swapped_format = { 2, req.hash_seed, swapped_hints, swapped_types, swapped_hashes, swapped_names, swapped_num_indexes, swapped_first_index, swapped_indexes };
+plnnr::Fact_Database swapped_db;
+plnnr::init(&swapped_db, &default_mem, &swapped_format);
+for (uint32_t i = 0; i < a->num_entries; ++i)
+plnnr::add_entry(swapped_db.tables + 1, plnnr::as_Int32(a, i, 0), plnnr::as_Int32(a, i, 1));
+for (uint32_t i = 0; i < b->num_entries; ++i)
+plnnr::add_entry(swapped_db.tables + 0, plnnr::as_Int32(b, i, 0), plnnr::as_Int8(b, i, 1), plnnr::as_Int32(b, i, 2));
+CHECK(plnnr::bind(&pstate, domain, &swapped_db));
+CHECK(!pstate.identity_binding);
+CHECK_EQUAL(plnnr::Find_Plan_Succeeded, plnnr::find_plan(&pstate, &swapped_db, domain));
+check_plan("p!(10, 100) q!(10) q!(10) p!(10, 200) q!(10) p!(30, 300) q!(30) q!(40) p!(40, 300) q!(30) q!(40)", pstate, domain);
+plnnr::destroy(&swapped_db);
+
+// probes refer to the domain index ids, a database with different indexes can't be bound.
+plnnr::Database_Format other_format = domain->database_req;
+plnnr::Fact_Index_Format other_indexes[3] = { { 1, { 1 }, plnnr::Fact_Index_Hash }, other_format.indexes[1], other_format.indexes[2] };
+other_format.indexes = other_indexes;
+plnnr::Fact_Database other_db;
+plnnr::init(&other_db, &default_mem, &other_format);
+CHECK(!plnnr::bind(&pstate, domain, &other_db));
+plnnr::destroy(&other_db);
+
+}
+
+}